@@ -0,0 +1,236 @@
+/**
+ * @file latency_benchmark.c
+ *
+ * @brief This file contains a benchmark of the foreground logging latency with and without isolating the logger threads.
+ *
+ * @note A foreground thread pinned to CPU 0 measures the latency of its log calls while a producer thread, pinned away
+ * from CPU 0, keeps the logger threads busy with rotations and the periodic dumps. The benchmark runs once with the default
+ * thread attributes and once with the logger threads pinned away from CPU 0, niced and scheduled with SCHED_IDLE.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#define _GNU_SOURCE
+
+#include <cJSONLogger.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @def BENCHMARK_SAMPLES
+ *
+ * @brief Number of latency samples taken by the foreground thread per scenario.
+ */
+#define BENCHMARK_SAMPLES 20000
+
+/**
+ * @def BENCHMARK_LOG_FILE
+ *
+ * @brief Path of the log file used by the benchmark.
+ */
+#define BENCHMARK_LOG_FILE "benchmark_log.json"
+
+/**
+ * @def MAX_CPU_LIST_LEN
+ *
+ * @brief Max length of the CPU list of the logger threads.
+ */
+#define MAX_CPU_LIST_LEN 32
+
+/**
+ * @def BENCHMARK_FLUSH_INTERVAL_MS
+ *
+ * @brief Interval in milliseconds of the dumps run by the logger threads during the benchmark.
+ */
+#define BENCHMARK_FLUSH_INTERVAL_MS 5
+
+/**
+ * @struct BenchmarkResult
+ *
+ * @brief Latency percentiles of a scenario in nanoseconds.
+ *
+ * @var p50 The median latency.
+ * @var p99 The 99th percentile latency.
+ * @var max The worst latency.
+ */
+typedef struct BenchmarkResult {
+    int64_t p50;
+    int64_t p99;
+    int64_t max;
+} BenchmarkResult_s;
+
+static atomic_int s_g_producerStop = 0;
+
+/**
+ * @brief Get a monotonic timestamp in nanoseconds.
+ *
+ * @return int64_t, the timestamp.
+ */
+static int64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief Compare two latency samples, used by qsort.
+ *
+ * @param a The first sample.
+ * @param b The second sample.
+ *
+ * @return int, negative, zero or positive as a is less than, equal to or greater than b.
+ */
+static int compareSamples(const void* a, const void* b)
+{
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Producer thread, logs continuously so the logger threads keep rotating and printing.
+ *
+ * @note The dumps are left to the logger threads (flushIntervalMs), a dump called here would print on the producer thread.
+ *
+ * @param ctx Unused.
+ *
+ * @return Always NULL.
+ */
+static void* producerHandler(void* ctx)
+{
+    (void)ctx;
+
+    const char* nodes[] = { "alpha", "beta", "gamma", "delta" };
+    for (int i = 0; atomic_load(&s_g_producerStop) == 0; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "background value %d", nodes[i % 4], nodes[(i / 4) % 4], i);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run a scenario and measure the latency of the foreground log calls.
+ *
+ * @param config The logger configuration of the scenario.
+ * @param result Where the latency percentiles will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int runScenario(const CJSONLoggerConfig_s* config, BenchmarkResult_s* result)
+{
+    if (cJSONLoggerInitWithConfig(config) != 0) {
+        return -1;
+    }
+
+    int64_t* samples = (int64_t*)malloc(BENCHMARK_SAMPLES * sizeof(int64_t));
+    if (samples == NULL) {
+        cJSONLoggerDestroy();
+        return -1;
+    }
+
+    atomic_store(&s_g_producerStop, 0);
+
+    // The producer would inherit the CPU 0 affinity of the foreground thread, it runs on the other CPUs when there are any.
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_attr_t producerAttr;
+    pthread_attr_init(&producerAttr);
+    if (cpuCount > 1) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (long cpu = 1; cpu < cpuCount && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET((size_t)cpu, &cpuSet);
+        }
+        pthread_attr_setaffinity_np(&producerAttr, sizeof(cpuSet), &cpuSet);
+    }
+
+    pthread_t producer;
+    int res = pthread_create(&producer, &producerAttr, producerHandler, NULL);
+    pthread_attr_destroy(&producerAttr);
+    if (res != 0) {
+        free(samples);
+        cJSONLoggerDestroy();
+        return -1;
+    }
+
+    for (int i = 0; i < BENCHMARK_SAMPLES; i++) {
+        int64_t start = nowNs();
+        CJSON_LOG_WARN("%" JNO "foreground value %d", "foreground", i);
+        samples[i] = nowNs() - start;
+    }
+
+    atomic_store(&s_g_producerStop, 1);
+    pthread_join(producer, NULL);
+
+    cJSONLoggerDestroy();
+
+    qsort(samples, BENCHMARK_SAMPLES, sizeof(int64_t), compareSamples);
+    result->p50 = samples[BENCHMARK_SAMPLES / 2];
+    result->p99 = samples[(BENCHMARK_SAMPLES * 99) / 100];
+    result->max = samples[BENCHMARK_SAMPLES - 1];
+
+    free(samples);
+
+    return 0;
+}
+
+/**
+ * @brief Main entry point for the latency benchmark.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int main(void)
+{
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // The foreground thread stays on CPU 0.
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(0, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = BENCHMARK_LOG_FILE;
+    config.flushIntervalMs = BENCHMARK_FLUSH_INTERVAL_MS;
+
+    BenchmarkResult_s shared;
+    if (runScenario(&config, &shared) != 0) {
+        fprintf(stderr, "Failed to run the scenario without isolation\n");
+        return -1;
+    }
+
+    char cpuList[MAX_CPU_LIST_LEN];
+    if (cpuCount > 1) {
+        snprintf(cpuList, sizeof(cpuList), "1-%ld", cpuCount - 1);
+        config.workerCpuList = cpuList;
+    }
+
+    config.workerNice = 19;
+    config.workerSchedPolicy = CJSON_LOGGER_SCHED_IDLE;
+
+    BenchmarkResult_s isolated;
+    if (runScenario(&config, &isolated) != 0) {
+        fprintf(stderr, "Failed to run the scenario with isolation\n");
+        return -1;
+    }
+
+    printf("Foreground log call latency over %d samples (%ld online CPUs)\n", BENCHMARK_SAMPLES, cpuCount);
+    printf("%-40s %12s %12s %12s\n", "scenario", "p50 (ns)", "p99 (ns)", "max (ns)");
+    printf("%-40s %12ld %12ld %12ld\n", "default logger threads", (long)shared.p50, (long)shared.p99, (long)shared.max);
+    printf("%-40s %12ld %12ld %12ld\n", cpuCount > 1 ? "pinned to 1-N, nice 19, SCHED_IDLE" : "nice 19, SCHED_IDLE", (long)isolated.p50, (long)isolated.p99, (long)isolated.max);
+
+    return 0;
+}
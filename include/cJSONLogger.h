@@ -11,6 +11,9 @@
 #ifndef CJSON_LOGGER_H
 #define CJSON_LOGGER_H
 
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 /**
@@ -52,6 +55,13 @@
  */
 #define JNO_CHAR ('0' + JNO_ID)
 
+/**
+ * @def CJSON_LOGGER_NICE_INHERIT
+ *
+ * @brief The workerNice value keeping the nice value the logger threads inherit from the process.
+ */
+#define CJSON_LOGGER_NICE_INHERIT INT_MIN
+
 /**
  * @enum CJSON_LOG_LEVEL
  *
@@ -67,11 +77,249 @@ typedef enum CJSON_LOG_LEVEL {
     __CJSON_LOG_LEVEL_END
 } CJSON_LOG_LEVEL_E;
 
+/**
+ * @enum CJSON_LOGGER_SCHED_POLICY
+ *
+ * @brief Enumeration used to define the scheduling policy of the threads owned by the logger.
+ */
+typedef enum CJSON_LOGGER_SCHED_POLICY {
+    CJSON_LOGGER_SCHED_INHERIT = 0,
+    CJSON_LOGGER_SCHED_OTHER,
+    CJSON_LOGGER_SCHED_BATCH,
+    CJSON_LOGGER_SCHED_IDLE,
+    CJSON_LOGGER_SCHED_FIFO,
+    CJSON_LOGGER_SCHED_RR
+} CJSON_LOGGER_SCHED_POLICY_E;
+
+/**
+ * @enum CJSON_LOGGER_FORK_MODE
+ *
+ * @brief Enumeration used to define how a child process created with fork() continues the logs of its parent.
+ *
+ * @note With CJSON_LOGGER_FORK_INHERIT the child keeps the logs and the output file of the parent,
+ * with CJSON_LOGGER_FORK_FRESH it starts with no logs and writes to the output file and the NDJSON sink files suffixed with its pid
+ * (e.g. log.<pid>.json), which it rotates on its own.
+ */
+typedef enum CJSON_LOGGER_FORK_MODE {
+    CJSON_LOGGER_FORK_INHERIT = 0,
+    CJSON_LOGGER_FORK_FRESH
+} CJSON_LOGGER_FORK_MODE_E;
+
+/**
+ * @enum CJSON_LOGGER_TIME_FORMAT
+ *
+ * @brief Enumeration used to define how the time stamps of the logs are printed.
+ *
+ * @note CJSON_LOGGER_TIME_LOCAL prints the local time unpadded (e.g. 2026-1-7 9:5:3.12000), CJSON_LOGGER_TIME_RFC3339 prints the local time
+ * as fixed width RFC 3339 with its UTC offset (e.g. 2026-01-07T09:05:03.000012000+02:00) and CJSON_LOGGER_TIME_RFC3339_UTC prints the
+ * UTC time the same way (e.g. 2026-01-07T07:05:03.000012000Z). The RFC 3339 time stamps sort as text.
+ */
+typedef enum CJSON_LOGGER_TIME_FORMAT {
+    CJSON_LOGGER_TIME_LOCAL = 0,
+    CJSON_LOGGER_TIME_RFC3339,
+    CJSON_LOGGER_TIME_RFC3339_UTC
+} CJSON_LOGGER_TIME_FORMAT_E;
+
+/**
+ * @enum CJSON_LOGGER_SINK_TYPE
+ *
+ * @brief Enumeration used to define the type of a sink added with cJSONLoggerAddSink().
+ *
+ * @note CJSON_LOGGER_SINK_NDJSON appends one JSON object per record to a file, CJSON_LOGGER_SINK_STDERR does the same on the standard error
+ * CJSON_LOGGER_SINK_SOCKET sends them to a Unix domain (SOCK_SEQPACKET) socket and CJSON_LOGGER_SINK_CALLBACK hands them to a callback.
+ */
+typedef enum CJSON_LOGGER_SINK_TYPE {
+    CJSON_LOGGER_SINK_NDJSON = 0,
+    CJSON_LOGGER_SINK_STDERR,
+    CJSON_LOGGER_SINK_SOCKET,
+    CJSON_LOGGER_SINK_CALLBACK
+} CJSON_LOGGER_SINK_TYPE_E;
+
+/**
+ * @struct CJSONLoggerRecord
+ *
+ * @brief A log record handed to the callback of a CJSON_LOGGER_SINK_CALLBACK sink, of cJSONLoggerQuery() or of cJSONLoggerTail().
+ *
+ * @note The record and its strings are only valid during the callback.
+ *
+ * @var jsonPath The names of the JSON nodes the record belongs to.
+ * @var jsonPathDepth The number of names in the jsonPath.
+ * @var timeStamp The time stamp of the record in nanoseconds since the epoch.
+ * @var logLevel The log level of the record.
+ * @var fileName The file name of the call site, NULL if not set.
+ * @var funcName The function name of the call site, NULL if not set.
+ * @var fileLine The file line of the call site, 0 if not set.
+ * @var logMsg The log message.
+ * @var sequence The sequence number of the record, taken from a counter shared by the threads of the process in logging order
+ * (the records of one log call are numbered in order), 0 if sequenceNumbers is not set.
+ * @var threadId The id of the logging thread (as returned by gettid()), 0 if threadIds is not set.
+ */
+typedef struct CJSONLoggerRecord {
+    const char* const* jsonPath;
+    size_t jsonPathDepth;
+    int64_t timeStamp;
+    CJSON_LOG_LEVEL_E logLevel;
+    const char* fileName;
+    const char* funcName;
+    int fileLine;
+    const char* logMsg;
+    uint64_t sequence;
+    uint32_t threadId;
+} CJSONLoggerRecord_s;
+
+/**
+ * @brief Callback of a CJSON_LOGGER_SINK_CALLBACK sink (or of cJSONLoggerQuery() and cJSONLoggerTail()), receives the records in batches, in logging order.
+ *
+ * @note The callback of a sink runs on a worker thread (or the thread calling cJSONLoggerDump()), never concurrently with itself.
+ * It must not call the cJSON logger API. The callbacks of cJSONLoggerQuery() and cJSONLoggerTail() run on the calling thread and may call it.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The user data of the sink.
+ */
+typedef void (*CJSONLoggerRecordCallback)(const CJSONLoggerRecord_s* records, size_t count, void* userData);
+
+/**
+ * @struct CJSONLoggerQuery
+ *
+ * @brief Filter of a query over the logs held in memory, used with cJSONLoggerQuery().
+ *
+ * @note Use cJSONLoggerGetDefaultQuery() to fill the defaults (match everything) before changing any field.
+ *
+ * @var jsonPath The names of the JSON nodes the matching records are under (path prefix), compared case insensitively.
+ * @var jsonPathDepth The number of names in the jsonPath, 0 for every node.
+ * @var logLevel The log level severity threshold of the matching records, __CJSON_LOG_LEVEL_START for every log level.
+ * @var fileName The file name of the matching call sites, NULL for any.
+ * @var funcName The function name of the matching call sites, NULL for any.
+ * @var fileLine The file line of the matching call sites, 0 for any.
+ * @var fromTimeStamp The oldest matching time stamp in nanoseconds since the epoch, 0 for no lower bound.
+ * @var toTimeStamp The newest matching time stamp in nanoseconds since the epoch, 0 for no upper bound.
+ * @var maxRecords Max number of matching records, 0 for no limit.
+ */
+typedef struct CJSONLoggerQuery {
+    const char* const* jsonPath;
+    size_t jsonPathDepth;
+    CJSON_LOG_LEVEL_E logLevel;
+    const char* fileName;
+    const char* funcName;
+    int fileLine;
+    int64_t fromTimeStamp;
+    int64_t toTimeStamp;
+    size_t maxRecords;
+} CJSONLoggerQuery_s;
+
+/**
+ * @struct CJSONLoggerConfig
+ *
+ * @brief Configuration of the cJSON logger, used with cJSONLoggerInitWithConfig().
+ *
+ * @note Use cJSONLoggerGetDefaultConfig() to fill the defaults before changing any field.
+ *
+ * @var logLevel The starting log level severity threshold.
+ * @var filePath Path to file where JSON logs will be stored, NULL to keep no logs in memory (requires shmName or socketPath).
+ * @var workerThreads Number of background worker threads (parallel printing, rotations), 0 runs the background work on the logging threads.
+ * @var workerCpuList CPU list (e.g. "0-3,8") the logger threads are pinned to, NULL to leave them unpinned.
+ * @var workerNice Nice value (-20 to 19) of the logger threads, CJSON_LOGGER_NICE_INHERIT keeps the inherited value.
+ * @var workerSchedPolicy Scheduling policy of the logger threads, CJSON_LOGGER_SCHED_INHERIT keeps the policy of the initializing thread.
+ * @var workerSchedPriority Scheduling priority of the logger threads, only used by CJSON_LOGGER_SCHED_FIFO and CJSON_LOGGER_SCHED_RR.
+ * @var forkMode How child processes created with fork() continue the logs of the process.
+ * @var shmName POSIX shared memory object name (e.g. "/cjsonlogger") of the ring every record is also written to, NULL to disable it.
+ * @var shmCapacity Number of records the shared memory ring can hold, a power of two, 0 for the default.
+ * @var socketPath Path of a Unix domain (SOCK_SEQPACKET) socket every record is also sent to as NDJSON, NULL to disable it.
+ * @var socketQueueCapacity Number of records queued for the socket before new ones are dropped, a power of two.
+ * @var socketBatchSize Number of queued records that triggers a send, the queue is also sent by cJSONLoggerDump().
+ * @var flightRecorderCapacity Number of records kept in memory by the flight recorder, 0 to disable it (requires filePath).
+ * @var flightRecorderTriggerLevel Log level severity threshold of the records triggering the flight recorder.
+ * @var flightRecorderPostRecords Number of records following a trigger that are written straight to the JSON tree.
+ * @var rotateLogCount Number of logs kept in the JSON tree before it rotates, 0 for the default.
+ * @var flushIntervalMs Interval in milliseconds of a background cJSONLoggerDump() (a copy of the logs while it runs), 0 to disable it.
+ * @var preallocate Whether the JSON tree is sized for rotateLogCount logs up front and after every rotation, and the logging path warmed up.
+ * @var lazyInit Whether the JSON tree, the files and the threads are only created by the first log admitted by the log level.
+ * @var timeFormat How the time stamps are printed by the JSON tree and the NDJSON sinks.
+ * @var sequenceNumbers Whether every record gets a number (printed as "Sequence") increasing across the threads in logging order.
+ * @var threadIds Whether every record gets the id of its logging thread (printed as "ThreadId").
+ */
+typedef struct CJSONLoggerConfig {
+    CJSON_LOG_LEVEL_E logLevel;
+    const char* filePath;
+    unsigned int workerThreads;
+    const char* workerCpuList;
+    int workerNice;
+    CJSON_LOGGER_SCHED_POLICY_E workerSchedPolicy;
+    int workerSchedPriority;
+    CJSON_LOGGER_FORK_MODE_E forkMode;
+    const char* shmName;
+    unsigned int shmCapacity;
+    const char* socketPath;
+    unsigned int socketQueueCapacity;
+    unsigned int socketBatchSize;
+    unsigned int flightRecorderCapacity;
+    CJSON_LOG_LEVEL_E flightRecorderTriggerLevel;
+    unsigned int flightRecorderPostRecords;
+    unsigned int rotateLogCount;
+    unsigned int flushIntervalMs;
+    int preallocate;
+    int lazyInit;
+    CJSON_LOGGER_TIME_FORMAT_E timeFormat;
+    int sequenceNumbers;
+    int threadIds;
+} CJSONLoggerConfig_s;
+
+/**
+ * @brief Fill a configuration with the default values.
+ *
+ * @param config The configuration to fill.
+ */
+void cJSONLoggerGetDefaultConfig(CJSONLoggerConfig_s* config);
+
+/**
+ * @struct CJSONLoggerSinkConfig
+ *
+ * @brief Configuration of a sink, used with cJSONLoggerAddSink().
+ *
+ * @note Use cJSONLoggerGetDefaultSinkConfig() to fill the defaults before changing any field.
+ *
+ * @var type The type of the sink.
+ * @var logLevel The log level severity threshold of the sink, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @var mostSevereLogLevel The most severe log level accepted by the sink, __CJSON_LOG_LEVEL_START accepts every severity.
+ * Together with logLevel it splits the records per log level (e.g. CJSON_LOG_LEVEL_DEBUG to CJSON_LOG_LEVEL_DEBUG for debug only).
+ * @var path The file path (CJSON_LOGGER_SINK_NDJSON) or socket path (CJSON_LOGGER_SINK_SOCKET) of the sink.
+ * @var queueCapacity Number of records queued for the sink before new ones are dropped, a power of two.
+ * @var batchSize Number of queued records that triggers a write of the sink, the queue is also written by cJSONLoggerDump().
+ * @var callback The callback of a CJSON_LOGGER_SINK_CALLBACK sink.
+ * @var userData The user data passed to the callback.
+ * @var rotateRecords Number of records after which the file of a CJSON_LOGGER_SINK_NDJSON sink rotates, 0 to disable.
+ * @var rotateSeconds Age in seconds after which the file of a CJSON_LOGGER_SINK_NDJSON sink rotates, 0 to disable.
+ * @var rotateFiles Number of rotated files of a CJSON_LOGGER_SINK_NDJSON sink kept, the oldest is removed, 0 keeps every file.
+ */
+typedef struct CJSONLoggerSinkConfig {
+    CJSON_LOGGER_SINK_TYPE_E type;
+    CJSON_LOG_LEVEL_E logLevel;
+    CJSON_LOG_LEVEL_E mostSevereLogLevel;
+    const char* path;
+    unsigned int queueCapacity;
+    unsigned int batchSize;
+    CJSONLoggerRecordCallback callback;
+    void* userData;
+    unsigned int rotateRecords;
+    unsigned int rotateSeconds;
+    unsigned int rotateFiles;
+} CJSONLoggerSinkConfig_s;
+
+/**
+ * @brief Fill a sink configuration with the default values.
+ *
+ * @param sinkConfig The sink configuration to fill.
+ */
+void cJSONLoggerGetDefaultSinkConfig(CJSONLoggerSinkConfig_s* sinkConfig);
+
 /**
  * @brief Initialize the cJSON logger and setup the resources.
  *
  * @warning This function must be called before any logging can occur.
  *
+ * @note No worker thread is started, the background work runs on the logging threads. Use cJSONLoggerInitWithConfig() for a worker pool.
+ *
  * @param logLevel The starting log level severity threshold.
  * @param filePath Path to file where JSON logs will be stored.
  *
@@ -79,10 +327,82 @@ typedef enum CJSON_LOG_LEVEL {
  */
 int cJSONLoggerInit(CJSON_LOG_LEVEL_E logLevel, const char* filePath);
 
+/**
+ * @brief Initialize the cJSON logger with a configuration and setup the resources.
+ *
+ * @warning This function (or cJSONLoggerInit()) must be called before any logging can occur.
+ *
+ * @note The worker pool, the periodic flush, the shared memory sink, the flight recorder and the socket sink are created by
+ * the first initialization asking for them. A later initialization keeps them and fails, without changing anything, when
+ * it asks for other settings (worker threads and their attributes, flush interval, shared memory name, capacity and
+ * time format, flight recorder or socket settings), cJSONLoggerDestroy() must release them first.
+ * A later initialization without a file path dumps the JSON tree to the previous file before dropping it.
+ * The CPU affinity, nice value and scheduling policy are applied to the logger threads when they are created,
+ * real time policies usually require privileges (CAP_SYS_NICE) and fail the initialization without them. A nice value below the
+ * one of the process needs CAP_SYS_NICE or a large enough RLIMIT_NICE, without them the threads keep the inherited value.
+ * The logger can be used on both sides of a fork(), the child recreates the worker threads on demand.
+ * A failed initialization may leave some of the resources created (e.g. the worker pool), cJSONLoggerDestroy() releases them.
+ * With lazyInit the resources are created by the first admitted log (or by cJSONLoggerAddSink(), cJSONLoggerSetNodeCapacity(),
+ * cJSONLoggerDeclarePath() and cJSONLoggerWatchConfigFile()), a failure there drops the configuration, is printed on the standard
+ * error (except in the dist builds) and fails the API that triggered it.
+ *
+ * @param config The logger configuration.
+ *
+ * @return int, 0 in case of success, negative value in case of failure (an invalid configuration, a resource that can not be
+ * created, or a later initialization changing the settings of a resource already created).
+ */
+int cJSONLoggerInitWithConfig(const CJSONLoggerConfig_s* config);
+
+/**
+ * @brief Initialize the cJSON logger from a JSON configuration file and the environment.
+ *
+ * @note The file holds the fields of CJSONLoggerConfig_s by name, log levels and enumerations as names (e.g. "logLevel": "DEBUG",
+ * "forkMode": "FRESH"), a "sinks" array of CJSONLoggerSinkConfig_s objects (type "NDJSON", "STDERR" or "SOCKET") and a "paths" array
+ * of {"path": ["foo", "bar"], "capacity": 100} objects capping nodes (cJSONLoggerSetNodeCapacity()) or declaring them with a "reserve"
+ * field (cJSONLoggerDeclarePath()), see cJSONLoggerWatchConfigFile()
+ * for their log level and rate limit fields. Missing fields keep their defaults.
+ * The CJSON_LOGGER_LEVEL and CJSON_LOGGER_FILE environment variables override the log level and the output file path.
+ * The configuration is parsed once, logging does not look it up.
+ *
+ * @param configPath The path of the configuration file, NULL for the path in the CJSON_LOGGER_CONFIG environment variable,
+ * without it only the environment variables are applied to the defaults.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int cJSONLoggerInitFromFile(const char* configPath);
+
+/**
+ * @brief Apply a JSON configuration file now and reload it whenever it changes, watched with inotify.
+ *
+ * @note A reload applies the log level (cJSONLoggerSetLogLevel()) and the "logLevel", "rateLimit" (logs per second) and "rateBurst"
+ * fields of the "paths" entries, e.g. {"path": ["net"], "logLevel": "DEBUG", "rateLimit": 100}. The deepest entry matching a log applies
+ * to it. The per path rules are published as a whole and read without locks, a reload never blocks the logging threads.
+ * A file that does not load keeps the current configuration. The environment variables override the file as in cJSONLoggerInitFromFile().
+ *
+ * @param configPath The path of the configuration file, NULL for the path in the CJSON_LOGGER_CONFIG environment variable.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int cJSONLoggerWatchConfigFile(const char* configPath);
+
+/**
+ * @brief Add a sink the records are fanned out to, next to the JSON tree written to the output file.
+ *
+ * @note Logging only copies the record into the queue of the sink, the records are written in batches by the worker threads.
+ * cJSONLoggerDump() and cJSONLoggerRotate() write the queued records first, cJSONLoggerDestroy() closes the sinks.
+ *
+ * @param sinkConfig The sink configuration.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int cJSONLoggerAddSink(const CJSONLoggerSinkConfig_s* sinkConfig);
+
 /**
  * @brief Delete the cJSON logger and clean up resources.
  *
- * @note This function is registered with atexit() during initialization, so it will be called automatically at program exit.
+ * @note This function is registered with atexit() by the first initialization, so it will be called automatically at program exit.
+ * The JSON tree is only written if it took logs and changed since it was last written, destroying a destroyed or uninitialized
+ * logger does nothing.
  */
 void cJSONLoggerDestroy();
 
@@ -104,6 +424,10 @@ void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...);
 /**
  * @brief Dump the contents of the cJSONLogger into a file.
  *
+ * @note The queued records of the sinks are written as well. The output file is always written by the first dump after an
+ * initialization, then only if the logs changed since the last dump.
+ * The logs are copied under the lock and printed from the copy, so a dump briefly needs about as much memory again as the JSON tree.
+ *
  * @warning This will replace the current content of the default log file. Prefer to use cJSONLoggerRotate() to rotate the log file instead.
  *
  */
@@ -112,10 +436,21 @@ void cJSONLoggerDump();
 /**
  * @brief Dump the contents of the cJSONLogger into a file and rotate.
  *
+ * @note The sinks rotate as well, the NDJSON files are renamed with the same prefix as the rotated JSON tree files.
+ * The JSON tree does not rotate if the logs did not change since the last rotation.
+ *
  * @note Logger rotates by default after MAX_LOG_COUNT (500) lines and creates number of files up to MAX_LOG_ROTATION_FILES (5), afterwards the older rotated file is deleted.
  */
 void cJSONLoggerRotate();
 
+/**
+ * @brief Persist the records kept by the flight recorder into the JSON tree, as if a record reached the trigger level.
+ *
+ * @note The records following the trigger are written straight to the JSON tree as well, up to flightRecorderPostRecords.
+ * Does nothing when the flight recorder is disabled.
+ */
+void cJSONLoggerFlightRecorderTrigger();
+
 /**
  * @brief Sets the log level for the cJSON logger.
  *
@@ -123,6 +458,73 @@ void cJSONLoggerRotate();
  */
 void cJSONLoggerSetLogLevel(CJSON_LOG_LEVEL_E logLevel);
 
+/**
+ * @brief Fill a query with the default values, matching every record.
+ *
+ * @param query The query to fill.
+ */
+void cJSONLoggerGetDefaultQuery(CJSONLoggerQuery_s* query);
+
+/**
+ * @brief Query the logs held in memory without printing them.
+ *
+ * @note The records are handed to the callback in batches, node by node in tree order and in logging order within a node.
+ * Only the logs since the last rotation are held in memory. The matching records are copied while the logs are locked, the
+ * callback then runs on the calling thread once they are unlocked and may call the cJSON logger API (e.g. log, dump or query).
+ *
+ * @param query The filter of the query.
+ * @param callback The callback receiving the matching records.
+ * @param userData The user data passed to the callback.
+ *
+ * @return int, the number of matching records, negative value in case of failure.
+ */
+int cJSONLoggerQuery(const CJSONLoggerQuery_s* query, CJSONLoggerRecordCallback callback, void* userData);
+
+/**
+ * @brief Cap a JSON node to its most recent records, the newest record replaces the oldest one once the node is full.
+ *
+ * @note The node is created if it does not exist, the records above the new capacity are dropped, oldest first.
+ * A capped node keeps MAX_LOG_MSG_LEN (256) bytes per record and its records do not count towards the automatic rotation,
+ * the cap is kept by the rotations. Only the records of the node itself are capped, not the ones of its children.
+ *
+ * @param jsonPath The names of the JSON nodes leading to the node.
+ * @param jsonPathDepth The number of names in the jsonPath, 0 for the root node.
+ * @param capacity The max number of records kept by the node, 0 to lift the cap.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int cJSONLoggerSetNodeCapacity(const char* const* jsonPath, size_t jsonPathDepth, unsigned int capacity);
+
+/**
+ * @brief Declare a JSON node ahead of its first record, the node and its parents are created and its records are allocated up front.
+ *
+ * @note The node is kept by the rotations, empty until it is logged to. Records beyond logCapacity grow the node as usual.
+ * Declaring a node again changes the number of records allocated for it by the next rotations.
+ *
+ * @param jsonPath The names of the JSON nodes leading to the node.
+ * @param jsonPathDepth The number of names in the jsonPath, 0 for the root node.
+ * @param logCapacity The number of records allocated for the node, 0 to only create it.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int cJSONLoggerDeclarePath(const char* const* jsonPath, size_t jsonPathDepth, unsigned int logCapacity);
+
+/**
+ * @brief Read the most recent records of a JSON node, oldest first.
+ *
+ * @note Only the records of the node itself are read, not the ones of its children. The records are copied while the logs are
+ * locked, the callback then runs on the calling thread once they are unlocked and may call the cJSON logger API.
+ *
+ * @param jsonPath The names of the JSON nodes leading to the node, compared case insensitively.
+ * @param jsonPathDepth The number of names in the jsonPath, 0 for the root node.
+ * @param count The max number of records to read, 0 for every record of the node.
+ * @param callback The callback receiving the records.
+ * @param userData The user data passed to the callback.
+ *
+ * @return int, the number of records read, negative value in case of failure.
+ */
+int cJSONLoggerTail(const char* const* jsonPath, size_t jsonPathDepth, size_t count, CJSONLoggerRecordCallback callback, void* userData);
+
 /**
  * @def __FILENAME__
  *
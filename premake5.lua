@@ -31,7 +31,8 @@ project "cJSONLogger"
 
 	links
 	{
-		"pthread"
+		"pthread",
+		"rt"
 	}
 
 	buildoptions { "-Wall", "-Wextra", "-Wpedantic", "-Werror", "-Wuninitialized", "-Wunreachable-code", "-Wconversion", "-Wsign-conversion", "-fstack-protector-strong" }
@@ -83,13 +84,15 @@ project "cJSONLoggerTests"
 	includedirs
 	{
 		"cJSON",
-		"include"
+		"include",
+		"src"
 	}
 
 	links
 	{
 		"cJSONLogger",
-		"pthread"
+		"pthread",
+		"rt"
 	}
 
 	filter "configurations:debug"
@@ -147,3 +150,113 @@ project "cJSONLoggerMultiThreadTests"
 		runtime "Release"
 		symbols "off"
 		optimize "on"
+
+project "cJSONLoggerBenchmark"
+	kind "ConsoleApp"
+
+	files
+	{
+		"benchmarks/latency_benchmark.c"
+	}
+
+	includedirs
+	{
+		"include"
+	}
+
+	links
+	{
+		"cJSONLogger",
+		"pthread"
+	}
+
+	buildoptions { "-Wall", "-Wextra", "-Wpedantic", "-Werror", "-Wconversion", "-Wsign-conversion" }
+
+	filter "configurations:debug"
+		runtime "Debug"
+		symbols "on"
+		optimize "off"
+
+	filter "configurations:release"
+		runtime "Release"
+		symbols "on"
+		optimize "on"
+
+	filter "configurations:dist"
+		runtime "Release"
+		symbols "off"
+		optimize "on"
+
+project "cJSONLoggerCollector"
+	kind "ConsoleApp"
+
+	files
+	{
+		"tools/collector.c"
+	}
+
+	includedirs
+	{
+		"cJSON",
+		"include",
+		"src"
+	}
+
+	links
+	{
+		"cJSONLogger",
+		"rt"
+	}
+
+	buildoptions { "-Wall", "-Wextra", "-Wpedantic", "-Werror", "-Wconversion", "-Wsign-conversion" }
+
+	filter "configurations:debug"
+		runtime "Debug"
+		symbols "on"
+		optimize "off"
+
+	filter "configurations:release"
+		runtime "Release"
+		symbols "on"
+		optimize "on"
+
+	filter "configurations:dist"
+		runtime "Release"
+		symbols "off"
+		optimize "on"
+
+project "cJSONLoggerReceiver"
+	kind "ConsoleApp"
+
+	files
+	{
+		"tools/receiver.c"
+	}
+
+	includedirs
+	{
+		"include",
+		"src"
+	}
+
+	links
+	{
+		"cJSONLogger"
+	}
+
+	buildoptions { "-Wall", "-Wextra", "-Wpedantic", "-Werror", "-Wconversion", "-Wsign-conversion" }
+
+	filter "configurations:debug"
+		runtime "Debug"
+		symbols "on"
+		optimize "off"
+
+	filter "configurations:release"
+		runtime "Release"
+		symbols "on"
+		optimize "on"
+
+	filter "configurations:dist"
+		runtime "Release"
+		symbols "off"
+		optimize "on"
@@ -9,15 +9,36 @@
  */
 
 #include "cJSONLogger.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerCallbackSink.h"
+#include "cJSONLoggerConfigFile.h"
+#include "cJSONLoggerConfigWatcher.h"
+#include "cJSONLoggerEscape.h"
+#include "cJSONLoggerFlightRecorder.h"
+#include "cJSONLoggerFormat.h"
+#include "cJSONLoggerLogIndex.h"
+#include "cJSONLoggerRuntimeConfig.h"
+#include "cJSONLoggerShmRing.h"
+#include "cJSONLoggerShmSink.h"
+#include "cJSONLoggerSink.h"
+#include "cJSONLoggerSocketSink.h"
+#include "cJSONLoggerStreamSink.h"
+#include "cJSONLoggerThread.h"
+#include "cJSONLoggerTimer.h"
+#include "cJSONLoggerWorkerPool.h"
 
-#include <cJSON.h>
-
-#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <pthread.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <strings.h>
+#include <sys/uio.h>
 #include <time.h>
+#include <unistd.h>
 
 /**
  * @def MAX_FILE_NAME_LEN
@@ -26,13 +47,6 @@
  */
 #define MAX_FILE_NAME_LEN 128
 
-/**
- * @def MAX_TIME_STR_LEN
- *
- * @brief The maximum length of a string representation of time.
- */
-#define MAX_TIME_STR_LEN 128
-
 /**
  * @def MAX_LOG_MSG_LEN
  *
@@ -41,149 +55,287 @@
 #define MAX_LOG_MSG_LEN 256
 
 /**
- * @def MAX_LOG_COUNT
+ * @def MAX_JSON_PATH_DEPTH
  *
- * @brief The maximum number of log messages to keep in memory before rotating logs.
+ * @brief The maximum number of JSON nodes a single log can descend into (every JNO formatter takes at least two characters).
  */
-#define MAX_LOG_COUNT 500
+#define MAX_JSON_PATH_DEPTH (MAX_LOG_MSG_LEN / 2)
 
 /**
- * @def MAX_LOG_ROTATION_FILES
+ * @def INITIAL_NODE_CAPACITY
  *
- * @brief The maximum number of log rotation files to keep.
+ * @brief The initial number of children or records allocated for a node.
  */
-#define MAX_LOG_ROTATION_FILES 5
+#define INITIAL_NODE_CAPACITY 4
 
 /**
- * @def CJSONLOGGER_DEBUG
+ * @def INITIAL_ARENA_CAPACITY
  *
- * @brief When building for debugging.
+ * @brief The initial size in bytes of the string arena that stores the log messages.
  */
-#ifdef CJSONLOGGER_DEBUG
+#define INITIAL_ARENA_CAPACITY 4096
 
 /**
- * @def CJSON_LOGGER_ASSERT_EQ
+ * @def INITIAL_CALL_SITE_CAPACITY
  *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
- *
- * @brief Does an assertion when the expression is equal to the expected value.
+ * @brief The initial number of slots of the call site hash table (must be a power of two).
  */
-#define CJSON_LOGGER_ASSERT_EQ(expr, expected) \
-    do {                                       \
-        assert(expr == expected);              \
-    } while (0);
+#define INITIAL_CALL_SITE_CAPACITY 64
 
 /**
- * @def CJSON_LOGGER_ASSERT_NEQ
- *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
+ * @def PREALLOC_LOG_MSG_LEN
  *
- * @brief Does an assertion when the expression is not equal to the expected value.
+ * @brief The average size in bytes of a log message the string arena is sized for when the store is preallocated.
  */
-#define CJSON_LOGGER_ASSERT_NEQ(expr, expected) \
-    do {                                        \
-        assert(expr != expected);               \
-    } while (0);
-
-#endif
+#define PREALLOC_LOG_MSG_LEN 64
 
 /**
- * @def CJSONLOGGER_RELEASE
+ * @def MAX_QUERY_BATCH_RECORDS
  *
- * @brief When building for a release.
+ * @brief Max number of records handed to a single call of the query callback.
  */
-#ifdef CJSONLOGGER_RELEASE
+#define MAX_QUERY_BATCH_RECORDS 64
 
 /**
- * @def CJSON_LOGGER_ASSERT_EQ
+ * @def MAX_WORKER_THREADS
  *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
+ * @brief The maximum number of background worker threads.
+ */
+#define MAX_WORKER_THREADS 64
+
+/**
+ * @def DEFAULT_WORKER_THREADS
  *
- * @brief Prints an error message if the expression is not equal to the expected value.
+ * @brief The default number of background worker threads (capped by the number of online CPUs).
  */
-#define CJSON_LOGGER_ASSERT_EQ(expr, expected)                                                     \
-    do {                                                                                           \
-        if (expr != expected) {                                                                    \
-            fprintf(stderr, "Assertion at [%s:%s:%d] failed\n", __FILENAME__, __func__, __LINE__); \
-        }                                                                                          \
-    } while (0);
+#define DEFAULT_WORKER_THREADS 4
 
 /**
- * @def CJSON_LOGGER_ASSERT_NEQ
+ * @def DEFAULT_SINK_QUEUE_CAPACITY
  *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
+ * @brief The default number of records the queue of a sink can hold.
+ */
+#define DEFAULT_SINK_QUEUE_CAPACITY 1024
+
+/**
+ * @def DEFAULT_SINK_BATCH_SIZE
  *
- * @brief Prints an error message if the expression is equal to the expected value.
+ * @brief The default number of queued records that triggers a write of a sink.
  */
-#define CJSON_LOGGER_ASSERT_NEQ(expr, expected)                                                    \
-    do {                                                                                           \
-        if (expr == expected) {                                                                    \
-            fprintf(stderr, "Assertion at [%s:%s:%d] failed\n", __FILENAME__, __func__, __LINE__); \
-        }                                                                                          \
-    } while (0);
+#define DEFAULT_SINK_BATCH_SIZE 64
 
-#endif
+/**
+ * @def DEFAULT_FLIGHT_RECORDER_POST_RECORDS
+ *
+ * @brief Default number of records following a flight recorder trigger that are written straight to the log store.
+ */
+#define DEFAULT_FLIGHT_RECORDER_POST_RECORDS 64
 
 /**
- * @def CJSONLOGGER_DIST
+ * @def MAX_SINKS
  *
- * @brief When building for a distribution.
+ * @brief The maximum number of sinks, the JSON tree sink included.
  */
-#ifdef CJSONLOGGER_DIST
+#define MAX_SINKS 16
 
 /**
- * @def CJSON_LOGGER_ASSERT_EQ
+ * @def PARALLEL_PRINT_MIN_LOGS
  *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
+ * @brief The minimum number of logs a store must hold before its top level nodes are printed in parallel.
+ */
+#define PARALLEL_PRINT_MIN_LOGS 256
+
+/**
+ * @def MAX_WRITE_IOVECS
  *
- * @brief Does nothing.
+ * @brief The maximum number of buffers written by a single vectored write.
  */
-#define CJSON_LOGGER_ASSERT_EQ(expr, expected) \
-    do {                                       \
-        if (expr != expected) {                \
-        }                                      \
-    } while (0);
+#define MAX_WRITE_IOVECS 64
 
 /**
- * @def CJSON_LOGGER_ASSERT_NEQ
+ * @def LOGS_ENTRY
  *
- * @param expr The expression to evaluate.
- * @param expected The expected value.
+ * @brief Entry index used for the logs array of a node when printing its entries.
+ */
+#define LOGS_ENTRY UINT32_MAX
+
+/**
+ * @def MAX_LOG_COUNT
  *
- * @brief Does nothing.
+ * @brief The default maximum number of log messages to keep in memory before rotating logs.
  */
-#define CJSON_LOGGER_ASSERT_NEQ(expr, expected) \
-    do {                                        \
-        if (expr == expected) {                 \
-        }                                       \
-    } while (0);
+#define MAX_LOG_COUNT 500
 
-#endif
+/**
+ * @def MAX_LOG_ROTATION_FILES
+ *
+ * @brief The maximum number of log rotation files to keep.
+ */
+#define MAX_LOG_ROTATION_FILES 5
 
 /**
  * @struct LogInfo
  *
  * @brief Structure used to store information about a log.
  *
- * @var timeStamp The logs time stamp as a string representation.
+ * @var timeStamp The logs time stamp in nanoseconds since the epoch.
  * @var logLevel The logs log level.
  * @var fileName The logs file name.
  * @var funcName The logs function name.
  * @var fileLine The logs file line.
  */
 typedef struct LogInfo {
-    char timeStamp[MAX_TIME_STR_LEN];
+    int64_t timeStamp;
     CJSON_LOG_LEVEL_E logLevel;
     char* fileName;
     char* funcName;
     int fileLine;
 } LogInfo_s;
 
+/**
+ * @struct LogTargets
+ *
+ * @brief Structure used to store the levels and the destinations of the logger, read once per log.
+ *
+ * @var logLevel The log level of the logger.
+ * @var sinksLogLevel The most verbose log level of the sinks with their own threshold.
+ * @var hasLogStore Whether the logs are kept in the log store.
+ * @var hasShmSink Whether the logs are written to the shared memory ring.
+ * @var hasFlightRecorder Whether the logs go through the flight recorder.
+ * @var recordSinkCount Number of sinks fed the records, the sink printing the log store excluded.
+ */
+typedef struct LogTargets {
+    CJSON_LOG_LEVEL_E logLevel;
+    CJSON_LOG_LEVEL_E sinksLogLevel;
+    int hasLogStore;
+    int hasShmSink;
+    int hasFlightRecorder;
+    unsigned int recordSinkCount;
+} LogTargets_s;
+
+/**
+ * @struct CallSite
+ *
+ * @brief Structure used to store an interned call site, shared by every log emitted from the same place.
+ *
+ * @var hash The hash of the file name, function name and file line of the call site.
+ * @var fileKey The file name pointer the call site was interned with, only spares the string comparison of a matching hash.
+ * @var funcKey The function name pointer the call site was interned with, only spares the string comparison of a matching hash.
+ * @var fileName Copy of the file name, NULL when the log had none.
+ * @var funcName Copy of the function name, NULL when the log had none.
+ * @var fileLine The file line, 0 when the log had none.
+ */
+typedef struct CallSite {
+    uint64_t hash;
+    const char* fileKey;
+    const char* funcKey;
+    char* fileName;
+    char* funcName;
+    int fileLine;
+} CallSite_s;
+
+/**
+ * @struct LogNode
+ *
+ * @brief A JSON node of the log tree, its logs are stored column wise.
+ *
+ * @var name The node name, NULL for the root node.
+ * @var parent The parent node, NULL for the root node.
+ * @var children Array of the child nodes in insertion order.
+ * @var childCount Number of child nodes.
+ * @var childCapacity Allocated size of the children array.
+ * @var logsIndex Position of the "logs" key among the children, valid once the node holds a log.
+ * @var timeStamps Column of the log time stamps (nanoseconds since the epoch).
+ * @var logLevels Column of the log levels.
+ * @var callSites Column of the log call site ids.
+ * @var messages Column of the log message offsets into the store arena.
+ * @var messageLengths Column of the log message lengths.
+ * @var escapedLengths Column of the log message lengths once escaped for JSON, equal to the message length if nothing needs an escape.
+ * @var sequences Column of the log sequence numbers, 0 if not numbered, NULL until a log of the node is numbered.
+ * @var threadIds Column of the kernel thread ids of the logging threads, 0 if not recorded, NULL until a log of the node records it.
+ * @var logCount Number of logs stored in the columns.
+ * @var logCapacity Allocated size of the columns.
+ * @var ringCapacity Max number of logs kept by the node, the newest log replaces the oldest one, 0 if not capped.
+ * @var ringHead Position of the oldest log in the columns of a capped node, 0 if not capped.
+ * @var ringMessages The messages of a capped node, MAX_LOG_MSG_LEN bytes per log, NULL if not capped.
+ * @var index Query index of the logs.
+ * @var reservedCapacity Number of logs the columns are allocated for up front, 0 if the node was not declared.
+ * @var subtreeLogLevelMask Bit (log level) set for every log level of the node and its descendants.
+ * @var subtreeMinTimeStamp The oldest time stamp of the node and its descendants.
+ * @var subtreeMaxTimeStamp The newest time stamp of the node and its descendants.
+ */
+typedef struct LogNode {
+    char* name;
+    struct LogNode* parent;
+    struct LogNode** children;
+    unsigned int childCount;
+    unsigned int childCapacity;
+    unsigned int logsIndex;
+    int64_t* timeStamps;
+    uint8_t* logLevels;
+    uint32_t* callSites;
+    uint32_t* messages;
+    uint16_t* messageLengths;
+    uint16_t* escapedLengths;
+    uint64_t* sequences;
+    uint32_t* threadIds;
+    unsigned int logCount;
+    unsigned int logCapacity;
+    unsigned int ringCapacity;
+    unsigned int ringHead;
+    char* ringMessages;
+    LogIndex_s index;
+    unsigned int reservedCapacity;
+    uint8_t subtreeLogLevelMask;
+    int64_t subtreeMinTimeStamp;
+    int64_t subtreeMaxTimeStamp;
+} LogNode_s;
+
+/**
+ * @struct LogStore
+ *
+ * @brief In memory store of the logs, the JSON text is only printed when the logs are dumped.
+ *
+ * @var root The root node of the log tree.
+ * @var arena String arena holding the NUL terminated log messages, each one followed by its escaped copy if it needs an escape.
+ * @var arenaSize Used bytes of the arena.
+ * @var arenaCapacity Allocated bytes of the arena.
+ * @var callSites Array of the interned call sites.
+ * @var callSiteCount Number of interned call sites.
+ * @var callSiteTable Open addressing hash table of call site ids (offset by one, 0 marks an empty slot).
+ * @var callSiteTableSize Number of slots of the hash table (power of two).
+ * @var logCount Number of logs held by the store.
+ * @var ringNodes Array of the capped nodes.
+ * @var ringNodeCount Number of capped nodes.
+ * @var ringNodeCapacity Allocated size of the capped nodes array.
+ * @var declaredNodes Array of the declared nodes, kept by the rotations.
+ * @var declaredNodeCount Number of declared nodes.
+ * @var declaredNodeCapacity Allocated size of the declared nodes array.
+ * @var preallocLogs Number of logs the arena is sized for up front, 0 to grow it on demand.
+ * @var baseGeneration The log generation when the store was swapped in, the store did not change while it is current.
+ * @var callSiteNamesInArena Whether the call site names are stored behind the arena (copies for printing), not freed one by one.
+ */
+typedef struct LogStore {
+    LogNode_s* root;
+    char* arena;
+    size_t arenaSize;
+    size_t arenaCapacity;
+    CallSite_s* callSites;
+    uint32_t callSiteCount;
+    uint32_t* callSiteTable;
+    uint32_t callSiteTableSize;
+    unsigned int logCount;
+    LogNode_s** ringNodes;
+    unsigned int ringNodeCount;
+    unsigned int ringNodeCapacity;
+    LogNode_s** declaredNodes;
+    unsigned int declaredNodeCount;
+    unsigned int declaredNodeCapacity;
+    unsigned int preallocLogs;
+    uint64_t baseGeneration;
+    int callSiteNamesInArena;
+} LogStore_s;
+
 /**
  * @struct Queue
  *
@@ -207,9 +359,19 @@ typedef struct Queue {
 static Queue_s* s_g_rotatedFilesQueue = NULL;
 
 /**
- * @brief Root JSON node for the logger.
+ * @brief The log store of the logger.
+ */
+static LogStore_s* s_g_logStore = NULL;
+
+/**
+ * @brief Generation of the logs, bumped by every change of the log store and by the rotations, protected by s_g_rootNodeMutex.
+ */
+static uint64_t s_g_logGeneration = 0;
+
+/**
+ * @brief Generation of the logs last printed to the output file, protected by s_g_rootNodeMutex.
  */
-static cJSON* s_g_rootNode = NULL;
+static uint64_t s_g_dumpedGeneration = 0;
 
 /**
  * @brief File path where logs will be stored.
@@ -227,7 +389,12 @@ static CJSON_LOG_LEVEL_E s_g_logLevel = __CJSON_LOG_LEVEL_START;
 static unsigned int s_g_logCount = 0;
 
 /**
- * @brief Mutex for accessing the root JSON node.
+ * @brief Number of logs kept in memory before rotating logs.
+ */
+static unsigned int s_g_rotateLogCount = MAX_LOG_COUNT;
+
+/**
+ * @brief Mutex for accessing the log store.
  */
 static pthread_mutex_t s_g_rootNodeMutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -237,214 +404,3607 @@ static pthread_mutex_t s_g_rootNodeMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t s_g_cLoggerMutex = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * @brief Get the string representation of the log level.
+ * @brief Worker pool running the background work of the logger (parallel printing, rotations).
+ */
+static WorkerPool_s* s_g_workerPool = NULL;
+
+/**
+ * @brief Lock held for reading while the worker pool is used and for writing while it is created or destroyed.
+ */
+static pthread_rwlock_t s_g_workerPoolLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * @brief Set while an automatic rotation is queued on the worker pool.
+ */
+static int s_g_rotatePending = 0;
+
+/**
+ * @brief Number of worker threads the worker pool is created with.
+ */
+static unsigned int s_g_workerThreadCount = 0;
+
+/**
+ * @brief Scheduling attributes the worker pool is created with, the CPU list is owned by the logger.
+ */
+static LoggerThreadAttr_s s_g_workerThreadAttr = { .nice = CJSON_LOGGER_NICE_INHERIT };
+
+/**
+ * @brief Set in a forked child whose worker pool has not been recreated yet.
+ */
+static int s_g_workerPoolForked = 0;
+
+/**
+ * @brief Timer flushing the logger periodically without a worker pool, protected by the worker pool lock, NULL if disabled.
+ */
+static LoggerTimer_s* s_g_flushTimer = NULL;
+
+/**
+ * @brief Set when the worker pool flushes the logger periodically, protected by the worker pool lock.
+ */
+static int s_g_flushPeriodic = 0;
+
+/**
+ * @brief Watcher reloading the configuration file, protected by the worker pool lock, NULL if disabled.
+ */
+static ConfigWatcher_s* s_g_configWatcher = NULL;
+
+/**
+ * @brief How the state of the logger is handed to forked child processes.
+ */
+static CJSON_LOGGER_FORK_MODE_E s_g_forkMode = CJSON_LOGGER_FORK_INHERIT;
+
+/**
+ * @brief Sink writing the records to a shared memory ring, NULL when disabled.
+ */
+static ShmSink_s* s_g_shmSink = NULL;
+
+/**
+ * @brief Lock held for reading while the shared memory sink is used and for writing while it is opened or closed.
+ */
+static pthread_rwlock_t s_g_shmSinkLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * @brief Flight recorder keeping the records away from the log store until a trigger, NULL when disabled.
+ */
+static FlightRecorder_s* s_g_flightRecorder = NULL;
+
+/**
+ * @brief Lock held for reading while the flight recorder is used and for writing while it is created or destroyed.
+ */
+static pthread_rwlock_t s_g_flightRecorderLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * @brief The sinks the records are fanned out to.
+ */
+static Sink_s* s_g_sinks[MAX_SINKS] = { 0 };
+
+/**
+ * @brief Number of sinks.
+ */
+static unsigned int s_g_sinkCount = 0;
+
+/**
+ * @brief The sink printing the log store as a JSON tree to the output file, NULL until the logger is initialized with a file path.
+ */
+static Sink_s* s_g_treeSink = NULL;
+
+/**
+ * @brief The sink sending the records to the socket path of the configuration, NULL until the logger is initialized with one.
+ */
+static Sink_s* s_g_socketSink = NULL;
+
+/**
+ * @brief The most verbose log level severity threshold of the sinks with their own threshold.
+ */
+static CJSON_LOG_LEVEL_E s_g_sinksLogLevel = __CJSON_LOG_LEVEL_START;
+
+/**
+ * @brief Number of sinks fed the records, the tree sink excluded, read with the log levels.
+ */
+static unsigned int s_g_recordSinkCount = 0;
+
+/**
+ * @brief Whether the log store exists, read with the log levels so a log only takes the locks of its destinations.
+ */
+static int s_g_hasLogStore = 0;
+
+/**
+ * @brief Whether the shared memory sink exists, read with the log levels.
+ */
+static int s_g_hasShmSink = 0;
+
+/**
+ * @brief Whether the flight recorder exists, read with the log levels.
+ */
+static int s_g_hasFlightRecorder = 0;
+
+/**
+ * @brief Lock held for reading while the sinks are used and for writing while sinks are added or destroyed.
+ */
+static pthread_rwlock_t s_g_sinksLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * @brief Registers the fork handlers once per process.
+ */
+static pthread_once_t s_g_atForkOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief The configuration recorded by a lazy initialization, applied by the first admitted log.
+ */
+static CJSONLoggerConfig_s s_g_lazyConfig = { 0 };
+
+/**
+ * @brief The strings of the lazy configuration, in a single allocation.
+ */
+static char* s_g_lazyConfigStrings = NULL;
+
+/**
+ * @brief Whether a lazy initialization is waiting for the first admitted log, read with the log levels.
+ */
+static int s_g_lazyInitPending = 0;
+
+/**
+ * @brief Serializes the initializations, taken before any other lock of the logger.
+ */
+static pthread_mutex_t s_g_lazyConfigLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief The configuration of the resources created by the initializations, a later initialization must keep their settings.
+ */
+static CJSONLoggerConfig_s s_g_initConfig = { 0 };
+
+/**
+ * @brief The strings of the configuration of the resources, in a single allocation.
+ */
+static char* s_g_initConfigStrings = NULL;
+
+/**
+ * @brief Registers cJSONLoggerDestroy() with atexit() once per process.
+ */
+static pthread_once_t s_g_atExitOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Whether cJSONLoggerDestroy() has resources to release, set by the initialization and the API creating resources.
+ */
+static int s_g_destroyPending = 0;
+
+/**
+ * @brief Whether the records are numbered, see CJSONLoggerConfig_s.sequenceNumbers.
+ */
+static atomic_int s_g_sequenceNumbers = 0;
+
+/**
+ * @brief The sequence number of the last numbered record, shared by all the threads.
+ */
+static atomic_uint_fast64_t s_g_recordSequence = 0;
+
+/**
+ * @brief Whether the records hold the kernel thread id of the logging thread, see CJSONLoggerConfig_s.threadIds.
+ */
+static atomic_int s_g_threadIds = 0;
+
+/**
+ * @brief Create a new log node.
  *
- * @param logLevel The log level to convert.
+ * @param parent The parent of the node, NULL for the root node.
+ * @param name The name of the node, NULL for the root node.
  *
- * @return The string representation of the log level.
+ * @return LogNode_s* ptr of the new node, NULL in case of failure.
  */
-static inline const char* cJSONLoggerGetLogLevelStr(CJSON_LOG_LEVEL_E logLevel)
+static LogNode_s* logNodeCreate(LogNode_s* parent, const char* name)
 {
-    switch (logLevel) {
-    case CJSON_LOG_LEVEL_CRITICAL:
-        return "CRITICAL";
-    case CJSON_LOG_LEVEL_ERROR:
-        return "ERROR";
-    case CJSON_LOG_LEVEL_WARN:
-        return "WARN";
-    case CJSON_LOG_LEVEL_INFO:
-        return "INFO";
-    case CJSON_LOG_LEVEL_DEBUG:
-        return "DEBUG";
-    default:
-        return "UNKNOWN";
+    LogNode_s* node = (LogNode_s*)calloc(1, sizeof(LogNode_s));
+    CJSON_LOGGER_ASSERT_NEQ(node, NULL);
+    if (node == NULL) {
+        return NULL;
+    }
+
+    if (name != NULL) {
+        node->name = strdup(name);
+        CJSON_LOGGER_ASSERT_NEQ(node->name, NULL);
     }
+
+    node->parent = parent;
+    return node;
 }
 
 /**
- * @brief Push a log message to the specified JSON node.
+ * @brief Delete a log node and all of its children.
  *
- * @param node The JSON node to push the log message to.
- * @param logInfo The log info, such as time stamp, file name, etc.
- * @param logMsg The log message to push.
+ * @param node The node to delete.
  */
-static void cJSONLoggerPushLog(cJSON* node, LogInfo_s* logInfo, const char* logMsg)
+static void logNodeDelete(LogNode_s* node)
 {
-    CJSON_LOGGER_ASSERT_NEQ(logInfo, NULL);
-
-    pthread_mutex_lock(&s_g_rootNodeMutex);
-    CJSON_LOGGER_ASSERT_NEQ(node, NULL);
-
-    if (cJSON_HasObjectItem(node, "logs") == 0) {
-        cJSON_AddItemToObject(node, "logs", cJSON_CreateArray());
+    if (node == NULL) {
+        return;
     }
 
-    cJSON* logs = cJSON_GetObjectItem(node, "logs");
-    cJSON* log = cJSON_CreateObject();
-
-    cJSON_AddItemToArray(logs, log);
-    cJSON_AddItemToObject(log, "Time", cJSON_CreateString(logInfo->timeStamp));
-    cJSON_AddItemToObject(log, "LogLevel", cJSON_CreateString(cJSONLoggerGetLogLevelStr(logInfo->logLevel)));
-
-    if (logInfo->fileName != NULL) {
-        cJSON_AddItemToObject(log, "FileName", cJSON_CreateString(logInfo->fileName));
+    for (unsigned int i = 0; i < node->childCount; i++) {
+        logNodeDelete(node->children[i]);
     }
 
-    if (logInfo->funcName != NULL) {
-        cJSON_AddItemToObject(log, "FuncName", cJSON_CreateString(logInfo->funcName));
-    }
+    free(node->children);
+    free(node->timeStamps);
+    free(node->logLevels);
+    free(node->callSites);
+    free(node->messages);
+    free(node->messageLengths);
+    free(node->escapedLengths);
+    free(node->sequences);
+    free(node->threadIds);
+    free(node->ringMessages);
+    logIndexFree(&node->index);
+    free(node->name);
+    free(node);
+}
 
-    if (logInfo->fileLine != 0) {
-        cJSON_AddItemToObject(log, "FileLine", cJSON_CreateNumber(logInfo->fileLine));
+/**
+ * @brief Find the child node with the given name.
+ *
+ * @note Names are compared case insensitively, the same way cJSON_GetObjectItem() does.
+ *
+ * @param node The node where the child node will be searched.
+ * @param nodeName The name of the child node.
+ *
+ * @return LogNode_s* ptr of the child node, NULL if it does not exist.
+ */
+static LogNode_s* logNodeFindChild(const LogNode_s* node, const char* nodeName)
+{
+    for (unsigned int i = 0; i < node->childCount; i++) {
+        if (strcasecmp(node->children[i]->name, nodeName) == 0) {
+            return node->children[i];
+        }
     }
 
-    if (logMsg != NULL) {
-        cJSON_AddItemToObject(log, "Log", cJSON_CreateString(logMsg));
+    return NULL;
+}
+
+/**
+ * @brief Get the child node with the given name, creating it if it does not exist.
+ *
+ * @param node The node where the child node will be searched or inserted.
+ * @param nodeName The name of the child node.
+ *
+ * @return LogNode_s* ptr of the child node, NULL in case of failure.
+ */
+static LogNode_s* logNodeGetChild(LogNode_s* node, const char* nodeName)
+{
+    LogNode_s* child = logNodeFindChild(node, nodeName);
+    if (child != NULL) {
+        return child;
     }
 
-    pthread_mutex_unlock(&s_g_rootNodeMutex);
+    if (node->childCount == node->childCapacity) {
+        unsigned int capacity = node->childCapacity == 0 ? INITIAL_NODE_CAPACITY : node->childCapacity * 2;
+        LogNode_s** children = (LogNode_s**)realloc(node->children, capacity * sizeof(LogNode_s*));
+        CJSON_LOGGER_ASSERT_NEQ(children, NULL);
+        if (children == NULL) {
+            return NULL;
+        }
 
-    pthread_mutex_lock(&s_g_cLoggerMutex);
-    if (++s_g_logCount > MAX_LOG_COUNT) {
-        pthread_mutex_unlock(&s_g_cLoggerMutex);
-        cJSONLoggerRotate();
+        node->children = children;
+        node->childCapacity = capacity;
     }
 
-    else {
-        pthread_mutex_unlock(&s_g_cLoggerMutex);
+    child = logNodeCreate(node, nodeName);
+    if (child == NULL) {
+        return NULL;
     }
+
+    node->children[node->childCount++] = child;
+    return child;
 }
 
 /**
- * @brief Create a Json Object object
+ * @brief Grow the log columns of an uncapped node.
  *
- * @param node The node where the new child node will be inserted.
- * @param nodeName The name of the new child node.
+ * @param node The node to grow.
+ * @param capacity The number of logs the columns will hold, above the current capacity.
  *
- * @return cJSON* ptr of the next child node.
+ * @return int, 0 in case of success, negative value in case of failure.
  */
-static cJSON* createJsonObject(cJSON* node, const char* nodeName)
+static int logNodeGrow(LogNode_s* node, unsigned int capacity)
 {
-    cJSON* nextNode = NULL;
-    if (cJSON_HasObjectItem(node, nodeName) != 0) {
-        nextNode = cJSON_GetObjectItem(node, nodeName);
-        CJSON_LOGGER_ASSERT_NEQ(nextNode, NULL);
+    int64_t* timeStamps = (int64_t*)realloc(node->timeStamps, capacity * sizeof(int64_t));
+    CJSON_LOGGER_ASSERT_NEQ(timeStamps, NULL);
+    if (timeStamps != NULL) {
+        node->timeStamps = timeStamps;
     }
 
-    else {
-        nextNode = cJSON_CreateObject();
-        CJSON_LOGGER_ASSERT_NEQ(nextNode, NULL);
-        cJSON_AddItemToObject(node, nodeName, nextNode);
+    uint8_t* logLevels = (uint8_t*)realloc(node->logLevels, capacity * sizeof(uint8_t));
+    CJSON_LOGGER_ASSERT_NEQ(logLevels, NULL);
+    if (logLevels != NULL) {
+        node->logLevels = logLevels;
     }
 
-    return nextNode;
-}
+    uint32_t* callSites = (uint32_t*)realloc(node->callSites, capacity * sizeof(uint32_t));
+    CJSON_LOGGER_ASSERT_NEQ(callSites, NULL);
+    if (callSites != NULL) {
+        node->callSites = callSites;
+    }
 
-int cJSONLoggerInit(CJSON_LOG_LEVEL_E logLevel, const char* filePath)
-{
-    if (strlen(filePath) > MAX_FILE_NAME_LEN) {
-        return -1;
+    uint32_t* messages = (uint32_t*)realloc(node->messages, capacity * sizeof(uint32_t));
+    CJSON_LOGGER_ASSERT_NEQ(messages, NULL);
+    if (messages != NULL) {
+        node->messages = messages;
     }
 
-    pthread_mutex_lock(&s_g_rootNodeMutex);
-    if (s_g_rootNode == NULL) {
-        s_g_rootNode = cJSON_CreateObject();
-        CJSON_LOGGER_ASSERT_NEQ(s_g_rootNode, NULL);
+    uint16_t* messageLengths = (uint16_t*)realloc(node->messageLengths, capacity * sizeof(uint16_t));
+    CJSON_LOGGER_ASSERT_NEQ(messageLengths, NULL);
+    if (messageLengths != NULL) {
+        node->messageLengths = messageLengths;
     }
-    pthread_mutex_unlock(&s_g_rootNodeMutex);
 
-    cJSONLoggerSetLogLevel(logLevel);
+    uint16_t* escapedLengths = (uint16_t*)realloc(node->escapedLengths, capacity * sizeof(uint16_t));
+    CJSON_LOGGER_ASSERT_NEQ(escapedLengths, NULL);
+    if (escapedLengths != NULL) {
+        node->escapedLengths = escapedLengths;
+    }
 
-    pthread_mutex_lock(&s_g_cLoggerMutex);
-    if (s_g_filePath != NULL) {
-        free(s_g_filePath);
+    // The optional columns only grow once allocated by a log holding their value.
+    uint64_t* sequences = node->sequences != NULL ? (uint64_t*)realloc(node->sequences, capacity * sizeof(uint64_t)) : NULL;
+    if (sequences != NULL) {
+        node->sequences = sequences;
     }
 
-    s_g_filePath = strdup(filePath);
-    CJSON_LOGGER_ASSERT_NEQ(s_g_filePath, NULL);
+    uint32_t* threadIds = node->threadIds != NULL ? (uint32_t*)realloc(node->threadIds, capacity * sizeof(uint32_t)) : NULL;
+    if (threadIds != NULL) {
+        node->threadIds = threadIds;
+    }
 
-    pthread_mutex_unlock(&s_g_cLoggerMutex);
+    int indexRes = logIndexReserve(&node->index, capacity, 1);
 
-    int ret = atexit(cJSONLoggerDestroy);
-    CJSON_LOGGER_ASSERT_EQ(ret, 0);
+    if (timeStamps == NULL || logLevels == NULL || callSites == NULL || messages == NULL || messageLengths == NULL || escapedLengths == NULL
+        || (sequences == NULL && node->sequences != NULL) || (threadIds == NULL && node->threadIds != NULL) || indexRes != 0) {
+        return -1;
+    }
 
+    node->logCapacity = capacity;
     return 0;
 }
 
-void cJSONLoggerDestroy()
+/**
+ * @brief Make room in the log columns of a node for at least one more log.
+ *
+ * @param node The node to grow.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logNodeReserve(LogNode_s* node)
 {
-    cJSONLoggerDump();
-
-    pthread_mutex_lock(&s_g_rootNodeMutex);
-    if (s_g_rootNode != NULL) {
-        cJSON_Delete(s_g_rootNode);
+    if (node->logCount < node->logCapacity) {
+        return 0;
     }
-    s_g_rootNode = NULL;
-    pthread_mutex_unlock(&s_g_rootNodeMutex);
 
-    pthread_mutex_lock(&s_g_cLoggerMutex);
-    if (s_g_filePath != NULL) {
-        free(s_g_filePath);
-    }
-    s_g_filePath = NULL;
+    return logNodeGrow(node, node->logCapacity == 0 ? INITIAL_NODE_CAPACITY : node->logCapacity * 2);
+}
 
-    if (s_g_rotatedFilesQueue != NULL) {
-        for (int i = 0; i < s_g_rotatedFilesQueue->currentSize; i++) {
-            if (s_g_rotatedFilesQueue->rotatedFiles[i] != NULL) {
-                free(s_g_rotatedFilesQueue->rotatedFiles[i]);
-                s_g_rotatedFilesQueue->rotatedFiles[i] = NULL;
-            }
+/**
+ * @brief Add a log of a node to the query index, the block of the log and the summaries of the node and its ancestors.
+ *
+ * @note The summaries only grow, the logs replaced in a capped node may leave them wider than needed, which only costs
+ * selectivity. The block of a capped node is recomputed once all of its logs have been replaced.
+ *
+ * @param node The node holding the log.
+ * @param logIndex The position of the log in the columns of the node.
+ * @param replaced Whether the log replaced the oldest log of a capped node.
+ */
+static void logNodeIndexLog(LogNode_s* node, unsigned int logIndex, int replaced)
+{
+    int64_t timeStamp = node->timeStamps[logIndex];
+    uint8_t logLevelBit = logLevelMaskBit(node->logLevels[logIndex]);
+
+    unsigned int blockStart = logIndex - logIndex % LOG_BLOCK_LEN;
+    if (replaced != 0 && (logIndex + 1 == blockStart + LOG_BLOCK_LEN || logIndex + 1 == node->logCapacity)) {
+        for (unsigned int i = blockStart; i < logIndex; i++) {
+            logIndexAdd(&node->index, i, node->timeStamps[i], node->callSites[i], node->logLevels[i], i == blockStart);
         }
-        free(s_g_rotatedFilesQueue);
     }
 
-    s_g_rotatedFilesQueue = NULL;
-    s_g_logCount = 0;
-    s_g_logLevel = __CJSON_LOG_LEVEL_START;
+    logIndexAdd(&node->index, logIndex, timeStamp, node->callSites[logIndex], node->logLevels[logIndex], logIndex == blockStart);
+
+    for (LogNode_s* ancestor = node; ancestor != NULL; ancestor = ancestor->parent) {
+        if (ancestor->subtreeLogLevelMask == 0) {
+            ancestor->subtreeMinTimeStamp = timeStamp;
+            ancestor->subtreeMaxTimeStamp = timeStamp;
+        }
+
+        ancestor->subtreeMinTimeStamp = timeStamp < ancestor->subtreeMinTimeStamp ? timeStamp : ancestor->subtreeMinTimeStamp;
+        ancestor->subtreeMaxTimeStamp = timeStamp > ancestor->subtreeMaxTimeStamp ? timeStamp : ancestor->subtreeMaxTimeStamp;
+        ancestor->subtreeLogLevelMask |= logLevelBit;
+    }
+}
+
+/**
+ * @brief Get the position in the columns of a node of one of its logs.
+ *
+ * @param node The node.
+ * @param logIndex The index of the log, 0 for the oldest one.
+ *
+ * @return unsigned int, the position of the log in the columns.
+ */
+static inline unsigned int logNodeSlot(const LogNode_s* node, unsigned int logIndex)
+{
+    unsigned int slot = node->ringHead + logIndex;
+    return slot < node->logCapacity ? slot : slot - node->logCapacity;
+}
+
+/**
+ * @brief Get the message of a log of a node.
+ *
+ * @param store The store owning the node.
+ * @param node The node.
+ * @param slot The position of the log in the columns of the node.
+ *
+ * @return const char*, the message.
+ */
+static inline const char* logNodeMessage(const LogStore_s* store, const LogNode_s* node, unsigned int slot)
+{
+    return node->ringMessages != NULL ? node->ringMessages + (size_t)slot * MAX_LOG_MSG_LEN : store->arena + node->messages[slot];
+}
+
+/**
+ * @brief Delete a log store and all of its logs.
+ *
+ * @param store The store to delete.
+ */
+static void logStoreDelete(LogStore_s* store);
+
+/**
+ * @brief Size the string arena of a store for a number of logs and touch its pages, so the first logs neither grow nor fault it in.
+ *
+ * @param store The store to preallocate.
+ * @param preallocLogs The number of logs the arena is sized for, 0 to grow it on demand.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logStorePrealloc(LogStore_s* store, unsigned int preallocLogs)
+{
+    uint64_t capacity = (uint64_t)preallocLogs * PREALLOC_LOG_MSG_LEN;
+    capacity = capacity > UINT32_MAX ? UINT32_MAX : capacity;
+
+    if (capacity > store->arenaCapacity) {
+        char* arena = (char*)realloc(store->arena, (size_t)capacity);
+        CJSON_LOGGER_ASSERT_NEQ(arena, NULL);
+        if (arena == NULL) {
+            return -1;
+        }
+
+        store->arena = arena;
+        store->arenaCapacity = (size_t)capacity;
+    }
+
+    if (preallocLogs != 0) {
+        memset(store->arena + store->arenaSize, 0, store->arenaCapacity - store->arenaSize);
+    }
+
+    store->preallocLogs = preallocLogs;
+    return 0;
+}
+
+/**
+ * @brief Create a new empty log store.
+ *
+ * @param preallocLogs The number of logs the string arena is sized for up front, 0 to grow it on demand.
+ *
+ * @return LogStore_s* ptr of the new store, NULL in case of failure.
+ */
+static LogStore_s* logStoreCreate(unsigned int preallocLogs)
+{
+    LogStore_s* store = (LogStore_s*)calloc(1, sizeof(LogStore_s));
+    CJSON_LOGGER_ASSERT_NEQ(store, NULL);
+    if (store == NULL) {
+        return NULL;
+    }
+
+    store->root = logNodeCreate(NULL, NULL);
+    store->arena = (char*)malloc(INITIAL_ARENA_CAPACITY);
+    store->arenaCapacity = INITIAL_ARENA_CAPACITY;
+    store->callSiteTable = (uint32_t*)calloc(INITIAL_CALL_SITE_CAPACITY, sizeof(uint32_t));
+    store->callSiteTableSize = INITIAL_CALL_SITE_CAPACITY;
+    store->callSites = (CallSite_s*)malloc((INITIAL_CALL_SITE_CAPACITY / 2) * sizeof(CallSite_s));
+
+    CJSON_LOGGER_ASSERT_NEQ(store->arena, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(store->callSiteTable, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(store->callSites, NULL);
+
+    if (store->root == NULL || store->arena == NULL || store->callSiteTable == NULL || store->callSites == NULL) {
+        logNodeDelete(store->root);
+        free(store->arena);
+        free(store->callSiteTable);
+        free(store->callSites);
+        free(store);
+        return NULL;
+    }
+
+    if (logStorePrealloc(store, preallocLogs) != 0) {
+        logStoreDelete(store);
+        return NULL;
+    }
+
+    return store;
+}
+
+static void logStoreDelete(LogStore_s* store)
+{
+    if (store == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; store->callSiteNamesInArena == 0 && i < store->callSiteCount; i++) {
+        free(store->callSites[i].fileName);
+        free(store->callSites[i].funcName);
+    }
+
+    logNodeDelete(store->root);
+    free(store->ringNodes);
+    free(store->declaredNodes);
+    free(store->arena);
+    free(store->callSites);
+    free(store->callSiteTable);
+    free(store);
+}
+
+/**
+ * @brief Hash a string of a call site key into a running hash (FNV-1a), a NULL string hashes apart from an empty one.
+ *
+ * @param hash The running hash.
+ * @param str The string, NULL if not set.
+ *
+ * @return uint64_t the updated hash.
+ */
+static inline uint64_t callSiteHashString(uint64_t hash, const char* str)
+{
+    if (str == NULL) {
+        return (hash ^ 0x100) * 0x100000001B3ULL;
+    }
+
+    // The terminating NUL is hashed as well, so the file and function names can not shift into each other.
+    do {
+        hash = (hash ^ (unsigned char)*str) * 0x100000001B3ULL;
+    } while (*str++ != '\0');
+
+    return hash;
+}
+
+/**
+ * @brief Hash a call site key.
+ *
+ * @param fileName The call site file name.
+ * @param funcName The call site function name.
+ * @param fileLine The call site file line.
+ *
+ * @return uint64_t the hash of the key.
+ */
+static inline uint64_t callSiteHash(const char* fileName, const char* funcName, int fileLine)
+{
+    uint64_t hash = callSiteHashString(0xCBF29CE484222325ULL, fileName);
+    hash = callSiteHashString(hash, funcName);
+    hash ^= (uint64_t)(unsigned int)fileLine * 0xC2B2AE3D27D4EB4FULL;
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Compare a string of an interned call site with the one of a log.
+ *
+ * @param internedStr The string copied by the call site, NULL if not set.
+ * @param key The pointer the call site was interned with.
+ * @param str The string of the log, NULL if not set.
+ *
+ * @return int, 1 if the strings are equal, 0 otherwise.
+ */
+static inline int callSiteStringEqual(const char* internedStr, const char* key, const char* str)
+{
+    if (internedStr == NULL || str == NULL) {
+        return internedStr == str;
+    }
+
+    return str == key || strcmp(internedStr, str) == 0;
+}
+
+/**
+ * @brief Intern the call site of a log into the store.
+ *
+ * @note Call sites are looked up by the contents of the file and function names, the callers of cJSONLoggerLog() may pass
+ * any buffer. The pointers the call site was interned with only spare the string comparisons of the string literals of the
+ * CJSON_LOG* macros once the hashes match.
+ *
+ * @param store The store where the call site will be interned.
+ * @param record The record holding the call site.
+ * @param callSiteId Where the id of the call site will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logStoreInternCallSite(LogStore_s* store, const LogRecord_s* record, uint32_t* callSiteId)
+{
+    uint64_t hash = callSiteHash(record->fileName, record->funcName, record->fileLine);
+    uint32_t mask = store->callSiteTableSize - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+
+    while (store->callSiteTable[slot] != 0) {
+        const CallSite_s* callSite = &store->callSites[store->callSiteTable[slot] - 1];
+        if (callSite->hash == hash && callSite->fileLine == record->fileLine && callSiteStringEqual(callSite->fileName, callSite->fileKey, record->fileName)
+            && callSiteStringEqual(callSite->funcName, callSite->funcKey, record->funcName)) {
+            *callSiteId = store->callSiteTable[slot] - 1;
+            return 0;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // Keep the table at most half full, the call sites array is sized accordingly.
+    if (store->callSiteCount + 1 > store->callSiteTableSize / 2) {
+        uint32_t tableSize = store->callSiteTableSize * 2;
+        uint32_t* table = (uint32_t*)calloc(tableSize, sizeof(uint32_t));
+        CJSON_LOGGER_ASSERT_NEQ(table, NULL);
+
+        CallSite_s* callSites = (CallSite_s*)realloc(store->callSites, (tableSize / 2) * sizeof(CallSite_s));
+        CJSON_LOGGER_ASSERT_NEQ(callSites, NULL);
+        if (callSites != NULL) {
+            store->callSites = callSites;
+        }
+
+        if (table == NULL || callSites == NULL) {
+            free(table);
+            return -1;
+        }
+
+        for (uint32_t i = 0; i < store->callSiteCount; i++) {
+            uint32_t newSlot = (uint32_t)store->callSites[i].hash & (tableSize - 1);
+            while (table[newSlot] != 0) {
+                newSlot = (newSlot + 1) & (tableSize - 1);
+            }
+            table[newSlot] = i + 1;
+        }
+
+        free(store->callSiteTable);
+        store->callSiteTable = table;
+        store->callSiteTableSize = tableSize;
+
+        return logStoreInternCallSite(store, record, callSiteId);
+    }
+
+    char* fileName = record->fileName != NULL ? strdup(record->fileName) : NULL;
+    char* funcName = record->funcName != NULL ? strdup(record->funcName) : NULL;
+
+    // A call site missing one of its names would hand it to every later log of the same place, the log fails instead.
+    if ((fileName == NULL && record->fileName != NULL) || (funcName == NULL && record->funcName != NULL)) {
+        free(fileName);
+        free(funcName);
+        return -1;
+    }
+
+    CallSite_s* callSite = &store->callSites[store->callSiteCount];
+    callSite->hash = hash;
+    callSite->fileKey = record->fileName;
+    callSite->funcKey = record->funcName;
+    callSite->fileName = fileName;
+    callSite->funcName = funcName;
+    callSite->fileLine = record->fileLine;
+
+    store->callSiteTable[slot] = ++store->callSiteCount;
+    *callSiteId = store->callSiteCount - 1;
+
+    return 0;
+}
+
+/**
+ * @brief Measure a log message and its escaped copy, the message is cut to MAX_LOG_MSG_LEN - 1 characters like in the capped nodes.
+ *
+ * @param logMsg The log message.
+ * @param messageLength Where the length of the message will be stored.
+ * @param escapedLength Where the length of the message once escaped for JSON will be stored.
+ */
+static inline void logMessageMeasure(const char* logMsg, uint16_t* messageLength, uint16_t* escapedLength)
+{
+    size_t logMsgLen = strnlen(logMsg, MAX_LOG_MSG_LEN - 1);
+
+    *messageLength = (uint16_t)logMsgLen;
+    *escapedLength = (uint16_t)escapeLength(logMsg, logMsgLen);
+}
+
+/**
+ * @brief Copy a log message into the store arena, followed by its escaped copy if it needs an escape.
+ *
+ * @note The message is escaped once here, the dumps copy the escaped bytes as they are.
+ *
+ * @param store The store where the message will be copied.
+ * @param logMsg The log message.
+ * @param messageLength The length of the message, see logMessageMeasure().
+ * @param escapedLength The length of the message once escaped, see logMessageMeasure().
+ * @param offset Where the offset of the message inside the arena will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logStoreCopyMessage(LogStore_s* store, const char* logMsg, uint16_t messageLength, uint16_t escapedLength, uint32_t* offset)
+{
+    size_t entryLen = (size_t)messageLength + 1 + (escapedLength != messageLength ? (size_t)escapedLength + 1 : 0);
+
+    if (store->arenaSize + entryLen > store->arenaCapacity) {
+        size_t capacity = store->arenaCapacity * 2;
+        while (store->arenaSize + entryLen > capacity) {
+            capacity *= 2;
+        }
+
+        if (capacity > UINT32_MAX) {
+            return -1;
+        }
+
+        char* arena = (char*)realloc(store->arena, capacity);
+        CJSON_LOGGER_ASSERT_NEQ(arena, NULL);
+        if (arena == NULL) {
+            return -1;
+        }
+
+        store->arena = arena;
+        store->arenaCapacity = capacity;
+    }
+
+    char* entry = store->arena + store->arenaSize;
+    memcpy(entry, logMsg, messageLength);
+    entry[messageLength] = '\0';
+
+    if (escapedLength != messageLength) {
+        char* escaped = entry + messageLength + 1;
+        escaped = escapeCopy(escaped, logMsg, messageLength);
+        *escaped = '\0';
+    }
+
+    *offset = (uint32_t)store->arenaSize;
+    store->arenaSize += entryLen;
+
+    return 0;
+}
+
+/**
+ * @brief Copy a log message into a message slot of a capped node.
+ *
+ * @param ringMessages The messages of the capped node.
+ * @param slot The position of the log in the columns of the node.
+ * @param logMsg The log message.
+ * @param messageLength The length of the message, see logMessageMeasure().
+ */
+static inline void ringMessageCopy(char* ringMessages, unsigned int slot, const char* logMsg, uint16_t messageLength)
+{
+    char* ringMessage = ringMessages + (size_t)slot * MAX_LOG_MSG_LEN;
+
+    memcpy(ringMessage, logMsg, messageLength);
+    ringMessage[messageLength] = '\0';
+}
+
+/**
+ * @brief Cap a node of a store to its most recent logs, or lift the cap.
+ *
+ * @note The logs above the new capacity are dropped, oldest first.
+ *
+ * @param store The store owning the node.
+ * @param node The node to cap.
+ * @param ringCapacity The max number of logs kept by the node, 0 to lift the cap.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logStoreSetRingCapacity(LogStore_s* store, LogNode_s* node, unsigned int ringCapacity)
+{
+    if (ringCapacity == node->ringCapacity) {
+        return 0;
+    }
+
+    if (node->ringCapacity == 0 && store->ringNodeCount == store->ringNodeCapacity) {
+        unsigned int ringNodeCapacity = store->ringNodeCapacity == 0 ? INITIAL_NODE_CAPACITY : store->ringNodeCapacity * 2;
+        LogNode_s** ringNodes = (LogNode_s**)realloc(store->ringNodes, ringNodeCapacity * sizeof(LogNode_s*));
+        CJSON_LOGGER_ASSERT_NEQ(ringNodes, NULL);
+        if (ringNodes == NULL) {
+            return -1;
+        }
+
+        store->ringNodes = ringNodes;
+        store->ringNodeCapacity = ringNodeCapacity;
+    }
+
+    unsigned int keepCount = ringCapacity != 0 && node->logCount > ringCapacity ? ringCapacity : node->logCount;
+    unsigned int capacity = ringCapacity;
+    if (capacity == 0) {
+        capacity = INITIAL_NODE_CAPACITY;
+        while (capacity < keepCount) {
+            capacity *= 2;
+        }
+
+        capacity = capacity < node->reservedCapacity ? node->reservedCapacity : capacity;
+    }
+
+    int64_t* timeStamps = (int64_t*)malloc(capacity * sizeof(int64_t));
+    uint8_t* logLevels = (uint8_t*)malloc(capacity * sizeof(uint8_t));
+    uint32_t* callSites = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    uint32_t* messages = ringCapacity == 0 ? (uint32_t*)malloc(capacity * sizeof(uint32_t)) : NULL;
+    char* ringMessages = ringCapacity != 0 ? (char*)malloc((size_t)capacity * MAX_LOG_MSG_LEN) : NULL;
+    uint16_t* messageLengths = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+    uint16_t* escapedLengths = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+    uint64_t* sequences = node->sequences != NULL ? (uint64_t*)malloc(capacity * sizeof(uint64_t)) : NULL;
+    uint32_t* threadIds = node->threadIds != NULL ? (uint32_t*)malloc(capacity * sizeof(uint32_t)) : NULL;
+    LogIndex_s index = { 0 };
+    int indexRes = logIndexReserve(&index, capacity, ringCapacity == 0);
+
+    CJSON_LOGGER_ASSERT_NEQ(timeStamps, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(logLevels, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(callSites, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(messageLengths, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(escapedLengths, NULL);
+
+    int res = timeStamps == NULL || logLevels == NULL || callSites == NULL || (messages == NULL && ringMessages == NULL) || messageLengths == NULL || escapedLengths == NULL
+                      || (sequences == NULL && node->sequences != NULL) || (threadIds == NULL && node->threadIds != NULL) || indexRes != 0 ? -1 : 0;
+
+    unsigned int firstLog = node->logCount - keepCount;
+    for (unsigned int i = 0; res == 0 && i < keepCount; i++) {
+        unsigned int slot = logNodeSlot(node, firstLog + i);
+        timeStamps[i] = node->timeStamps[slot];
+        logLevels[i] = node->logLevels[slot];
+        callSites[i] = node->callSites[slot];
+        messageLengths[i] = node->messageLengths[slot];
+        escapedLengths[i] = node->escapedLengths[slot];
+        if (sequences != NULL) {
+            sequences[i] = node->sequences[slot];
+        }
+
+        if (threadIds != NULL) {
+            threadIds[i] = node->threadIds[slot];
+        }
+
+        if (ringMessages != NULL) {
+            ringMessageCopy(ringMessages, i, logNodeMessage(store, node, slot), messageLengths[i]);
+        }
+
+        else if (node->ringMessages == NULL) {
+            messages[i] = node->messages[slot];
+        }
+
+        else {
+            res = logStoreCopyMessage(store, logNodeMessage(store, node, slot), messageLengths[i], escapedLengths[i], &messages[i]);
+        }
+    }
+
+    if (res != 0) {
+        free(timeStamps);
+        free(logLevels);
+        free(callSites);
+        free(messages);
+        free(messageLengths);
+        free(escapedLengths);
+        free(sequences);
+        free(threadIds);
+        free(ringMessages);
+        logIndexFree(&index);
+        return -1;
+    }
+
+    free(node->timeStamps);
+    free(node->logLevels);
+    free(node->callSites);
+    free(node->messages);
+    free(node->messageLengths);
+    free(node->escapedLengths);
+    free(node->sequences);
+    free(node->threadIds);
+    free(node->ringMessages);
+    logIndexFree(&node->index);
+
+    node->timeStamps = timeStamps;
+    node->logLevels = logLevels;
+    node->callSites = callSites;
+    node->messages = messages;
+    node->messageLengths = messageLengths;
+    node->escapedLengths = escapedLengths;
+    node->sequences = sequences;
+    node->threadIds = threadIds;
+    node->ringMessages = ringMessages;
+    node->index = index;
+    node->logCapacity = capacity;
+    store->logCount -= node->logCount - keepCount;
+    node->logCount = keepCount;
+    node->ringHead = 0;
+
+    for (unsigned int i = 0; i < keepCount; i++) {
+        logNodeIndexLog(node, i, 0);
+    }
+
+    if (node->ringCapacity == 0) {
+        store->ringNodes[store->ringNodeCount++] = node;
+    }
+
+    else if (ringCapacity == 0) {
+        for (unsigned int i = 0; i < store->ringNodeCount; i++) {
+            if (store->ringNodes[i] == node) {
+                store->ringNodes[i] = store->ringNodes[--store->ringNodeCount];
+                break;
+            }
+        }
+    }
+
+    node->ringCapacity = ringCapacity;
+    s_g_logGeneration++;
+    return 0;
+}
+
+/**
+ * @brief Declare a node of a store, its log columns are allocated and touched up front and it is kept by the rotations.
+ *
+ * @note The columns of a capped node are already allocated for its capacity, only the declaration is recorded.
+ *
+ * @param store The store owning the node.
+ * @param node The node to declare.
+ * @param logCapacity The number of logs the columns are allocated for.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logStoreDeclareNode(LogStore_s* store, LogNode_s* node, unsigned int logCapacity)
+{
+    unsigned int declared = 0;
+    while (declared < store->declaredNodeCount && store->declaredNodes[declared] != node) {
+        declared++;
+    }
+
+    if (declared == store->declaredNodeCount) {
+        if (store->declaredNodeCount == store->declaredNodeCapacity) {
+            unsigned int declaredNodeCapacity = store->declaredNodeCapacity == 0 ? INITIAL_NODE_CAPACITY : store->declaredNodeCapacity * 2;
+            LogNode_s** declaredNodes = (LogNode_s**)realloc(store->declaredNodes, declaredNodeCapacity * sizeof(LogNode_s*));
+            CJSON_LOGGER_ASSERT_NEQ(declaredNodes, NULL);
+            if (declaredNodes == NULL) {
+                return -1;
+            }
+
+            store->declaredNodes = declaredNodes;
+            store->declaredNodeCapacity = declaredNodeCapacity;
+        }
+
+        store->declaredNodes[store->declaredNodeCount++] = node;
+    }
+
+    node->reservedCapacity = logCapacity;
+    s_g_logGeneration++;
+    if (node->ringCapacity != 0 || logCapacity <= node->logCapacity) {
+        return 0;
+    }
+
+    if (logNodeGrow(node, logCapacity) != 0) {
+        return -1;
+    }
+
+    unsigned int blockCount = (logCapacity + LOG_BLOCK_LEN - 1) / LOG_BLOCK_LEN;
+    unsigned int usedBlockCount = (node->logCount + LOG_BLOCK_LEN - 1) / LOG_BLOCK_LEN;
+    unsigned int freeCount = logCapacity - node->logCount;
+    memset(node->timeStamps + node->logCount, 0, freeCount * sizeof(int64_t));
+    memset(node->logLevels + node->logCount, 0, freeCount * sizeof(uint8_t));
+    memset(node->callSites + node->logCount, 0, freeCount * sizeof(uint32_t));
+    memset(node->messages + node->logCount, 0, freeCount * sizeof(uint32_t));
+    memset(node->messageLengths + node->logCount, 0, freeCount * sizeof(uint16_t));
+    memset(node->escapedLengths + node->logCount, 0, freeCount * sizeof(uint16_t));
+    if (node->sequences != NULL) {
+        memset(node->sequences + node->logCount, 0, freeCount * sizeof(uint64_t));
+    }
+
+    if (node->threadIds != NULL) {
+        memset(node->threadIds + node->logCount, 0, freeCount * sizeof(uint32_t));
+    }
+    memset(node->index.blocks + usedBlockCount, 0, (blockCount - usedBlockCount) * sizeof(LogBlock_s));
+
+    return 0;
+}
+
+/**
+ * @brief Get the node of a store at the same path as a node of another store, creating it if it does not exist.
+ *
+ * @param store The store where the node will be searched or inserted.
+ * @param srcNode The node of the other store.
+ *
+ * @return LogNode_s* ptr of the node, NULL in case of failure.
+ */
+static LogNode_s* logStoreGetMirrorNode(LogStore_s* store, const LogNode_s* srcNode)
+{
+    const char* jsonPath[MAX_JSON_PATH_DEPTH] = { 0 };
+
+    size_t jsonPathDepth = 0;
+    for (const LogNode_s* node = srcNode; node->parent != NULL && jsonPathDepth < MAX_JSON_PATH_DEPTH; node = node->parent) {
+        jsonPath[jsonPathDepth++] = node->name;
+    }
+
+    LogNode_s* node = store->root;
+    for (size_t i = jsonPathDepth; i > 0 && node != NULL; i--) {
+        node = logNodeGetChild(node, jsonPath[i - 1]);
+    }
+
+    return node;
+}
+
+/**
+ * @brief Cap and declare the nodes of a store the same way as the nodes of another store, the missing nodes are created empty.
+ *
+ * @param store The store whose nodes will be capped and declared.
+ * @param src The store whose capped and declared nodes will be copied.
+ */
+static void logStoreCopyNodeLayout(LogStore_s* store, const LogStore_s* src)
+{
+    for (unsigned int i = 0; i < src->ringNodeCount; i++) {
+        LogNode_s* node = logStoreGetMirrorNode(store, src->ringNodes[i]);
+        if (node != NULL) {
+            int res = logStoreSetRingCapacity(store, node, src->ringNodes[i]->ringCapacity);
+            CJSON_LOGGER_ASSERT_EQ(res, 0);
+        }
+    }
+
+    for (unsigned int i = 0; i < src->declaredNodeCount; i++) {
+        LogNode_s* node = logStoreGetMirrorNode(store, src->declaredNodes[i]);
+        if (node != NULL) {
+            int res = logStoreDeclareNode(store, node, src->declaredNodes[i]->reservedCapacity);
+            CJSON_LOGGER_ASSERT_EQ(res, 0);
+        }
+    }
+}
+
+/**
+ * @brief Copy a log node and its children for printing, the logs are copied oldest first.
+ *
+ * @note Only what the print reads is copied, the copy has no query index.
+ *
+ * @param store The store owning the node.
+ * @param src The node to copy.
+ * @param parent The parent of the copy, NULL for the root node.
+ *
+ * @return LogNode_s* ptr of the copy, NULL in case of failure.
+ */
+static LogNode_s* logNodeSnapshot(const LogStore_s* store, const LogNode_s* src, LogNode_s* parent)
+{
+    LogNode_s* node = logNodeCreate(parent, src->name);
+    if (node == NULL || (src->name != NULL && node->name == NULL)) {
+        logNodeDelete(node);
+        return NULL;
+    }
+
+    node->logsIndex = src->logsIndex;
+
+    if (src->childCount != 0) {
+        node->children = (LogNode_s**)malloc(src->childCount * sizeof(LogNode_s*));
+        CJSON_LOGGER_ASSERT_NEQ(node->children, NULL);
+        if (node->children == NULL) {
+            logNodeDelete(node);
+            return NULL;
+        }
+
+        node->childCapacity = src->childCount;
+        for (unsigned int i = 0; i < src->childCount; i++) {
+            LogNode_s* child = logNodeSnapshot(store, src->children[i], node);
+            if (child == NULL) {
+                logNodeDelete(node);
+                return NULL;
+            }
+
+            node->children[node->childCount++] = child;
+        }
+    }
+
+    if (src->logCount == 0) {
+        return node;
+    }
+
+    unsigned int capacity = src->logCount;
+    node->timeStamps = (int64_t*)malloc(capacity * sizeof(int64_t));
+    node->logLevels = (uint8_t*)malloc(capacity * sizeof(uint8_t));
+    node->callSites = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    node->messages = src->ringMessages == NULL ? (uint32_t*)malloc(capacity * sizeof(uint32_t)) : NULL;
+    node->ringMessages = src->ringMessages != NULL ? (char*)malloc((size_t)capacity * MAX_LOG_MSG_LEN) : NULL;
+    node->messageLengths = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+    node->escapedLengths = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+    node->sequences = src->sequences != NULL ? (uint64_t*)malloc(capacity * sizeof(uint64_t)) : NULL;
+    node->threadIds = src->threadIds != NULL ? (uint32_t*)malloc(capacity * sizeof(uint32_t)) : NULL;
+
+    CJSON_LOGGER_ASSERT_NEQ(node->timeStamps, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(node->logLevels, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(node->callSites, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(node->messageLengths, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(node->escapedLengths, NULL);
+
+    if (node->timeStamps == NULL || node->logLevels == NULL || node->callSites == NULL || (node->messages == NULL && node->ringMessages == NULL) || node->messageLengths == NULL
+        || node->escapedLengths == NULL || (node->sequences == NULL && src->sequences != NULL) || (node->threadIds == NULL && src->threadIds != NULL)) {
+        logNodeDelete(node);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i < src->logCount; i++) {
+        unsigned int slot = logNodeSlot(src, i);
+        node->timeStamps[i] = src->timeStamps[slot];
+        node->logLevels[i] = src->logLevels[slot];
+        node->callSites[i] = src->callSites[slot];
+        node->messageLengths[i] = src->messageLengths[slot];
+        node->escapedLengths[i] = src->escapedLengths[slot];
+        if (node->sequences != NULL) {
+            node->sequences[i] = src->sequences[slot];
+        }
+
+        if (node->threadIds != NULL) {
+            node->threadIds[i] = src->threadIds[slot];
+        }
+
+        if (node->ringMessages != NULL) {
+            ringMessageCopy(node->ringMessages, i, logNodeMessage(store, src, slot), node->messageLengths[i]);
+        }
+
+        else {
+            node->messages[i] = src->messages[slot];
+        }
+    }
+
+    node->logCount = src->logCount;
+    node->logCapacity = capacity;
+    return node;
+}
+
+/**
+ * @brief Copy an optional call site name behind the arena of a store copy.
+ *
+ * @param names Where the next name is copied, advanced past the copy.
+ * @param name The name to copy, NULL if not set.
+ *
+ * @return char* ptr of the copy, NULL if the name is not set.
+ */
+static char* logStoreSnapshotName(char** names, const char* name)
+{
+    if (name == NULL) {
+        return NULL;
+    }
+
+    size_t nameLen = strlen(name) + 1;
+    char* copy = *names;
+    memcpy(copy, name, nameLen);
+    *names += nameLen;
+    return copy;
+}
+
+/**
+ * @brief Copy a log store for printing, so the store only stays locked for the copy and not for the print.
+ *
+ * @note The copy is only meant to be printed and deleted, it can not take logs. It holds the used part of the arena and
+ * of the columns, about the memory of the logs themselves, the call site names are stored behind its arena.
+ *
+ * @param src The store to copy.
+ *
+ * @return LogStore_s* ptr of the copy, NULL in case of failure.
+ */
+static LogStore_s* logStoreSnapshot(const LogStore_s* src)
+{
+    LogStore_s* store = (LogStore_s*)calloc(1, sizeof(LogStore_s));
+    CJSON_LOGGER_ASSERT_NEQ(store, NULL);
+    if (store == NULL) {
+        return NULL;
+    }
+
+    size_t namesSize = 0;
+    for (uint32_t i = 0; i < src->callSiteCount; i++) {
+        namesSize += src->callSites[i].fileName != NULL ? strlen(src->callSites[i].fileName) + 1 : 0;
+        namesSize += src->callSites[i].funcName != NULL ? strlen(src->callSites[i].funcName) + 1 : 0;
+    }
+
+    store->callSiteNamesInArena = 1;
+    store->arena = (char*)malloc(src->arenaSize + namesSize != 0 ? src->arenaSize + namesSize : 1);
+    store->callSites = (CallSite_s*)malloc((src->callSiteCount != 0 ? src->callSiteCount : 1) * sizeof(CallSite_s));
+
+    CJSON_LOGGER_ASSERT_NEQ(store->arena, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(store->callSites, NULL);
+
+    if (store->arena == NULL || store->callSites == NULL) {
+        logStoreDelete(store);
+        return NULL;
+    }
+
+    memcpy(store->arena, src->arena, src->arenaSize);
+    store->arenaSize = src->arenaSize;
+    store->arenaCapacity = src->arenaSize + namesSize;
+
+    char* names = store->arena + src->arenaSize;
+    for (uint32_t i = 0; i < src->callSiteCount; i++) {
+        const CallSite_s* srcCallSite = &src->callSites[i];
+        CallSite_s* callSite = &store->callSites[store->callSiteCount++];
+
+        *callSite = *srcCallSite;
+        callSite->fileKey = NULL;
+        callSite->funcKey = NULL;
+        callSite->fileName = logStoreSnapshotName(&names, srcCallSite->fileName);
+        callSite->funcName = logStoreSnapshotName(&names, srcCallSite->funcName);
+    }
+
+    store->root = logNodeSnapshot(src, src->root, NULL);
+    if (store->root == NULL) {
+        logStoreDelete(store);
+        return NULL;
+    }
+
+    store->logCount = src->logCount;
+    store->baseGeneration = src->baseGeneration;
+    return store;
+}
+
+/**
+ * @brief Print the logs of a node as a JSON array.
+ *
+ * @param store The store owning the node.
+ * @param node The node whose logs will be printed.
+ * @param depth The depth of the array.
+ * @param printBuffer The print buffer to print into.
+ */
+static void logNodePrintLogs(const LogStore_s* store, const LogNode_s* node, size_t depth, PrintBuffer_s* printBuffer)
+{
+    char timeStr[MAX_TIME_STR_LEN] = { 0 };
+
+    printBufferAppend(printBuffer, "[", 1);
+    for (unsigned int i = 0; i < node->logCount; i++) {
+        unsigned int slot = logNodeSlot(node, i);
+        const CallSite_s* callSite = &store->callSites[node->callSites[slot]];
+
+        printBufferAppend(printBuffer, "{\n", 2);
+
+        // The time stamp holds nothing to escape.
+        size_t timeStrLen = formatTimeStamp(node->timeStamps[slot], timeStr, sizeof(timeStr));
+        printBufferKey(printBuffer, depth + 1, "Time");
+        printBufferEscapedString(printBuffer, timeStr, timeStrLen);
+        printBufferAppend(printBuffer, ",\n", 2);
+
+        printBufferKey(printBuffer, depth + 1, "LogLevel");
+        printBufferString(printBuffer, cJSONLoggerGetLogLevelStr((CJSON_LOG_LEVEL_E)node->logLevels[slot]));
+        printBufferAppend(printBuffer, ",\n", 2);
+
+        if (node->sequences != NULL && node->sequences[slot] != 0) {
+            printBufferKey(printBuffer, depth + 1, "Sequence");
+            printBufferUInt(printBuffer, node->sequences[slot]);
+            printBufferAppend(printBuffer, ",\n", 2);
+        }
+
+        if (node->threadIds != NULL && node->threadIds[slot] != 0) {
+            printBufferKey(printBuffer, depth + 1, "ThreadId");
+            printBufferUInt(printBuffer, node->threadIds[slot]);
+            printBufferAppend(printBuffer, ",\n", 2);
+        }
+
+        if (callSite->fileName != NULL) {
+            printBufferKey(printBuffer, depth + 1, "FileName");
+            printBufferString(printBuffer, callSite->fileName);
+            printBufferAppend(printBuffer, ",\n", 2);
+        }
+
+        if (callSite->funcName != NULL) {
+            printBufferKey(printBuffer, depth + 1, "FuncName");
+            printBufferString(printBuffer, callSite->funcName);
+            printBufferAppend(printBuffer, ",\n", 2);
+        }
+
+        if (callSite->fileLine != 0) {
+            printBufferKey(printBuffer, depth + 1, "FileLine");
+            printBufferInt(printBuffer, callSite->fileLine);
+            printBufferAppend(printBuffer, ",\n", 2);
+        }
+
+        // The messages were escaped when stored, only the escaped messages of the capped nodes are escaped again.
+        const char* logMsg = logNodeMessage(store, node, slot);
+        printBufferKey(printBuffer, depth + 1, "Log");
+        if (node->escapedLengths[slot] == node->messageLengths[slot]) {
+            printBufferEscapedString(printBuffer, logMsg, node->messageLengths[slot]);
+        }
+
+        else if (node->ringMessages == NULL) {
+            printBufferEscapedString(printBuffer, logMsg + node->messageLengths[slot] + 1, node->escapedLengths[slot]);
+        }
+
+        else {
+            printBufferString(printBuffer, logMsg);
+        }
+        printBufferAppend(printBuffer, "\n", 1);
+
+        printBufferIndent(printBuffer, depth);
+        printBufferAppend(printBuffer, i + 1 < node->logCount ? "}, " : "}", i + 1 < node->logCount ? 3 : 1);
+    }
+    printBufferAppend(printBuffer, "]", 1);
+}
+
+/**
+ * @brief Print one entry (the logs array or a child node) of a log node object.
+ *
+ * @param store The store owning the node.
+ * @param node The node the entry belongs to.
+ * @param entry The index of the child node, LOGS_ENTRY for the logs array.
+ * @param depth The depth of the node object.
+ * @param isLast Whether the entry is the last one of the node object.
+ * @param printBuffer The print buffer to print into.
+ */
+static void logNodePrintEntry(const LogStore_s* store, const LogNode_s* node, unsigned int entry, size_t depth, int isLast, PrintBuffer_s* printBuffer);
+
+/**
+ * @brief Print a log node and its children as a JSON object, the output is byte identical to cJSON_Print().
+ *
+ * @param store The store owning the node.
+ * @param node The node to print.
+ * @param depth The depth of the object, 1 for the root node.
+ * @param printBuffer The print buffer to print into.
+ */
+static void logNodePrint(const LogStore_s* store, const LogNode_s* node, size_t depth, PrintBuffer_s* printBuffer)
+{
+    unsigned int entryCount = node->childCount + (node->logCount > 0 ? 1 : 0);
+    unsigned int entry = 0;
+
+    printBufferAppend(printBuffer, "{\n", 2);
+    for (unsigned int i = 0; i <= node->childCount; i++) {
+        if (node->logCount > 0 && node->logsIndex == i) {
+            logNodePrintEntry(store, node, LOGS_ENTRY, depth, ++entry == entryCount, printBuffer);
+        }
+
+        if (i < node->childCount) {
+            logNodePrintEntry(store, node, i, depth, ++entry == entryCount, printBuffer);
+        }
+    }
+    printBufferIndent(printBuffer, depth - 1);
+    printBufferAppend(printBuffer, "}", 1);
+}
+
+static void logNodePrintEntry(const LogStore_s* store, const LogNode_s* node, unsigned int entry, size_t depth, int isLast, PrintBuffer_s* printBuffer)
+{
+    if (entry == LOGS_ENTRY) {
+        printBufferKey(printBuffer, depth, "logs");
+        logNodePrintLogs(store, node, depth + 1, printBuffer);
+    }
+
+    else {
+        printBufferKey(printBuffer, depth, node->children[entry]->name);
+        logNodePrint(store, node->children[entry], depth + 1, printBuffer);
+    }
+
+    printBufferAppend(printBuffer, isLast ? "\n" : ",\n", isLast ? 1 : 2);
+}
+
+/**
+ * @def NO_QUERY_STRING
+ *
+ * @brief Offset of a string not set (NULL) among the strings copied by a query.
+ */
+#define NO_QUERY_STRING SIZE_MAX
+
+/**
+ * @struct LogQueryCallSite
+ *
+ * @brief A call site copied out of the log store by a query.
+ *
+ * @var fileName Offset of the file name among the strings of the query, NO_QUERY_STRING if not set.
+ * @var funcName Offset of the function name among the strings of the query, NO_QUERY_STRING if not set.
+ * @var fileLine The file line, 0 if not set.
+ */
+typedef struct LogQueryCallSite {
+    size_t fileName;
+    size_t funcName;
+    int fileLine;
+} LogQueryCallSite_s;
+
+/**
+ * @struct LogQueryRecord
+ *
+ * @brief A matching record copied out of the log store by a query.
+ *
+ * @var pathIndex Position of the names of the JSON nodes of the record in the pathNames of the query.
+ * @var jsonPathDepth The number of names of the JSON nodes of the record.
+ * @var timeStamp The time stamp of the record.
+ * @var logLevel The log level of the record.
+ * @var callSite Position of the call site of the record in the callSites of the query.
+ * @var logMsg Offset of the log message among the strings of the query.
+ * @var sequence The sequence number of the record.
+ * @var threadId The id of the logging thread.
+ */
+typedef struct LogQueryRecord {
+    size_t pathIndex;
+    size_t jsonPathDepth;
+    int64_t timeStamp;
+    uint8_t logLevel;
+    uint32_t callSite;
+    size_t logMsg;
+    uint64_t sequence;
+    uint32_t threadId;
+} LogQueryRecord_s;
+
+/**
+ * @struct LogQuery
+ *
+ * @brief State of a query over the log store.
+ *
+ * @note The matching records are copied while the store is locked and handed to the callback once it is unlocked,
+ * so the callback can call the cJSON logger API.
+ *
+ * @var store The store being queried.
+ * @var logLevelMask Bit (log level) set for every matching log level.
+ * @var fromTimeStamp The oldest matching time stamp.
+ * @var toTimeStamp The newest matching time stamp.
+ * @var callSiteMatches Per call site id, whether the call site matches, NULL if every call site matches.
+ * @var callSiteMask Bit (call site id % 64) set for every matching call site.
+ * @var maxRecords Max number of matching records.
+ * @var matchCount Number of matching records so far.
+ * @var failed Whether a copy failed, the query stops at the failure.
+ * @var jsonPath The names of the JSON nodes leading to the visited node.
+ * @var pathIndex Position of the copied names of the visited node in pathNames, NO_QUERY_STRING until its first matching record.
+ * @var strings The copied strings, NUL terminated.
+ * @var stringsSize Used bytes of the strings.
+ * @var stringsCapacity Allocated bytes of the strings.
+ * @var pathNames Offsets of the copied names of the JSON nodes holding matching records.
+ * @var pathNameCount Number of copied names.
+ * @var pathNameCapacity Allocated size of the pathNames.
+ * @var callSiteCopies Per call site id of the store, position + 1 of the copied call site in callSites, 0 if not copied.
+ * @var callSites The copied call sites, each one shared by its records.
+ * @var callSiteCount Number of copied call sites.
+ * @var records The copied matching records.
+ * @var recordCount Number of copied records.
+ * @var recordCapacity Allocated size of the records.
+ * @var batch The batch of records handed to the callback.
+ */
+typedef struct LogQuery {
+    const LogStore_s* store;
+    uint8_t logLevelMask;
+    int64_t fromTimeStamp;
+    int64_t toTimeStamp;
+    const uint8_t* callSiteMatches;
+    uint64_t callSiteMask;
+    size_t maxRecords;
+    size_t matchCount;
+    int failed;
+    const char* jsonPath[MAX_JSON_PATH_DEPTH];
+    size_t pathIndex;
+    char* strings;
+    size_t stringsSize;
+    size_t stringsCapacity;
+    size_t* pathNames;
+    size_t pathNameCount;
+    size_t pathNameCapacity;
+    uint32_t* callSiteCopies;
+    LogQueryCallSite_s* callSites;
+    uint32_t callSiteCount;
+    LogQueryRecord_s* records;
+    size_t recordCount;
+    size_t recordCapacity;
+    CJSONLoggerRecord_s batch[MAX_QUERY_BATCH_RECORDS];
+} LogQuery_s;
+
+/**
+ * @brief Create the state of a query over a store.
+ *
+ * @note The store must be locked, its call sites are counted.
+ *
+ * @param store The store to query, NULL if there is none.
+ *
+ * @return LogQuery_s* ptr of the new query, NULL in case of failure.
+ */
+static LogQuery_s* logQueryCreate(const LogStore_s* store)
+{
+    LogQuery_s* query = (LogQuery_s*)calloc(1, sizeof(LogQuery_s));
+    CJSON_LOGGER_ASSERT_NEQ(query, NULL);
+    if (query == NULL) {
+        return NULL;
+    }
+
+    uint32_t callSiteCount = store != NULL ? store->callSiteCount : 0;
+    query->callSiteCopies = (uint32_t*)calloc(callSiteCount + 1, sizeof(uint32_t));
+    query->callSites = (LogQueryCallSite_s*)malloc((callSiteCount + 1) * sizeof(LogQueryCallSite_s));
+    CJSON_LOGGER_ASSERT_NEQ(query->callSiteCopies, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(query->callSites, NULL);
+    if (query->callSiteCopies == NULL || query->callSites == NULL) {
+        free(query->callSiteCopies);
+        free(query->callSites);
+        free(query);
+        return NULL;
+    }
+
+    query->store = store;
+    query->pathIndex = NO_QUERY_STRING;
+
+    return query;
+}
+
+/**
+ * @brief Delete the state of a query and its copied records.
+ *
+ * @param query The query.
+ */
+static void logQueryDelete(LogQuery_s* query)
+{
+    free(query->strings);
+    free(query->pathNames);
+    free(query->callSiteCopies);
+    free(query->callSites);
+    free(query->records);
+    free(query);
+}
+
+/**
+ * @brief Grow an array of a query, doubling its capacity until it holds a number of items.
+ *
+ * @param array The array, NULL if not allocated yet.
+ * @param capacity The allocated number of items of the array, updated once grown.
+ * @param count The number of items the array must hold.
+ * @param itemSize The size in bytes of an item.
+ *
+ * @return void* ptr of the grown array, NULL in case of failure (the array is kept).
+ */
+static void* logQueryGrow(void* array, size_t* capacity, size_t count, size_t itemSize)
+{
+    if (array != NULL && count <= *capacity) {
+        return array;
+    }
+
+    size_t newCapacity = *capacity != 0 ? *capacity : MAX_QUERY_BATCH_RECORDS;
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+
+    void* newArray = realloc(array, newCapacity * itemSize);
+    CJSON_LOGGER_ASSERT_NEQ(newArray, NULL);
+    if (newArray != NULL) {
+        *capacity = newCapacity;
+    }
+
+    return newArray;
+}
+
+/**
+ * @brief Copy a string into the strings of a query.
+ *
+ * @param query The query.
+ * @param str The string to copy, NULL if not set.
+ * @param length The number of characters of the string.
+ *
+ * @return size_t, the offset of the copy, NO_QUERY_STRING if the string is not set or can not be copied (the query is then failed).
+ */
+static size_t logQueryCopyString(LogQuery_s* query, const char* str, size_t length)
+{
+    if (str == NULL) {
+        return NO_QUERY_STRING;
+    }
+
+    char* strings = (char*)logQueryGrow(query->strings, &query->stringsCapacity, query->stringsSize + length + 1, sizeof(char));
+    if (strings == NULL) {
+        query->failed = 1;
+        return NO_QUERY_STRING;
+    }
+    query->strings = strings;
+
+    size_t offset = query->stringsSize;
+    memcpy(strings + offset, str, length);
+    strings[offset + length] = '\0';
+    query->stringsSize += length + 1;
+
+    return offset;
+}
+
+/**
+ * @brief Copy a log of a node to the matching records of a query.
+ *
+ * @param query The query.
+ * @param node The node holding the log.
+ * @param depth The depth of the node, the names of the nodes leading to it are in the jsonPath of the query.
+ * @param slot The position of the log in the columns of the node.
+ */
+static void logQueryAppend(LogQuery_s* query, const LogNode_s* node, size_t depth, unsigned int slot)
+{
+    // The names of the nodes leading to the node are copied with its first matching record, the records of the node share them.
+    if (query->pathIndex == NO_QUERY_STRING) {
+        size_t* pathNames = (size_t*)logQueryGrow(query->pathNames, &query->pathNameCapacity, query->pathNameCount + depth, sizeof(size_t));
+        if (pathNames == NULL) {
+            query->failed = 1;
+            return;
+        }
+        query->pathNames = pathNames;
+
+        for (size_t i = 0; i < depth; i++) {
+            pathNames[query->pathNameCount + i] = logQueryCopyString(query, query->jsonPath[i], strlen(query->jsonPath[i]));
+        }
+        query->pathIndex = query->pathNameCount;
+        query->pathNameCount += depth;
+    }
+
+    // A call site is copied once, its records share its strings.
+    uint32_t callSiteId = node->callSites[slot];
+    if (query->callSiteCopies[callSiteId] == 0) {
+        const CallSite_s* callSite = &query->store->callSites[callSiteId];
+        LogQueryCallSite_s* callSiteCopy = &query->callSites[query->callSiteCount];
+
+        callSiteCopy->fileName = logQueryCopyString(query, callSite->fileName, callSite->fileName != NULL ? strlen(callSite->fileName) : 0);
+        callSiteCopy->funcName = logQueryCopyString(query, callSite->funcName, callSite->funcName != NULL ? strlen(callSite->funcName) : 0);
+        callSiteCopy->fileLine = callSite->fileLine;
+        query->callSiteCopies[callSiteId] = ++query->callSiteCount;
+    }
+
+    LogQueryRecord_s* records = (LogQueryRecord_s*)logQueryGrow(query->records, &query->recordCapacity, query->recordCount + 1, sizeof(LogQueryRecord_s));
+    if (records == NULL) {
+        query->failed = 1;
+        return;
+    }
+    query->records = records;
+
+    LogQueryRecord_s* record = &records[query->recordCount++];
+    record->pathIndex = query->pathIndex;
+    record->jsonPathDepth = depth;
+    record->timeStamp = node->timeStamps[slot];
+    record->logLevel = node->logLevels[slot];
+    record->callSite = query->callSiteCopies[callSiteId] - 1;
+    record->logMsg = logQueryCopyString(query, logNodeMessage(query->store, node, slot), node->messageLengths[slot]);
+    record->sequence = node->sequences != NULL ? node->sequences[slot] : 0;
+    record->threadId = node->threadIds != NULL ? node->threadIds[slot] : 0;
+    query->matchCount++;
+
+    // A failed copy stops the query.
+    if (query->failed != 0) {
+        query->maxRecords = query->matchCount;
+    }
+}
+
+/**
+ * @brief Hand the copied records of a query to a callback in batches, the records of a batch share their jsonPath.
+ *
+ * @note The store does not need to be locked, the records only point to the copies of the query.
+ *
+ * @param query The query.
+ * @param callback The callback receiving the records.
+ * @param userData The user data passed to the callback.
+ */
+static void logQueryDeliver(LogQuery_s* query, CJSONLoggerRecordCallback callback, void* userData)
+{
+    const char* jsonPath[MAX_JSON_PATH_DEPTH];
+    size_t batchCount = 0;
+
+    for (size_t i = 0; i < query->recordCount; i++) {
+        const LogQueryRecord_s* record = &query->records[i];
+        if (batchCount != 0
+            && (batchCount == MAX_QUERY_BATCH_RECORDS || record->pathIndex != record[-1].pathIndex || record->jsonPathDepth != record[-1].jsonPathDepth)) {
+            callback(query->batch, batchCount, userData);
+            batchCount = 0;
+        }
+
+        if (batchCount == 0) {
+            for (size_t j = 0; j < record->jsonPathDepth; j++) {
+                jsonPath[j] = query->strings + query->pathNames[record->pathIndex + j];
+            }
+        }
+
+        const LogQueryCallSite_s* callSite = &query->callSites[record->callSite];
+        CJSONLoggerRecord_s* batchRecord = &query->batch[batchCount++];
+
+        batchRecord->jsonPath = jsonPath;
+        batchRecord->jsonPathDepth = record->jsonPathDepth;
+        batchRecord->timeStamp = record->timeStamp;
+        batchRecord->logLevel = (CJSON_LOG_LEVEL_E)record->logLevel;
+        batchRecord->fileName = callSite->fileName != NO_QUERY_STRING ? query->strings + callSite->fileName : NULL;
+        batchRecord->funcName = callSite->funcName != NO_QUERY_STRING ? query->strings + callSite->funcName : NULL;
+        batchRecord->fileLine = callSite->fileLine;
+        batchRecord->logMsg = query->strings + record->logMsg;
+        batchRecord->sequence = record->sequence;
+        batchRecord->threadId = record->threadId;
+    }
+
+    if (batchCount != 0) {
+        callback(query->batch, batchCount, userData);
+    }
+}
+
+/**
+ * @brief Run a query over a range of the columns of a log node, skipping the blocks the index rules out.
+ *
+ * @param query The query.
+ * @param node The node to visit.
+ * @param depth The depth of the node, the names of the nodes leading to it are in the jsonPath of the query.
+ * @param fromSlot The first position of the range.
+ * @param toSlot The position past the end of the range.
+ */
+static void logNodeQuerySlots(LogQuery_s* query, const LogNode_s* node, size_t depth, unsigned int fromSlot, unsigned int toSlot)
+{
+    unsigned int slot = fromSlot;
+    while (slot < toSlot && query->matchCount < query->maxRecords) {
+        const LogBlock_s* block = &node->index.blocks[slot / LOG_BLOCK_LEN];
+        unsigned int blockEnd = slot - slot % LOG_BLOCK_LEN + LOG_BLOCK_LEN;
+        blockEnd = blockEnd < toSlot ? blockEnd : toSlot;
+
+        if ((block->logLevelMask & query->logLevelMask) == 0
+            || (block->callSiteMask & query->callSiteMask) == 0
+            || block->maxTimeStamp < query->fromTimeStamp
+            || block->minTimeStamp > query->toTimeStamp) {
+            slot = blockEnd;
+            continue;
+        }
+
+        for (; slot < blockEnd && query->matchCount < query->maxRecords; slot++) {
+            if ((logLevelMaskBit(node->logLevels[slot]) & query->logLevelMask) != 0
+                && node->timeStamps[slot] >= query->fromTimeStamp
+                && node->timeStamps[slot] <= query->toTimeStamp
+                && (query->callSiteMatches == NULL || query->callSiteMatches[node->callSites[slot]] != 0)) {
+                logQueryAppend(query, node, depth, slot);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Run a query over a log node and its descendants, skipping the subtrees and blocks the index rules out.
+ *
+ * @param query The query.
+ * @param node The node to visit.
+ * @param depth The depth of the node, the names of the nodes leading to it are in the jsonPath of the query.
+ */
+static void logNodeQuery(LogQuery_s* query, const LogNode_s* node, size_t depth)
+{
+    if (query->matchCount >= query->maxRecords
+        || (node->subtreeLogLevelMask & query->logLevelMask) == 0
+        || node->subtreeMaxTimeStamp < query->fromTimeStamp
+        || node->subtreeMinTimeStamp > query->toTimeStamp) {
+        return;
+    }
+
+    // The names of the node are copied with its first matching record.
+    query->pathIndex = NO_QUERY_STRING;
+
+    // The logs of an uncapped node are only appended, its index walks the blocks of the query time range and log levels.
+    if (node->index.levelBlocks != NULL) {
+        LogIndexCursor_s cursor;
+        logIndexCursorInit(&cursor, &node->index, (node->logCount + LOG_BLOCK_LEN - 1) / LOG_BLOCK_LEN, query->logLevelMask, query->fromTimeStamp);
+
+        unsigned int block;
+        while (query->matchCount < query->maxRecords && logIndexCursorNext(&cursor, &block) != 0) {
+            unsigned int blockEnd = (block + 1) * LOG_BLOCK_LEN;
+            logNodeQuerySlots(query, node, depth, block * LOG_BLOCK_LEN, blockEnd < node->logCount ? blockEnd : node->logCount);
+        }
+    }
+
+    else {
+        // The logs of a capped node wrap around the end of the columns, oldest first.
+        unsigned int wrapCount = node->ringHead + node->logCount > node->logCapacity ? node->ringHead + node->logCount - node->logCapacity : 0;
+        logNodeQuerySlots(query, node, depth, node->ringHead, node->ringHead + node->logCount - wrapCount);
+        logNodeQuerySlots(query, node, depth, 0, wrapCount);
+    }
+
+    if (depth == MAX_JSON_PATH_DEPTH) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < node->childCount; i++) {
+        query->jsonPath[depth] = node->children[i]->name;
+        logNodeQuery(query, node->children[i], depth + 1);
+    }
+}
+
+/**
+ * @struct PrintChunk
+ *
+ * @brief A top level entry of the root node printed by a worker thread.
+ *
+ * @var store The store being printed.
+ * @var entry The index of the child node, LOGS_ENTRY for the logs array.
+ * @var isLast Whether the entry is the last one of the root node.
+ * @var printBuffer The print buffer the entry is printed into.
+ */
+typedef struct PrintChunk {
+    const LogStore_s* store;
+    unsigned int entry;
+    int isLast;
+    PrintBuffer_s printBuffer;
+} PrintChunk_s;
+
+/**
+ * @brief Lock the worker pool for use, recreating it first in a forked child.
+ *
+ * @note The lock must be released with pthread_rwlock_unlock(&s_g_workerPoolLock) once the pool is no longer used.
+ *
+ * @return WorkerPool_s* ptr of the worker pool, NULL if the background work runs on the calling thread.
+ */
+static WorkerPool_s* workerPoolAcquire(void)
+{
+    pthread_rwlock_rdlock(&s_g_workerPoolLock);
+    if (s_g_workerPoolForked == 0) {
+        return s_g_workerPool;
+    }
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    pthread_rwlock_wrlock(&s_g_workerPoolLock);
+    if (s_g_workerPoolForked != 0) {
+        s_g_workerPoolForked = 0;
+        s_g_workerPool = workerPoolCreate(s_g_workerThreadCount, &s_g_workerThreadAttr);
+        CJSON_LOGGER_ASSERT_NEQ(s_g_workerPool, NULL);
+    }
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    pthread_rwlock_rdlock(&s_g_workerPoolLock);
+    return s_g_workerPool;
+}
+
+/**
+ * @brief Worker pool task printing a chunk.
+ *
+ * @param ctx The chunk to print.
+ */
+static void printChunkTask(void* ctx)
+{
+    PrintChunk_s* chunk = (PrintChunk_s*)ctx;
+    logNodePrintEntry(chunk->store, chunk->store->root, chunk->entry, 1, chunk->isLast, &chunk->printBuffer);
+}
+
+/**
+ * @brief Free the chunks returned by logStorePrintChunks().
+ *
+ * @param chunks The chunks to free.
+ * @param chunkCount The number of chunks.
+ */
+static void printChunksFree(PrintChunk_s* chunks, size_t chunkCount);
+
+/**
+ * @brief Print a log store as JSON text split into ordered chunks.
+ *
+ * @note Large stores get their top level entries printed in parallel on the worker pool, idle workers steal the chunks of the busy ones.
+ *
+ * @param store The store to print.
+ * @param chunks Where the array of the printed chunks will be stored, the array and the buffers must be freed with printChunksFree().
+ *
+ * @return size_t the number of chunks, 0 in case of failure (nothing is left to free, a chunk that could not grow fails the whole print).
+ */
+static size_t logStorePrintChunks(const LogStore_s* store, PrintChunk_s** chunks)
+{
+    const LogNode_s* root = store->root;
+    unsigned int entryCount = root->childCount + (root->logCount > 0 ? 1 : 0);
+
+    if (store->logCount < PARALLEL_PRINT_MIN_LOGS || entryCount < 2) {
+        *chunks = (PrintChunk_s*)calloc(1, sizeof(PrintChunk_s));
+        CJSON_LOGGER_ASSERT_NEQ(*chunks, NULL);
+        if (*chunks == NULL) {
+            return 0;
+        }
+
+        logNodePrint(store, root, 1, &(*chunks)->printBuffer);
+        if ((*chunks)->printBuffer.failed != 0) {
+            printChunksFree(*chunks, 1);
+            *chunks = NULL;
+            return 0;
+        }
+
+        return 1;
+    }
+
+    // The opening and closing braces of the root node get a chunk each.
+    size_t chunkCount = entryCount + 2;
+    *chunks = (PrintChunk_s*)calloc(chunkCount, sizeof(PrintChunk_s));
+    CJSON_LOGGER_ASSERT_NEQ(*chunks, NULL);
+    if (*chunks == NULL) {
+        return 0;
+    }
+
+    printBufferAppend(&(*chunks)[0].printBuffer, "{\n", 2);
+    printBufferAppend(&(*chunks)[chunkCount - 1].printBuffer, "}", 1);
+
+    unsigned int entry = 0;
+    for (unsigned int i = 0; i <= root->childCount; i++) {
+        if (root->logCount > 0 && root->logsIndex == i) {
+            (*chunks)[++entry].entry = LOGS_ENTRY;
+        }
+
+        if (i < root->childCount) {
+            (*chunks)[++entry].entry = i;
+        }
+    }
+
+    WorkerPool_s* workerPool = workerPoolAcquire();
+    WorkerPoolGroup_s group = { 0 };
+    for (size_t i = 1; i < chunkCount - 1; i++) {
+        (*chunks)[i].store = store;
+        (*chunks)[i].isLast = i == chunkCount - 2;
+
+        if (workerPool == NULL || workerPoolSubmit(workerPool, &group, printChunkTask, &(*chunks)[i]) != 0) {
+            printChunkTask(&(*chunks)[i]);
+        }
+    }
+
+    if (workerPool != NULL) {
+        workerPoolWait(workerPool, &group);
+    }
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        if ((*chunks)[i].printBuffer.failed != 0) {
+            printChunksFree(*chunks, chunkCount);
+            *chunks = NULL;
+            return 0;
+        }
+    }
+
+    return chunkCount;
+}
+
+static void printChunksFree(PrintChunk_s* chunks, size_t chunkCount)
+{
+    for (size_t i = 0; i < chunkCount; i++) {
+        free(chunks[i].printBuffer.buffer);
+    }
+    free(chunks);
+}
+
+/**
+ * @brief Write printed chunks into a file descriptor in order, with as few vectored writes as possible.
+ *
+ * @param fd The file descriptor to write into.
+ * @param chunks The chunks to write.
+ * @param chunkCount The number of chunks.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int printChunksWrite(int fd, const PrintChunk_s* chunks, size_t chunkCount)
+{
+    struct iovec iov[MAX_WRITE_IOVECS];
+    size_t chunk = 0;
+    size_t offset = 0;
+
+    while (chunk < chunkCount) {
+        int iovCount = 0;
+        for (size_t i = chunk; i < chunkCount && iovCount < MAX_WRITE_IOVECS; i++) {
+            size_t skip = i == chunk ? offset : 0;
+            if (chunks[i].printBuffer.length > skip) {
+                iov[iovCount].iov_base = chunks[i].printBuffer.buffer + skip;
+                iov[iovCount].iov_len = chunks[i].printBuffer.length - skip;
+                iovCount++;
+            }
+        }
+
+        if (iovCount == 0) {
+            break;
+        }
+
+        ssize_t written = writev(fd, iov, iovCount);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        // Advance past the fully written chunks, a partial write resumes from the middle of a chunk.
+        size_t remaining = (size_t)written + offset;
+        while (chunk < chunkCount && remaining >= chunks[chunk].printBuffer.length) {
+            remaining -= chunks[chunk].printBuffer.length;
+            chunk++;
+        }
+        offset = remaining;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Print the log store as a JSON tree to the output file, flush operation of the JSON tree sink.
+ *
+ * @param ctx Unused.
+ */
+static void treeSinkFlush(void* ctx)
+{
+    (void)ctx;
+
+    // The store is copied under the lock and printed once it is released, so a slow (niced or idle) worker printing it
+    // never keeps the logging threads waiting on the lock.
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    LogStore_s* snapshot = NULL;
+    uint64_t printedGeneration = s_g_logGeneration;
+    // The output file already holds the logs unless they changed since the last dump.
+    int dirty = s_g_logStore != NULL && s_g_logGeneration != s_g_dumpedGeneration;
+    if (dirty != 0) {
+        snapshot = logStoreSnapshot(s_g_logStore);
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    if (dirty == 0) {
+        return;
+    }
+
+    PrintChunk_s* chunks = NULL;
+    size_t chunkCount = snapshot != NULL ? logStorePrintChunks(snapshot, &chunks) : 0;
+    logStoreDelete(snapshot);
+
+    // Incomplete JSON text is not written over the output file, the logs stay dirty and the next dump retries.
+    if (chunkCount == 0) {
+        CJSON_LOGGER_REPORT_ERROR("the JSON tree could not be printed");
+        return;
+    }
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    if (s_g_filePath == NULL) {
+        pthread_mutex_unlock(&s_g_cLoggerMutex);
+        printChunksFree(chunks, chunkCount);
+        return;
+    }
+
+    int fd = open(s_g_filePath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    int res = fd != -1 ? printChunksWrite(fd, chunks, chunkCount) : -1;
+    if (fd != -1) {
+        close(fd);
+    }
+    printChunksFree(chunks, chunkCount);
+
+    // Only a written file skips the next dumps of the same logs, the next dump (or the one at exit) retries a failed one.
+    if (res != 0) {
+        CJSON_LOGGER_REPORT_ERROR("the JSON tree could not be written");
+        return;
+    }
+
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    if (s_g_dumpedGeneration < printedGeneration) {
+        s_g_dumpedGeneration = printedGeneration;
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+}
+
+/**
+ * @brief Print the log store as a JSON tree to a rotated file and start an empty store, rotate operation of the JSON tree sink.
+ *
+ * @param ctx Unused.
+ */
+static void treeSinkRotate(void* ctx)
+{
+    (void)ctx;
+
+    // A store that did not change since it was swapped in would only rotate into an empty file.
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    int unchanged = s_g_logStore == NULL || s_g_logGeneration == s_g_logStore->baseGeneration;
+    unsigned int preallocLogs = s_g_logStore != NULL ? s_g_logStore->preallocLogs : 0;
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    char timeStr[MAX_TIME_STR_LEN] = { 0 };
+    formatRotationTime(timeStr, sizeof(timeStr));
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_logCount = 0;
+    s_g_rotatePending = 0;
+
+    if (s_g_filePath == NULL || unchanged != 0) {
+        pthread_mutex_unlock(&s_g_cLoggerMutex);
+        return;
+    }
+
+    if (s_g_rotatedFilesQueue == NULL) {
+        s_g_rotatedFilesQueue = (Queue_s*)calloc(1, sizeof(Queue_s));
+        CJSON_LOGGER_ASSERT_NEQ(s_g_rotatedFilesQueue, NULL);
+    }
+
+    size_t rotatedFileLen = strlen(s_g_filePath) + strnlen(timeStr, MAX_TIME_STR_LEN) + 2;
+    char* rotatedFilePath = (char*)malloc(rotatedFileLen);
+    CJSON_LOGGER_ASSERT_NEQ(rotatedFilePath, NULL);
+
+    int fd = -1;
+    if (rotatedFilePath != NULL) {
+        snprintf(rotatedFilePath, rotatedFileLen, "%s_%s", timeStr, s_g_filePath);
+        fd = open(rotatedFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    }
+
+    // The store is kept when the rotated file can not be created, the next rotation or dump writes its logs.
+    if (fd == -1 || s_g_rotatedFilesQueue == NULL) {
+        pthread_mutex_unlock(&s_g_cLoggerMutex);
+        CJSON_LOGGER_REPORT_ERROR("the rotated JSON tree could not be created");
+        if (fd != -1) {
+            close(fd);
+            remove(rotatedFilePath);
+        }
+        free(rotatedFilePath);
+        return;
+    }
+
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    // The empty store is created before the swap, the logs keep going to the old one if it can not be.
+    LogStore_s* newStore = logStoreCreate(preallocLogs);
+    if (newStore == NULL) {
+        CJSON_LOGGER_REPORT_ERROR("the log store could not be rotated");
+        close(fd);
+        remove(rotatedFilePath);
+        free(rotatedFilePath);
+        return;
+    }
+
+    // Swap in the empty store so logging can go on while the old one is being serialized.
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    LogStore_s* store = s_g_logStore;
+    if (store != NULL) {
+        logStoreCopyNodeLayout(newStore, store);
+        s_g_logStore = newStore;
+
+        // The output file holds the logs of the old store.
+        s_g_logGeneration++;
+        newStore->baseGeneration = s_g_logGeneration;
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    // The store was deleted by a reinitialization in the meantime, there is nothing to rotate.
+    if (store == NULL) {
+        logStoreDelete(newStore);
+        close(fd);
+        remove(rotatedFilePath);
+        free(rotatedFilePath);
+        return;
+    }
+
+    PrintChunk_s* chunks = NULL;
+    size_t chunkCount = logStorePrintChunks(store, &chunks);
+
+    int res = chunkCount != 0 ? printChunksWrite(fd, chunks, chunkCount) : -1;
+    close(fd);
+    printChunksFree(chunks, chunkCount);
+
+    // The old store is put back when its logs could not be printed, unless the new one already holds logs, the next
+    // rotation or dump writes them.
+    if (res != 0) {
+        CJSON_LOGGER_REPORT_ERROR("the rotated JSON tree could not be written");
+        remove(rotatedFilePath);
+        free(rotatedFilePath);
+
+        pthread_mutex_lock(&s_g_rootNodeMutex);
+        if (s_g_logStore == newStore && s_g_logGeneration == newStore->baseGeneration) {
+            s_g_logStore = store;
+            store = newStore;
+            s_g_logGeneration++;
+        }
+        pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+        logStoreDelete(store);
+        return;
+    }
+    logStoreDelete(store);
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    if (s_g_rotatedFilesQueue == NULL) {
+        pthread_mutex_unlock(&s_g_cLoggerMutex);
+        free(rotatedFilePath);
+        return;
+    }
+
+    if (s_g_rotatedFilesQueue->currentSize < MAX_LOG_ROTATION_FILES) {
+        s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->tail] = strdup(rotatedFilePath);
+
+        CJSON_LOGGER_ASSERT_NEQ(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->tail], NULL);
+
+        s_g_rotatedFilesQueue->tail = (s_g_rotatedFilesQueue->tail + 1) % MAX_LOG_ROTATION_FILES;
+        s_g_rotatedFilesQueue->currentSize++;
+    }
+
+    else {
+        int removeRes = remove(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head]);
+
+        CJSON_LOGGER_ASSERT_EQ(removeRes, 0);
+
+        free(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head]);
+        s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head] = NULL;
+        s_g_rotatedFilesQueue->head = (s_g_rotatedFilesQueue->head + 1) % MAX_LOG_ROTATION_FILES;
+        s_g_rotatedFilesQueue->currentSize--;
+    }
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    free(rotatedFilePath);
+}
+
+/**
+ * @brief Operations of the JSON tree sink, the records reach it through the log store instead of a queue.
+ */
+static const SinkOps_s s_g_treeSinkOps = {
+    .writeBatch = NULL,
+    .flush = treeSinkFlush,
+    .rotate = treeSinkRotate,
+    .forkFresh = NULL,
+    .close = NULL,
+};
+
+/**
+ * @brief Worker pool task rotating the JSON tree once the log store is full.
+ *
+ * @param ctx Unused.
+ */
+static void rotateTask(void* ctx)
+{
+    (void)ctx;
+
+    // Go through the sink so the rotation is serialized with the flushes and the dumps of the JSON tree.
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    if (s_g_treeSink != NULL) {
+        sinkRotate(s_g_treeSink);
+    }
+
+    else {
+        // Without an output file there is nothing to rotate, the logs are only counted again.
+        treeSinkRotate(NULL);
+    }
+    pthread_rwlock_unlock(&s_g_sinksLock);
+}
+
+/**
+ * @brief Worker pool task writing the queued records of a sink.
+ *
+ * @param ctx The sink to drain.
+ */
+static void sinkDrainTask(void* ctx)
+{
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    sinkDrain((Sink_s*)ctx);
+    pthread_rwlock_unlock(&s_g_sinksLock);
+}
+
+/**
+ * @brief Allocate the optional log columns of a node the record holds a value for, zero for the logs already stored.
+ *
+ * @param node The node the record will be inserted into, its columns already hold room for it.
+ * @param record The record to insert.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int logNodeReserveOptionalColumns(LogNode_s* node, const LogRecord_s* record)
+{
+    if (record->sequence != 0 && node->sequences == NULL) {
+        node->sequences = (uint64_t*)calloc(node->logCapacity, sizeof(uint64_t));
+        CJSON_LOGGER_ASSERT_NEQ(node->sequences, NULL);
+        if (node->sequences == NULL) {
+            return -1;
+        }
+    }
+
+    if (record->threadId != 0 && node->threadIds == NULL) {
+        node->threadIds = (uint32_t*)calloc(node->logCapacity, sizeof(uint32_t));
+        CJSON_LOGGER_ASSERT_NEQ(node->threadIds, NULL);
+        if (node->threadIds == NULL) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Insert a record into the log store.
+ *
+ * @note Must be called with s_g_rootNodeMutex held.
+ *
+ * @param store The store where the record will be inserted.
+ * @param record The record to insert.
+ *
+ * @return int, 1 if the record counts towards the rotation of the store, 0 if it does not, negative value in case of failure.
+ */
+static int logStoreInsert(LogStore_s* store, const LogRecord_s* record)
+{
+    LogNode_s* node = store->root;
+    for (size_t i = 0; i < record->jsonPathDepth && node != NULL; i++) {
+        node = logNodeGetChild(node, record->jsonPath[i]);
+    }
+
+    uint32_t callSiteId = 0;
+    uint32_t messageOffset = 0;
+    uint16_t messageLength = 0;
+    uint16_t escapedLength = 0;
+    int isCapped = node != NULL && node->ringCapacity != 0;
+
+    logMessageMeasure(record->logMsg, &messageLength, &escapedLength);
+
+    if (node == NULL
+        || (isCapped == 0 && logNodeReserve(node) != 0)
+        || logNodeReserveOptionalColumns(node, record) != 0
+        || logStoreInternCallSite(store, record, &callSiteId) != 0
+        || (isCapped == 0 && logStoreCopyMessage(store, record->logMsg, messageLength, escapedLength, &messageOffset) != 0)) {
+        return -1;
+    }
+
+    if (node->logCount == 0) {
+        node->logsIndex = node->childCount;
+    }
+
+    // A full capped node replaces its oldest log.
+    int replaced = isCapped != 0 && node->logCount == node->ringCapacity;
+    unsigned int slot = replaced != 0 ? node->ringHead : node->logCount;
+
+    node->timeStamps[slot] = record->timeStamp;
+    node->logLevels[slot] = (uint8_t)record->logLevel;
+    node->callSites[slot] = callSiteId;
+    node->messageLengths[slot] = messageLength;
+    node->escapedLengths[slot] = escapedLength;
+    if (node->sequences != NULL) {
+        node->sequences[slot] = record->sequence;
+    }
+
+    if (node->threadIds != NULL) {
+        node->threadIds[slot] = record->threadId;
+    }
+
+    if (isCapped != 0) {
+        ringMessageCopy(node->ringMessages, slot, record->logMsg, messageLength);
+    }
+
+    else {
+        node->messages[slot] = messageOffset;
+    }
+
+    logNodeIndexLog(node, slot, replaced);
+    if (replaced != 0) {
+        node->ringHead = logNodeSlot(node, 1);
+    }
+
+    else {
+        node->logCount++;
+        store->logCount++;
+    }
+
+    s_g_logGeneration++;
+
+    // The memory of the capped nodes is bounded, their logs do not count towards the rotation of the log store.
+    return isCapped == 0 ? 1 : 0;
+}
+
+/**
+ * @brief Callback of flightRecorderDrain() inserting the records kept by the flight recorder into the log store.
+ *
+ * @note Called with s_g_rootNodeMutex held.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The unsigned int counting the records towards the rotation of the store.
+ */
+static void flightRecorderPersistRecords(const LogRecord_s* records, size_t count, void* userData)
+{
+    unsigned int* logCount = (unsigned int*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        *logCount += logStoreInsert(s_g_logStore, &records[i]) > 0 ? 1u : 0u;
+    }
+}
+
+/**
+ * @brief Count logs towards the automatic rotation and schedule it once the log store is full.
+ *
+ * @param logCount The number of logs inserted into the store.
+ */
+static void logCountAdd(unsigned int logCount)
+{
+    if (logCount == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_logCount += logCount;
+    int rotate = s_g_logCount > s_g_rotateLogCount && s_g_rotatePending == 0;
+    if (rotate != 0) {
+        s_g_rotatePending = 1;
+    }
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    if (rotate == 0) {
+        return;
+    }
+
+    // Hand the rotation to the worker pool so the logging thread does not pay for printing and writing the logs.
+    WorkerPool_s* workerPool = workerPoolAcquire();
+    int res = -1;
+    if (workerPool != NULL) {
+        res = workerPoolSubmit(workerPool, NULL, rotateTask, NULL);
+    }
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    if (res != 0) {
+        rotateTask(NULL);
+    }
+}
+
+/**
+ * @brief Read the levels and the destinations of the logger in a single critical section.
+ *
+ * @param targets Where the levels and the destinations will be stored.
+ *
+ * @return int, 1 if a lazy initialization is pending, 0 otherwise.
+ */
+static int logTargetsRead(LogTargets_s* targets)
+{
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    targets->logLevel = s_g_logLevel;
+    targets->sinksLogLevel = s_g_sinksLogLevel;
+    targets->hasLogStore = s_g_hasLogStore;
+    targets->hasShmSink = s_g_hasShmSink;
+    targets->hasFlightRecorder = s_g_hasFlightRecorder;
+    targets->recordSinkCount = s_g_recordSinkCount;
+    int lazyInitPending = s_g_lazyInitPending;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    return lazyInitPending;
+}
+
+/**
+ * @brief Push a log message to the specified JSON node.
+ *
+ * @param jsonPath The names of the JSON nodes leading to the node the log message is pushed to.
+ * @param jsonPathDepth The number of names in the jsonPath.
+ * @param logInfo The log info, such as time stamp, file name, etc.
+ * @param logMsg The log message to push.
+ * @param targets The levels and the destinations of the logger at the time of the log.
+ * @param runtimeConfig The runtime configuration snapshot read for the log, NULL if none.
+ */
+static void cJSONLoggerPushLog(const char* const* jsonPath, size_t jsonPathDepth, LogInfo_s* logInfo, const char* logMsg, const LogTargets_s* targets,
+    const RuntimeConfig_s* runtimeConfig)
+{
+    CJSON_LOGGER_ASSERT_NEQ(logInfo, NULL);
+    CJSON_LOGGER_ASSERT_NEQ(logMsg, NULL);
+
+    CJSON_LOG_LEVEL_E loggerLogLevel = targets->logLevel;
+
+    // A rule of the runtime configuration replaces the level of the logger for its nodes and may rate limit them.
+    RuntimeRule_s* rule = runtimeConfigMatch(runtimeConfig, jsonPath, jsonPathDepth);
+    if (rule != NULL) {
+        if (rule->logLevel != __CJSON_LOG_LEVEL_START) {
+            loggerLogLevel = rule->logLevel;
+        }
+
+        if (logLevelEnabled(logInfo->logLevel, loggerLogLevel) == 0 && logLevelEnabled(logInfo->logLevel, targets->sinksLogLevel) == 0) {
+            return;
+        }
+
+        if (runtimeRuleAdmit(rule) == 0) {
+            return;
+        }
+    }
+
+    // The records are numbered once admitted, the rate limited records leave no gaps in the sequence.
+    uint64_t sequence = 0;
+    if (atomic_load_explicit(&s_g_sequenceNumbers, memory_order_relaxed) != 0) {
+        sequence = atomic_fetch_add_explicit(&s_g_recordSequence, 1, memory_order_relaxed) + 1;
+    }
+
+    uint32_t threadId = atomic_load_explicit(&s_g_threadIds, memory_order_relaxed) != 0 ? loggerThreadId() : 0;
+
+    LogRecord_s record = {
+        .jsonPath = jsonPath,
+        .jsonPathDepth = jsonPathDepth,
+        .timeStamp = logInfo->timeStamp,
+        .logLevel = logInfo->logLevel,
+        .fileName = logInfo->fileName,
+        .funcName = logInfo->funcName,
+        .fileLine = logInfo->fileLine,
+        .logMsg = logMsg,
+        .sequence = sequence,
+        .threadId = threadId,
+    };
+
+    // The sinks only queue the record, the full batches are written by the worker pool. Each destination is only locked
+    // when the logger has it.
+    if (targets->recordSinkCount != 0) {
+        pthread_rwlock_rdlock(&s_g_sinksLock);
+        for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+            if (sinkWrite(s_g_sinks[i], &record, loggerLogLevel) == 0) {
+                continue;
+            }
+
+            WorkerPool_s* workerPool = workerPoolAcquire();
+            int res = -1;
+            if (workerPool != NULL) {
+                res = workerPoolSubmit(workerPool, NULL, sinkDrainTask, s_g_sinks[i]);
+            }
+            pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+            if (res != 0) {
+                sinkDrain(s_g_sinks[i]);
+            }
+        }
+        pthread_rwlock_unlock(&s_g_sinksLock);
+    }
+
+    // The log store and the shared memory ring follow the level of the logger, the sinks may be more verbose.
+    if (logLevelEnabled(logInfo->logLevel, loggerLogLevel) == 0) {
+        return;
+    }
+
+    if (targets->hasShmSink != 0) {
+        pthread_rwlock_rdlock(&s_g_shmSinkLock);
+        if (s_g_shmSink != NULL) {
+            shmSinkWrite(s_g_shmSink, &record);
+        }
+        pthread_rwlock_unlock(&s_g_shmSinkLock);
+    }
+
+    if (targets->hasLogStore == 0) {
+        return;
+    }
+
+    // The flight recorder keeps the record away from the log store until a trigger persists it.
+    FLIGHT_RECORDER_RES_E flightRecorderRes = FLIGHT_RECORDER_PASS;
+    if (targets->hasFlightRecorder != 0) {
+        pthread_rwlock_rdlock(&s_g_flightRecorderLock);
+        flightRecorderRes = s_g_flightRecorder != NULL ? flightRecorderWrite(s_g_flightRecorder, &record) : FLIGHT_RECORDER_PASS;
+        if (flightRecorderRes == FLIGHT_RECORDER_KEPT || flightRecorderRes == FLIGHT_RECORDER_DROPPED) {
+            pthread_rwlock_unlock(&s_g_flightRecorderLock);
+            return;
+        }
+    }
+
+    unsigned int logCount = 0;
+
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    if (s_g_logStore != NULL) {
+        if (flightRecorderRes == FLIGHT_RECORDER_TRIGGERED) {
+            flightRecorderDrain(s_g_flightRecorder, flightRecorderPersistRecords, &logCount);
+        }
+
+        logCount += logStoreInsert(s_g_logStore, &record) > 0 ? 1u : 0u;
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    if (targets->hasFlightRecorder != 0) {
+        pthread_rwlock_unlock(&s_g_flightRecorderLock);
+    }
+
+    logCountAdd(logCount);
+}
+
+/**
+ * @brief Free the queue of rotated log files, the files themselves are kept.
+ *
+ * @param queue The queue to free.
+ */
+static void rotatedFilesQueueDelete(Queue_s* queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < MAX_LOG_ROTATION_FILES; i++) {
+        free(queue->rotatedFiles[i]);
+    }
+
+    free(queue);
+}
+
+/**
+ * @brief Fork handler run in the parent before the fork, takes every lock so the child inherits a consistent state.
+ */
+static void cJSONLoggerAtForkPrepare(void)
+{
+    // Same order as the rest of the logger, the sinks lock is taken before the store lock and the store lock before the worker pool lock.
+    pthread_mutex_lock(&s_g_lazyConfigLock);
+    pthread_rwlock_wrlock(&s_g_sinksLock);
+    pthread_rwlock_wrlock(&s_g_flightRecorderLock);
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    if (s_g_flightRecorder != NULL) {
+        flightRecorderAtForkPrepare(s_g_flightRecorder);
+    }
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    pthread_rwlock_wrlock(&s_g_workerPoolLock);
+    pthread_rwlock_wrlock(&s_g_shmSinkLock);
+    formatAtForkPrepare();
+}
+
+/**
+ * @brief Fork handler run in the parent after the fork, releases the locks taken by cJSONLoggerAtForkPrepare().
+ */
+static void cJSONLoggerAtForkParent(void)
+{
+    formatAtForkParent();
+    pthread_rwlock_unlock(&s_g_shmSinkLock);
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+    if (s_g_flightRecorder != NULL) {
+        flightRecorderAtForkParent(s_g_flightRecorder);
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+    pthread_rwlock_unlock(&s_g_flightRecorderLock);
+    pthread_rwlock_unlock(&s_g_sinksLock);
+    pthread_mutex_unlock(&s_g_lazyConfigLock);
+}
+
+/**
+ * @brief Fork handler run in the child after the fork, resets the locks and the state that belongs to the parent.
+ *
+ * @note The worker threads are not inherited, the worker pool is recreated by the first background work of the child.
+ */
+static void cJSONLoggerAtForkChild(void)
+{
+    pthread_mutex_init(&s_g_lazyConfigLock, NULL);
+    pthread_mutex_init(&s_g_rootNodeMutex, NULL);
+    pthread_mutex_init(&s_g_cLoggerMutex, NULL);
+    pthread_rwlock_init(&s_g_workerPoolLock, NULL);
+    pthread_rwlock_init(&s_g_shmSinkLock, NULL);
+    pthread_rwlock_init(&s_g_sinksLock, NULL);
+    pthread_rwlock_init(&s_g_flightRecorderLock, NULL);
+    formatAtForkChild();
+    loggerThreadAtForkChild();
+
+    if (s_g_flightRecorder != NULL) {
+        flightRecorderAtForkChild(s_g_flightRecorder);
+    }
+
+    // A fresh child writes its own sink files, e.g. log.ndjson -> log.<pid>.ndjson.
+    for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+        sinkAtForkChild(s_g_sinks[i], s_g_forkMode == CJSON_LOGGER_FORK_FRESH);
+    }
+
+    if (s_g_workerPool != NULL) {
+        workerPoolAbandon(s_g_workerPool);
+        s_g_workerPool = NULL;
+        s_g_workerPoolForked = 1;
+    }
+
+    // The periodic flush and the configuration reloads belong to the parent, the child flushes on demand and at exit.
+    loggerTimerAbandon(s_g_flushTimer);
+    s_g_flushTimer = NULL;
+    s_g_flushPeriodic = 0;
+    configWatcherAbandon(s_g_configWatcher);
+    s_g_configWatcher = NULL;
+    runtimeConfigAtForkChild();
+
+    // The queued rotation was dropped with the worker pool.
+    s_g_rotatePending = 0;
+
+    // The rotated files belong to the parent, the child must not remove them.
+    rotatedFilesQueueDelete(s_g_rotatedFilesQueue);
+    s_g_rotatedFilesQueue = NULL;
+
+    if (s_g_forkMode != CJSON_LOGGER_FORK_FRESH || s_g_filePath == NULL) {
+        return;
+    }
+
+    char* filePath = formatForkFilePath(s_g_filePath, getpid());
+    if (filePath != NULL) {
+        free(s_g_filePath);
+        s_g_filePath = filePath;
+    }
+
+    // The records kept by the flight recorder belong to the logs of the parent.
+    if (s_g_flightRecorder != NULL) {
+        flightRecorderDrain(s_g_flightRecorder, NULL, NULL);
+    }
+
+    LogStore_s* store = s_g_logStore;
+    s_g_logStore = logStoreCreate(store != NULL ? store->preallocLogs : 0);
+    CJSON_LOGGER_ASSERT_NEQ(s_g_logStore, NULL);
+    if (s_g_logStore != NULL && store != NULL) {
+        logStoreCopyNodeLayout(s_g_logStore, store);
+    }
+
+    // The output file of the child does not exist yet, it is written once the child logs.
+    if (s_g_logStore != NULL) {
+        s_g_logStore->baseGeneration = s_g_logGeneration;
+    }
+    s_g_dumpedGeneration = s_g_logGeneration;
+    logStoreDelete(store);
+    s_g_logCount = 0;
+}
+
+/**
+ * @brief Register cJSONLoggerDestroy() to run at exit.
+ */
+static void cJSONLoggerRegisterAtExit(void)
+{
+    int res = atexit(cJSONLoggerDestroy);
+    CJSON_LOGGER_ASSERT_EQ(res, 0);
+}
+
+/**
+ * @brief Register the fork handlers of the logger.
+ */
+static void cJSONLoggerRegisterAtFork(void)
+{
+    int res = pthread_atfork(cJSONLoggerAtForkPrepare, cJSONLoggerAtForkParent, cJSONLoggerAtForkChild);
+    CJSON_LOGGER_ASSERT_EQ(res, 0);
+}
+
+/**
+ * @brief Add a sink to the sinks the records are fanned out to.
+ *
+ * @note Must be called with the sinks lock held for writing, and with the tree sink already set when adding it.
+ *
+ * @param sink The sink to add, destroyed in case of failure.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int sinksAdd(Sink_s* sink)
+{
+    if (sink == NULL) {
+        return -1;
+    }
+
+    if (s_g_sinkCount == MAX_SINKS) {
+        sinkDestroy(sink);
+        return -1;
+    }
+
+    s_g_sinks[s_g_sinkCount++] = sink;
+
+    CJSON_LOG_LEVEL_E logLevel = sinkLogLevel(sink);
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    if (logLevel < __CJSON_LOG_LEVEL_END && logLevel > s_g_sinksLogLevel) {
+        s_g_sinksLogLevel = logLevel;
+    }
+    s_g_recordSinkCount += sink != s_g_treeSink ? 1u : 0u;
+    s_g_destroyPending = 1;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    return 0;
+}
+
+/**
+ * @brief Run the clock and the formatting once, so the first log does not pay for their lazy initialization.
+ */
+static void cJSONLoggerWarmUp(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    char logMsg[MAX_LOG_MSG_LEN];
+    int res = snprintf(logMsg, sizeof(logMsg), "%s %d %u %ld %f %p", "warm up", -1, 1u, (long)ts.tv_nsec, 1.0, (void*)logMsg);
+    CJSON_LOGGER_ASSERT_NEQ(res, -1);
+}
+
+/**
+ * @brief Work of the periodic flush, writes the queued records of the sinks and the JSON tree.
+ *
+ * @param ctx Unused.
+ */
+static void cJSONLoggerFlushTimer(void* ctx)
+{
+    (void)ctx;
+
+    cJSONLoggerDump();
+}
+
+/**
+ * @brief Publish the log level and the per path rules (log levels and rate limits) of a configuration file.
+ *
+ * @param configFile The configuration file.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int cJSONLoggerApplyRuntimeConfig(const ConfigFile_s* configFile)
+{
+    size_t ruleCount = 0;
+    for (size_t i = 0; i < configFile->pathCount; i++) {
+        ruleCount += configFile->paths[i].logLevel != __CJSON_LOG_LEVEL_START || configFile->paths[i].rateLimit != 0 ? 1u : 0u;
+    }
+
+    // The snapshot is built aside and published at once, the logs read either the previous or the new rules.
+    RuntimeConfig_s* runtimeConfig = NULL;
+    if (ruleCount > 0) {
+        runtimeConfig = runtimeConfigCreate(ruleCount);
+        if (runtimeConfig == NULL) {
+            return -1;
+        }
+
+        size_t ruleIndex = 0;
+        for (size_t i = 0; i < configFile->pathCount; i++) {
+            const ConfigFilePath_s* path = &configFile->paths[i];
+            if (path->logLevel == __CJSON_LOG_LEVEL_START && path->rateLimit == 0) {
+                continue;
+            }
+
+            if (runtimeConfigSetRule(runtimeConfig, ruleIndex++, path->jsonPath, path->jsonPathDepth, path->logLevel, path->rateLimit, path->rateBurst) != 0) {
+                runtimeConfigDelete(runtimeConfig);
+                return -1;
+            }
+        }
+    }
+
+    runtimeConfigPublish(runtimeConfig);
+    cJSONLoggerSetLogLevel(configFile->config.logLevel);
+
+    return 0;
+}
+
+/**
+ * @brief Reload the configuration file after a change, a configuration that does not load keeps the current one.
+ *
+ * @param filePath The path of the configuration file.
+ * @param ctx Unused.
+ */
+static void cJSONLoggerReloadConfigFile(const char* filePath, void* ctx)
+{
+    (void)ctx;
+
+    ConfigFile_s configFile;
+    if (configFileLoad(filePath, &configFile) != 0) {
+        return;
+    }
+
+    cJSONLoggerApplyRuntimeConfig(&configFile);
+    configFileRelease(&configFile);
+}
+
+void cJSONLoggerGetDefaultConfig(CJSONLoggerConfig_s* config)
+{
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    memset(config, 0, sizeof(CJSONLoggerConfig_s));
+    config->logLevel = CJSON_LOG_LEVEL_INFO;
+    config->filePath = NULL;
+    config->workerThreads = cpuCount > DEFAULT_WORKER_THREADS ? DEFAULT_WORKER_THREADS : (cpuCount > 1 ? (unsigned int)cpuCount : 1);
+    config->workerCpuList = NULL;
+    config->workerNice = CJSON_LOGGER_NICE_INHERIT;
+    config->workerSchedPolicy = CJSON_LOGGER_SCHED_INHERIT;
+    config->workerSchedPriority = 0;
+    config->forkMode = CJSON_LOGGER_FORK_INHERIT;
+    config->shmName = NULL;
+    config->shmCapacity = 0;
+    config->socketPath = NULL;
+    config->socketQueueCapacity = DEFAULT_SINK_QUEUE_CAPACITY;
+    config->socketBatchSize = DEFAULT_SINK_BATCH_SIZE;
+    config->flightRecorderCapacity = 0;
+    config->flightRecorderTriggerLevel = CJSON_LOG_LEVEL_ERROR;
+    config->flightRecorderPostRecords = DEFAULT_FLIGHT_RECORDER_POST_RECORDS;
+    config->rotateLogCount = MAX_LOG_COUNT;
+    config->flushIntervalMs = 0;
+    config->preallocate = 0;
+    config->lazyInit = 0;
+    config->timeFormat = CJSON_LOGGER_TIME_LOCAL;
+    config->sequenceNumbers = 0;
+    config->threadIds = 0;
+}
+
+void cJSONLoggerGetDefaultSinkConfig(CJSONLoggerSinkConfig_s* sinkConfig)
+{
+    memset(sinkConfig, 0, sizeof(CJSONLoggerSinkConfig_s));
+    sinkConfig->type = CJSON_LOGGER_SINK_NDJSON;
+    sinkConfig->logLevel = __CJSON_LOG_LEVEL_START;
+    sinkConfig->mostSevereLogLevel = __CJSON_LOG_LEVEL_START;
+    sinkConfig->path = NULL;
+    sinkConfig->queueCapacity = DEFAULT_SINK_QUEUE_CAPACITY;
+    sinkConfig->batchSize = DEFAULT_SINK_BATCH_SIZE;
+    sinkConfig->callback = NULL;
+    sinkConfig->userData = NULL;
+    sinkConfig->rotateRecords = 0;
+    sinkConfig->rotateSeconds = 0;
+    sinkConfig->rotateFiles = 0;
+}
+
+int cJSONLoggerInit(CJSON_LOG_LEVEL_E logLevel, const char* filePath)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.logLevel = logLevel;
+    config.filePath = filePath;
+
+    // The callers of the original entry point started no threads, the worker pool is opted in with cJSONLoggerInitWithConfig().
+    config.workerThreads = 0;
+
+    return cJSONLoggerInitWithConfig(&config);
+}
+
+/**
+ * @brief Check a logger configuration.
+ *
+ * @param config The logger configuration.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int cJSONLoggerConfigValidate(const CJSONLoggerConfig_s* config)
+{
+    if (config == NULL || (config->filePath == NULL && config->shmName == NULL && config->socketPath == NULL)) {
+        return -1;
+    }
+
+    if (config->filePath != NULL && strlen(config->filePath) > MAX_FILE_NAME_LEN) {
+        return -1;
+    }
+
+    unsigned int shmCapacity = config->shmCapacity != 0 ? config->shmCapacity : SHM_RING_DEFAULT_CAPACITY;
+    if ((shmCapacity & (shmCapacity - 1)) != 0) {
+        return -1;
+    }
+
+    if (config->socketPath != NULL && strlen(config->socketPath) > SOCKET_SINK_MAX_PATH_LEN) {
+        return -1;
+    }
+
+    if (config->socketPath != NULL && (config->socketQueueCapacity == 0 || (config->socketQueueCapacity & (config->socketQueueCapacity - 1)) != 0 || config->socketBatchSize == 0)) {
+        return -1;
+    }
+
+    if (config->flightRecorderCapacity != 0
+        && (config->filePath == NULL || config->flightRecorderTriggerLevel <= __CJSON_LOG_LEVEL_START || config->flightRecorderTriggerLevel >= __CJSON_LOG_LEVEL_END)) {
+        return -1;
+    }
+
+    if (config->workerThreads > MAX_WORKER_THREADS) {
+        return -1;
+    }
+
+    LoggerThreadAttr_s threadAttr = {
+        .cpuList = config->workerCpuList,
+        .nice = config->workerNice,
+        .schedPolicy = config->workerSchedPolicy,
+        .schedPriority = config->workerSchedPriority,
+    };
+
+    if (loggerThreadAttrValidate(&threadAttr) != 0) {
+        return -1;
+    }
+
+    if (config->forkMode != CJSON_LOGGER_FORK_INHERIT && config->forkMode != CJSON_LOGGER_FORK_FRESH) {
+        return -1;
+    }
+
+    if (config->timeFormat != CJSON_LOGGER_TIME_LOCAL && config->timeFormat != CJSON_LOGGER_TIME_RFC3339 && config->timeFormat != CJSON_LOGGER_TIME_RFC3339_UTC) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Copy a configuration, its strings are copied into a single allocation.
+ *
+ * @param config The configuration to copy.
+ * @param copy Where the copy will be stored.
+ * @param copyStrings Where the allocation holding the strings of the copy will be stored, NULL if there are none.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int cJSONLoggerConfigCopy(const CJSONLoggerConfig_s* config, CJSONLoggerConfig_s* copy, char** copyStrings)
+{
+    const char* const* strings[] = { &config->filePath, &config->workerCpuList, &config->shmName, &config->socketPath };
+    const char** stringCopies[] = { &copy->filePath, &copy->workerCpuList, &copy->shmName, &copy->socketPath };
+
+    size_t stringsSize = 0;
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        stringsSize += *strings[i] != NULL ? strlen(*strings[i]) + 1 : 0;
+    }
+
+    char* stringsCopy = NULL;
+    if (stringsSize != 0) {
+        stringsCopy = (char*)malloc(stringsSize);
+        CJSON_LOGGER_ASSERT_NEQ(stringsCopy, NULL);
+        if (stringsCopy == NULL) {
+            return -1;
+        }
+    }
+
+    *copy = *config;
+    *copyStrings = stringsCopy;
+
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+        if (*strings[i] != NULL) {
+            size_t stringLen = strlen(*strings[i]) + 1;
+            memcpy(stringsCopy, *strings[i], stringLen);
+            *stringCopies[i] = stringsCopy;
+            stringsCopy += stringLen;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Compare two optional strings of a configuration.
+ *
+ * @param a The first string, NULL if not set.
+ * @param b The second string, NULL if not set.
+ *
+ * @return int, 1 if both are unset or equal, 0 otherwise.
+ */
+static inline int cJSONLoggerConfigStringEqual(const char* a, const char* b)
+{
+    return a == b || (a != NULL && b != NULL && strcmp(a, b) == 0);
+}
+
+/**
+ * @brief Check that a configuration keeps the settings of the resources already created by the previous initializations.
+ *
+ * @note The worker pool, the periodic flush, the shared memory sink, the flight recorder and the socket sink are only
+ * created by an initialization, their settings can only change once cJSONLoggerDestroy() released them.
+ *
+ * @param config The logger configuration.
+ *
+ * @return int, 0 if the settings are kept, negative value otherwise.
+ */
+static int cJSONLoggerConfigKeepsResources(const CJSONLoggerConfig_s* config)
+{
+    const CJSONLoggerConfig_s* initConfig = &s_g_initConfig;
+
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    int hasSocketSink = s_g_socketSink != NULL;
+    pthread_rwlock_unlock(&s_g_sinksLock);
+
+    pthread_rwlock_rdlock(&s_g_flightRecorderLock);
+    int hasFlightRecorder = s_g_flightRecorder != NULL;
+    pthread_rwlock_unlock(&s_g_flightRecorderLock);
+
+    // A forked child recreates the pool of the parent on demand, with the same settings.
+    pthread_rwlock_rdlock(&s_g_workerPoolLock);
+    int hasWorkerPool = s_g_workerThreadCount != 0;
+    int hasPeriodicFlush = s_g_flushTimer != NULL || s_g_flushPeriodic != 0;
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    pthread_rwlock_rdlock(&s_g_shmSinkLock);
+    int hasShmSink = s_g_shmSink != NULL;
+    pthread_rwlock_unlock(&s_g_shmSinkLock);
+
+    if (hasWorkerPool != 0
+        && (config->workerThreads != initConfig->workerThreads || !cJSONLoggerConfigStringEqual(config->workerCpuList, initConfig->workerCpuList)
+            || config->workerNice != initConfig->workerNice || config->workerSchedPolicy != initConfig->workerSchedPolicy
+            || config->workerSchedPriority != initConfig->workerSchedPriority)) {
+        return -1;
+    }
+
+    if (hasPeriodicFlush != 0 && config->flushIntervalMs != initConfig->flushIntervalMs) {
+        return -1;
+    }
+
+    // The time format is written in the header of the ring for the collector.
+    if (hasShmSink != 0
+        && (!cJSONLoggerConfigStringEqual(config->shmName, initConfig->shmName) || config->shmCapacity != initConfig->shmCapacity || config->timeFormat != initConfig->timeFormat)) {
+        return -1;
+    }
+
+    if (hasFlightRecorder != 0
+        && (config->flightRecorderCapacity != initConfig->flightRecorderCapacity || config->flightRecorderTriggerLevel != initConfig->flightRecorderTriggerLevel
+            || config->flightRecorderPostRecords != initConfig->flightRecorderPostRecords)) {
+        return -1;
+    }
+
+    if (hasSocketSink != 0
+        && (!cJSONLoggerConfigStringEqual(config->socketPath, initConfig->socketPath) || config->socketQueueCapacity != initConfig->socketQueueCapacity
+            || config->socketBatchSize != initConfig->socketBatchSize)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Initialize the logger with a checked configuration and setup the resources.
+ *
+ * @note Called with the lazy configuration lock held.
+ *
+ * @param config The logger configuration.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int cJSONLoggerInitNow(const CJSONLoggerConfig_s* config)
+{
+    unsigned int shmCapacity = config->shmCapacity != 0 ? config->shmCapacity : SHM_RING_DEFAULT_CAPACITY;
+    unsigned int rotateLogCount = config->rotateLogCount != 0 ? config->rotateLogCount : MAX_LOG_COUNT;
+    unsigned int preallocLogs = config->preallocate != 0 ? rotateLogCount : 0;
+
+    LoggerThreadAttr_s threadAttr = {
+        .cpuList = config->workerCpuList,
+        .nice = config->workerNice,
+        .schedPolicy = config->workerSchedPolicy,
+        .schedPriority = config->workerSchedPriority,
+    };
+
+    pthread_once(&s_g_atForkOnce, cJSONLoggerRegisterAtFork);
+    pthread_once(&s_g_atExitOnce, cJSONLoggerRegisterAtExit);
+
+    if (cJSONLoggerConfigKeepsResources(config) != 0) {
+        return -1;
+    }
+
+    // Recorded before any resource is created, every existing resource was either created with the same settings or is
+    // about to be.
+    CJSONLoggerConfig_s initConfig;
+    char* initConfigStrings = NULL;
+    if (cJSONLoggerConfigCopy(config, &initConfig, &initConfigStrings) != 0) {
+        return -1;
+    }
+
+    free(s_g_initConfigStrings);
+    s_g_initConfig = initConfig;
+    s_g_initConfigStrings = initConfigStrings;
+
+    // Set before the first resource is created, cJSONLoggerDestroy() releases the ones created by a failed initialization.
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_destroyPending = 1;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    pthread_rwlock_wrlock(&s_g_workerPoolLock);
+    if (s_g_workerPool == NULL && s_g_workerPoolForked == 0 && config->workerThreads > 0) {
+        s_g_workerPool = workerPoolCreate(config->workerThreads, &threadAttr);
+        if (s_g_workerPool == NULL) {
+            pthread_rwlock_unlock(&s_g_workerPoolLock);
+            return -1;
+        }
+
+        // Kept to recreate the pool in forked children.
+        free((char*)s_g_workerThreadAttr.cpuList);
+        s_g_workerThreadAttr = threadAttr;
+        s_g_workerThreadAttr.cpuList = threadAttr.cpuList != NULL ? strdup(threadAttr.cpuList) : NULL;
+        s_g_workerThreadCount = config->workerThreads;
+    }
+
+    // The periodic flush runs on an idle worker, its own timer thread is only a fallback without a worker pool.
+    if (s_g_workerPool != NULL && s_g_flushTimer == NULL && s_g_flushPeriodic == 0 && config->flushIntervalMs != 0) {
+        workerPoolSetPeriodic(s_g_workerPool, config->flushIntervalMs, cJSONLoggerFlushTimer, NULL);
+        s_g_flushPeriodic = 1;
+    }
+
+    else if (s_g_flushTimer == NULL && s_g_flushPeriodic == 0 && config->flushIntervalMs != 0) {
+        s_g_flushTimer = loggerTimerCreate(config->flushIntervalMs, &threadAttr, cJSONLoggerFlushTimer, NULL);
+        if (s_g_flushTimer == NULL) {
+            pthread_rwlock_unlock(&s_g_workerPoolLock);
+            return -1;
+        }
+    }
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    pthread_rwlock_wrlock(&s_g_shmSinkLock);
+    if (s_g_shmSink == NULL && config->shmName != NULL) {
+        s_g_shmSink = shmSinkOpen(config->shmName, shmCapacity, config->timeFormat);
+        if (s_g_shmSink == NULL) {
+            pthread_rwlock_unlock(&s_g_shmSinkLock);
+            return -1;
+        }
+    }
+    int hasShmSink = s_g_shmSink != NULL;
+    pthread_rwlock_unlock(&s_g_shmSinkLock);
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_hasShmSink = hasShmSink;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    pthread_rwlock_wrlock(&s_g_flightRecorderLock);
+    if (s_g_flightRecorder == NULL && config->flightRecorderCapacity != 0) {
+        s_g_flightRecorder = flightRecorderCreate(config->flightRecorderCapacity, config->flightRecorderTriggerLevel, config->flightRecorderPostRecords);
+        if (s_g_flightRecorder == NULL) {
+            pthread_rwlock_unlock(&s_g_flightRecorderLock);
+            return -1;
+        }
+    }
+    int hasFlightRecorder = s_g_flightRecorder != NULL;
+    pthread_rwlock_unlock(&s_g_flightRecorderLock);
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_hasFlightRecorder = hasFlightRecorder;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    pthread_rwlock_wrlock(&s_g_sinksLock);
+    int sinkRes = 0;
+    if (s_g_treeSink == NULL && config->filePath != NULL) {
+        s_g_treeSink = sinkCreate(&s_g_treeSinkOps, NULL, __CJSON_LOG_LEVEL_START, 0, 0);
+        sinkRes = sinksAdd(s_g_treeSink);
+        if (sinkRes != 0) {
+            s_g_treeSink = NULL;
+        }
+    }
+
+    if (sinkRes == 0 && s_g_socketSink == NULL && config->socketPath != NULL) {
+        s_g_socketSink = socketSinkCreate(config->socketPath, __CJSON_LOG_LEVEL_START, config->socketQueueCapacity, config->socketBatchSize);
+        sinkRes = sinksAdd(s_g_socketSink);
+        if (sinkRes != 0) {
+            s_g_socketSink = NULL;
+        }
+    }
+    pthread_rwlock_unlock(&s_g_sinksLock);
+
+    if (sinkRes != 0) {
+        return -1;
+    }
+
+    // Set before the log generation is bumped below, so the next dump prints the time stamps in the new format.
+    formatSetTimeFormat(config->timeFormat);
+    atomic_store_explicit(&s_g_sequenceNumbers, config->sequenceNumbers != 0, memory_order_relaxed);
+    atomic_store_explicit(&s_g_threadIds, config->threadIds != 0, memory_order_relaxed);
+
+    // The logs of a store dropped by the new configuration are written to the previous output file first.
+    if (config->filePath == NULL) {
+        pthread_rwlock_rdlock(&s_g_sinksLock);
+        if (s_g_treeSink != NULL) {
+            sinkFlush(s_g_treeSink);
+        }
+        pthread_rwlock_unlock(&s_g_sinksLock);
+    }
+
+    // Without an output file the logs only go to the sinks, no tree is kept in memory.
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    if (s_g_logStore == NULL && config->filePath != NULL) {
+        s_g_logStore = logStoreCreate(preallocLogs);
+        CJSON_LOGGER_ASSERT_NEQ(s_g_logStore, NULL);
+
+        // The output file does not hold the new tree yet, the next dump writes it.
+        s_g_logGeneration++;
+        if (s_g_logStore != NULL) {
+            s_g_logStore->baseGeneration = s_g_logGeneration;
+        }
+    }
+
+    else if (s_g_logStore != NULL && config->filePath == NULL) {
+        logStoreDelete(s_g_logStore);
+        s_g_logStore = NULL;
+    }
+
+    else if (s_g_logStore != NULL) {
+        int res = logStorePrealloc(s_g_logStore, preallocLogs);
+        CJSON_LOGGER_ASSERT_EQ(res, 0);
+
+        // The output file may have changed, the next dump writes it.
+        s_g_logGeneration++;
+    }
+    int hasLogStore = s_g_logStore != NULL;
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    cJSONLoggerSetLogLevel(config->logLevel);
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_hasLogStore = hasLogStore;
+    if (s_g_filePath != NULL) {
+        free(s_g_filePath);
+    }
+
+    s_g_filePath = NULL;
+    if (config->filePath != NULL) {
+        s_g_filePath = strdup(config->filePath);
+        CJSON_LOGGER_ASSERT_NEQ(s_g_filePath, NULL);
+    }
+
+    s_g_forkMode = config->forkMode;
+    s_g_rotateLogCount = rotateLogCount;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    if (config->preallocate != 0) {
+        cJSONLoggerWarmUp();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Drop the lazy configuration.
+ *
+ * @note Called with the lazy configuration lock held.
+ */
+static void cJSONLoggerLazyConfigRelease(void)
+{
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_lazyInitPending = 0;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    free(s_g_lazyConfigStrings);
+    s_g_lazyConfigStrings = NULL;
+    memset(&s_g_lazyConfig, 0, sizeof(CJSONLoggerConfig_s));
+}
+
+/**
+ * @brief Record a checked configuration, applied by the first admitted log.
+ *
+ * @note Only the log level is applied now, so the logs can be admitted.
+ *
+ * @param config The logger configuration.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int cJSONLoggerLazyConfigSave(const CJSONLoggerConfig_s* config)
+{
+    CJSONLoggerConfig_s lazyConfig;
+    char* lazyConfigStrings = NULL;
+    if (cJSONLoggerConfigCopy(config, &lazyConfig, &lazyConfigStrings) != 0) {
+        return -1;
+    }
+
+    pthread_once(&s_g_atForkOnce, cJSONLoggerRegisterAtFork);
+
+    pthread_mutex_lock(&s_g_lazyConfigLock);
+    cJSONLoggerLazyConfigRelease();
+    s_g_lazyConfig = lazyConfig;
+    s_g_lazyConfigStrings = lazyConfigStrings;
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    if (config->logLevel > __CJSON_LOG_LEVEL_START && config->logLevel < __CJSON_LOG_LEVEL_END) {
+        s_g_logLevel = config->logLevel;
+    }
+    s_g_lazyInitPending = 1;
     pthread_mutex_unlock(&s_g_cLoggerMutex);
+    pthread_mutex_unlock(&s_g_lazyConfigLock);
+
+    return 0;
 }
 
-void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...)
+/**
+ * @brief Complete a lazy initialization, does nothing if none is pending.
+ *
+ * @return int, 0 in case of success or if none is pending, negative value in case of failure.
+ */
+static int cJSONLoggerLazyInit(void)
 {
+    pthread_mutex_lock(&s_g_lazyConfigLock);
     pthread_mutex_lock(&s_g_cLoggerMutex);
-    if (logLevel > __CJSON_LOG_LEVEL_START && logLevel > s_g_logLevel && logLevel < __CJSON_LOG_LEVEL_END) {
-        pthread_mutex_unlock(&s_g_cLoggerMutex);
-        return;
+    int lazyInitPending = s_g_lazyInitPending;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    // A failure (e.g. the shared memory ring or the thread attributes) can only show up now, the configuration is dropped
+    // and the logs keep going to whatever was created, released by cJSONLoggerDestroy().
+    int res = 0;
+    if (lazyInitPending != 0) {
+        res = cJSONLoggerInitNow(&s_g_lazyConfig);
+        if (res != 0) {
+            CJSON_LOGGER_REPORT_ERROR("the lazy initialization failed");
+        }
+        cJSONLoggerLazyConfigRelease();
+    }
+    pthread_mutex_unlock(&s_g_lazyConfigLock);
+
+    return res;
+}
+
+int cJSONLoggerInitWithConfig(const CJSONLoggerConfig_s* config)
+{
+    if (cJSONLoggerConfigValidate(config) != 0) {
+        return -1;
+    }
+
+    if (config->lazyInit != 0) {
+        return cJSONLoggerLazyConfigSave(config);
+    }
+
+    pthread_mutex_lock(&s_g_lazyConfigLock);
+    cJSONLoggerLazyConfigRelease();
+    int res = cJSONLoggerInitNow(config);
+    pthread_mutex_unlock(&s_g_lazyConfigLock);
+
+    return res;
+}
+
+int cJSONLoggerInitFromFile(const char* configPath)
+{
+    ConfigFile_s configFile;
+    if (configFileLoad(configPath, &configFile) != 0) {
+        return -1;
+    }
+
+    int res = cJSONLoggerInitWithConfig(&configFile.config);
+    for (size_t i = 0; res == 0 && i < configFile.sinkCount; i++) {
+        res = cJSONLoggerAddSink(&configFile.sinks[i]);
+    }
+
+    for (size_t i = 0; res == 0 && i < configFile.pathCount; i++) {
+        if (configFile.paths[i].capacity != 0) {
+            res = cJSONLoggerSetNodeCapacity(configFile.paths[i].jsonPath, configFile.paths[i].jsonPathDepth, configFile.paths[i].capacity);
+        }
+
+        if (res == 0 && configFile.paths[i].reserve != 0) {
+            res = cJSONLoggerDeclarePath(configFile.paths[i].jsonPath, configFile.paths[i].jsonPathDepth, configFile.paths[i].reserve);
+        }
+    }
+
+    if (res == 0) {
+        res = cJSONLoggerApplyRuntimeConfig(&configFile);
+    }
+
+    configFileRelease(&configFile);
+
+    return res;
+}
+
+int cJSONLoggerWatchConfigFile(const char* configPath)
+{
+    if (configPath == NULL) {
+        configPath = getenv(CONFIG_FILE_ENV);
+    }
+
+    ConfigFile_s configFile;
+    if (configPath == NULL || configFileLoad(configPath, &configFile) != 0) {
+        return -1;
+    }
+
+    int res = cJSONLoggerLazyInit();
+    if (res == 0) {
+        res = cJSONLoggerApplyRuntimeConfig(&configFile);
+    }
+    configFileRelease(&configFile);
+    if (res != 0) {
+        return -1;
     }
+
+    // The watcher threads get the scheduling attributes of the worker threads.
+    pthread_rwlock_wrlock(&s_g_workerPoolLock);
+    ConfigWatcher_s* configWatcher = s_g_configWatcher;
+    s_g_configWatcher = configWatcherCreate(configPath, &s_g_workerThreadAttr, cJSONLoggerReloadConfigFile, NULL);
+    res = s_g_configWatcher != NULL ? 0 : -1;
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    s_g_destroyPending = 1;
     pthread_mutex_unlock(&s_g_cLoggerMutex);
 
-    if (strlen(fmt) > MAX_LOG_MSG_LEN - 1) {
+    configWatcherDestroy(configWatcher);
+
+    return res;
+}
+
+int cJSONLoggerAddSink(const CJSONLoggerSinkConfig_s* sinkConfig)
+{
+    if (sinkConfig == NULL || sinkConfig->logLevel >= __CJSON_LOG_LEVEL_END || sinkConfig->mostSevereLogLevel >= __CJSON_LOG_LEVEL_END) {
+        return -1;
+    }
+
+    // The severity range must not be empty, a sink following the logger is checked against the logger level when logging.
+    if (sinkConfig->mostSevereLogLevel != __CJSON_LOG_LEVEL_START && sinkConfig->logLevel != __CJSON_LOG_LEVEL_START
+        && sinkConfig->mostSevereLogLevel > sinkConfig->logLevel) {
+        return -1;
+    }
+
+    if (cJSONLoggerLazyInit() != 0) {
+        return -1;
+    }
+
+    StreamSinkRotation_s rotation = {
+        .maxRecords = sinkConfig->rotateRecords,
+        .maxSeconds = sinkConfig->rotateSeconds,
+        .maxFiles = sinkConfig->rotateFiles,
+    };
+
+    Sink_s* sink = NULL;
+    switch (sinkConfig->type) {
+    case CJSON_LOGGER_SINK_NDJSON:
+        if (sinkConfig->path == NULL) {
+            return -1;
+        }
+        sink = streamSinkCreate(sinkConfig->path, &rotation, sinkConfig->logLevel, sinkConfig->queueCapacity, sinkConfig->batchSize);
+        break;
+    case CJSON_LOGGER_SINK_STDERR:
+        sink = streamSinkCreate(NULL, NULL, sinkConfig->logLevel, sinkConfig->queueCapacity, sinkConfig->batchSize);
+        break;
+    case CJSON_LOGGER_SINK_SOCKET:
+        sink = socketSinkCreate(sinkConfig->path, sinkConfig->logLevel, sinkConfig->queueCapacity, sinkConfig->batchSize);
+        break;
+    case CJSON_LOGGER_SINK_CALLBACK:
+        sink = callbackSinkCreate(sinkConfig->callback, sinkConfig->userData, sinkConfig->logLevel, sinkConfig->queueCapacity, sinkConfig->batchSize);
+        break;
+    default:
+        return -1;
+    }
+
+    if (sink != NULL) {
+        sinkSetMostSevereLogLevel(sink, sinkConfig->mostSevereLogLevel);
+    }
+
+    pthread_rwlock_wrlock(&s_g_sinksLock);
+    int res = sinksAdd(sink);
+    pthread_rwlock_unlock(&s_g_sinksLock);
+
+    return res;
+}
+
+void cJSONLoggerDestroy()
+{
+    // Held until the end, an initialization waits for the destruction to complete.
+    pthread_mutex_lock(&s_g_lazyConfigLock);
+    cJSONLoggerLazyConfigRelease();
+
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    int destroyPending = s_g_destroyPending;
+    s_g_destroyPending = 0;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    if (destroyPending == 0) {
+        pthread_mutex_unlock(&s_g_lazyConfigLock);
         return;
     }
 
+    // Detach the pool before destroying it, the queued tasks (e.g. a pending rotation) drain without it.
+    pthread_rwlock_wrlock(&s_g_workerPoolLock);
+    LoggerTimer_s* flushTimer = s_g_flushTimer;
+    s_g_flushTimer = NULL;
+    s_g_flushPeriodic = 0;
+    ConfigWatcher_s* configWatcher = s_g_configWatcher;
+    s_g_configWatcher = NULL;
+    WorkerPool_s* workerPool = s_g_workerPool;
+    s_g_workerPool = NULL;
+    s_g_workerPoolForked = 0;
+    free((char*)s_g_workerThreadAttr.cpuList);
+    memset(&s_g_workerThreadAttr, 0, sizeof(LoggerThreadAttr_s));
+    s_g_workerThreadAttr.nice = CJSON_LOGGER_NICE_INHERIT;
+    s_g_workerThreadCount = 0;
+    pthread_rwlock_unlock(&s_g_workerPoolLock);
+
+    // The watcher and the timer are stopped first, a reload or a flush in progress still uses the logger, the pool completes its own.
+    configWatcherDestroy(configWatcher);
+    loggerTimerDestroy(flushTimer);
+    workerPoolDestroy(workerPool);
+    runtimeConfigPublish(NULL);
+
+    pthread_rwlock_wrlock(&s_g_shmSinkLock);
+    shmSinkClose(s_g_shmSink);
+    s_g_shmSink = NULL;
+    pthread_rwlock_unlock(&s_g_shmSinkLock);
+
+    // The records kept by the flight recorder were never triggered, they are dropped.
+    pthread_rwlock_wrlock(&s_g_flightRecorderLock);
+    flightRecorderDestroy(s_g_flightRecorder);
+    s_g_flightRecorder = NULL;
+    pthread_rwlock_unlock(&s_g_flightRecorderLock);
+
+    // A clean JSON tree is already in the output file and a tree that took no log since the initialization is not written,
+    // only the queued records of the other sinks are.
     pthread_mutex_lock(&s_g_rootNodeMutex);
-    if (s_g_rootNode == NULL) {
-        pthread_mutex_unlock(&s_g_rootNodeMutex);
-        return;
+    int dirty = s_g_logStore != NULL && s_g_logGeneration != s_g_dumpedGeneration && s_g_logGeneration != s_g_logStore->baseGeneration;
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+        if (s_g_sinks[i] != s_g_treeSink || dirty != 0) {
+            sinkFlush(s_g_sinks[i]);
+        }
     }
-    cJSON* node = s_g_rootNode;
+    pthread_rwlock_unlock(&s_g_sinksLock);
+
+    pthread_rwlock_wrlock(&s_g_sinksLock);
+    for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+        sinkDestroy(s_g_sinks[i]);
+        s_g_sinks[i] = NULL;
+    }
+    s_g_sinkCount = 0;
+    s_g_treeSink = NULL;
+    s_g_socketSink = NULL;
+    pthread_rwlock_unlock(&s_g_sinksLock);
+
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    logStoreDelete(s_g_logStore);
+    s_g_logStore = NULL;
+    s_g_dumpedGeneration = s_g_logGeneration;
     pthread_mutex_unlock(&s_g_rootNodeMutex);
 
-    va_list args;
-    va_start(args, fmt);
+    pthread_mutex_lock(&s_g_cLoggerMutex);
+    if (s_g_filePath != NULL) {
+        free(s_g_filePath);
+    }
+    s_g_filePath = NULL;
+
+    rotatedFilesQueueDelete(s_g_rotatedFilesQueue);
+    s_g_rotatedFilesQueue = NULL;
+    s_g_logCount = 0;
+    s_g_rotatePending = 0;
+    s_g_forkMode = CJSON_LOGGER_FORK_INHERIT;
+    s_g_rotateLogCount = MAX_LOG_COUNT;
+    s_g_logLevel = __CJSON_LOG_LEVEL_START;
+    s_g_sinksLogLevel = __CJSON_LOG_LEVEL_START;
+    s_g_recordSinkCount = 0;
+    s_g_hasLogStore = 0;
+    s_g_hasShmSink = 0;
+    s_g_hasFlightRecorder = 0;
+    pthread_mutex_unlock(&s_g_cLoggerMutex);
+
+    formatSetTimeFormat(CJSON_LOGGER_TIME_LOCAL);
+    atomic_store_explicit(&s_g_sequenceNumbers, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_g_recordSequence, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_g_threadIds, 0, memory_order_relaxed);
+
+    free(s_g_initConfigStrings);
+    s_g_initConfigStrings = NULL;
+    memset(&s_g_initConfig, 0, sizeof(CJSONLoggerConfig_s));
+    pthread_mutex_unlock(&s_g_lazyConfigLock);
+}
+
+/**
+ * @brief Log a message to the cJSON logger, see cJSONLoggerLog().
+ *
+ * @param runtimeConfig The runtime configuration snapshot read for the log, NULL if none.
+ * @param logLevel The log level severity.
+ * @param fmt The log message format.
+ * @param args Additional arguments for the format.
+ */
+static void cJSONLoggerLogArgs(const RuntimeConfig_s* runtimeConfig, CJSON_LOG_LEVEL_E logLevel, const char* fmt, va_list args)
+{
+    CJSON_LOG_LEVEL_E runtimeLogLevel = runtimeConfig != NULL ? runtimeConfig->mostVerboseLogLevel : __CJSON_LOG_LEVEL_START;
+
+    LogTargets_s targets;
+    int lazyInitPending = logTargetsRead(&targets);
+
+    if (logLevelEnabled(logLevel, targets.logLevel) == 0 && logLevelEnabled(logLevel, targets.sinksLogLevel) == 0
+        && logLevelEnabled(logLevel, runtimeLogLevel) == 0) {
+        return;
+    }
+
+    // The lazy initialization creates the destinations, they are read again.
+    if (lazyInitPending != 0) {
+        cJSONLoggerLazyInit();
+        logTargetsRead(&targets);
+    }
+
+    if (strlen(fmt) > MAX_LOG_MSG_LEN - 1) {
+        return;
+    }
+
+    if (targets.hasLogStore == 0 && targets.hasShmSink == 0 && targets.recordSinkCount == 0) {
+        return;
+    }
 
     LogInfo_s logInfo = { 0 };
     logInfo.logLevel = logLevel;
 
     struct timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
-
-    struct tm tmInfo;
-    localtime_r(&ts.tv_sec, &tmInfo);
-
-    snprintf(logInfo.timeStamp, sizeof(logInfo.timeStamp), "%d-%d-%d %d:%d:%d.%ld",
-        tmInfo.tm_year + 1900,
-        tmInfo.tm_mon + 1,
-        tmInfo.tm_mday,
-        tmInfo.tm_hour,
-        tmInfo.tm_min,
-        tmInfo.tm_sec,
-        ts.tv_nsec);
+    logInfo.timeStamp = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
 
     if (strncmp(fmt, "$$%s$$%s$$%d$$", strlen("$$%s$$%s$$%d$$")) == 0) {
         logInfo.fileName = va_arg(args, char*);
@@ -453,6 +4013,9 @@ void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...)
         fmt += strlen("$$%s$$%s$$%d$$");
     }
 
+    const char* jsonPath[MAX_JSON_PATH_DEPTH] = { 0 };
+    size_t jsonPathDepth = 0;
+
     char logMsgFmt[MAX_LOG_MSG_LEN] = { 0 };
     char* pLogMsgFmt = logMsgFmt;
 
@@ -466,14 +4029,13 @@ void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...)
                 if (strnlen(logMsgFmt, MAX_LOG_MSG_LEN) != 0) {
                     char logMsg[MAX_LOG_MSG_LEN] = { 0 };
                     vsnprintf(logMsg, sizeof(logMsg) - 1, logMsgFmt, args);
-                    cJSONLoggerPushLog(node, &logInfo, logMsg);
+                    cJSONLoggerPushLog(jsonPath, jsonPathDepth, &logInfo, logMsg, &targets, runtimeConfig);
 
                     memset(logMsgFmt, 0, sizeof(logMsgFmt));
                     pLogMsgFmt = logMsgFmt;
                 }
 
-                char* c = va_arg(args, char*);
-                node = createJsonObject(node, c);
+                jsonPath[jsonPathDepth++] = va_arg(args, char*);
                 break;
             }
 
@@ -497,114 +4059,247 @@ void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...)
     if (strnlen(logMsgFmt, MAX_LOG_MSG_LEN) > 0) {
         char logMsg[MAX_LOG_MSG_LEN] = { 0 };
         vsnprintf(logMsg, sizeof(logMsg) - 1, logMsgFmt, args);
-        cJSONLoggerPushLog(node, &logInfo, logMsg);
+        cJSONLoggerPushLog(jsonPath, jsonPathDepth, &logInfo, logMsg, &targets, runtimeConfig);
     }
+}
+
+void cJSONLoggerLog(CJSON_LOG_LEVEL_E logLevel, const char* fmt, ...)
+{
+    // The runtime configuration is read without locks, a reload never blocks the log.
+    unsigned int runtimeEpoch = 0;
+    const RuntimeConfig_s* runtimeConfig = runtimeConfigReadLock(&runtimeEpoch);
 
+    va_list args;
+    va_start(args, fmt);
+    cJSONLoggerLogArgs(runtimeConfig, logLevel, fmt, args);
     va_end(args);
+
+    if (runtimeConfig != NULL) {
+        runtimeConfigReadUnlock(runtimeEpoch);
+    }
 }
 
 void cJSONLoggerDump()
 {
-    pthread_mutex_lock(&s_g_rootNodeMutex);
-    char* string = cJSON_Print(s_g_rootNode);
-    pthread_mutex_unlock(&s_g_rootNodeMutex);
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+        sinkFlush(s_g_sinks[i]);
+    }
+    pthread_rwlock_unlock(&s_g_sinksLock);
+}
 
-    if (string == NULL) {
-        return;
+void cJSONLoggerRotate()
+{
+    pthread_rwlock_rdlock(&s_g_sinksLock);
+    for (unsigned int i = 0; i < s_g_sinkCount; i++) {
+        sinkRotate(s_g_sinks[i]);
     }
+    pthread_rwlock_unlock(&s_g_sinksLock);
+}
 
+void cJSONLoggerSetLogLevel(CJSON_LOG_LEVEL_E logLevel)
+{
     pthread_mutex_lock(&s_g_cLoggerMutex);
-    FILE* file = fopen(s_g_filePath, "w");
-    CJSON_LOGGER_ASSERT_NEQ(file, NULL);
+    if (logLevel > __CJSON_LOG_LEVEL_START && logLevel < __CJSON_LOG_LEVEL_END) {
+        s_g_logLevel = logLevel;
+    }
     pthread_mutex_unlock(&s_g_cLoggerMutex);
+}
 
-    fprintf(file, "%s", string);
+void cJSONLoggerGetDefaultQuery(CJSONLoggerQuery_s* query)
+{
+    if (query == NULL) {
+        return;
+    }
 
-    fclose(file);
-    free(string);
+    memset(query, 0, sizeof(CJSONLoggerQuery_s));
+    query->logLevel = __CJSON_LOG_LEVEL_START;
 }
 
-void cJSONLoggerRotate()
+int cJSONLoggerQuery(const CJSONLoggerQuery_s* query, CJSONLoggerRecordCallback callback, void* userData)
 {
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
+    if (query == NULL || callback == NULL || query->logLevel >= __CJSON_LOG_LEVEL_END || query->jsonPathDepth > MAX_JSON_PATH_DEPTH
+        || (query->jsonPathDepth != 0 && query->jsonPath == NULL)) {
+        return -1;
+    }
 
-    struct tm tmInfo;
-    localtime_r(&ts.tv_sec, &tmInfo);
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    const LogStore_s* store = s_g_logStore;
+    LogQuery_s* logQuery = logQueryCreate(store);
+    if (logQuery == NULL) {
+        pthread_mutex_unlock(&s_g_rootNodeMutex);
+        return -1;
+    }
 
-    char timeStr[MAX_TIME_STR_LEN] = { 0 };
-    snprintf(timeStr, sizeof(timeStr), "%d_%d_%d_%ld",
-        tmInfo.tm_hour,
-        tmInfo.tm_min,
-        tmInfo.tm_sec,
-        ts.tv_nsec);
+    logQuery->logLevelMask = UINT8_MAX;
+    if (query->logLevel != __CJSON_LOG_LEVEL_START) {
+        logQuery->logLevelMask = 0;
+        for (unsigned int logLevel = 0; logLevel < 8; logLevel++) {
+            if (logLevelEnabled((CJSON_LOG_LEVEL_E)logLevel, query->logLevel) != 0) {
+                logQuery->logLevelMask |= logLevelMaskBit(logLevel);
+            }
+        }
+    }
 
-    pthread_mutex_lock(&s_g_cLoggerMutex);
-    s_g_logCount = 0;
+    logQuery->fromTimeStamp = query->fromTimeStamp;
+    logQuery->toTimeStamp = query->toTimeStamp != 0 ? query->toTimeStamp : INT64_MAX;
+    logQuery->maxRecords = query->maxRecords != 0 ? query->maxRecords : SIZE_MAX;
+    logQuery->callSiteMask = UINT64_MAX;
 
-    if (s_g_rotatedFilesQueue == NULL) {
-        s_g_rotatedFilesQueue = (Queue_s*)calloc(1, sizeof(Queue_s));
-        CJSON_LOGGER_ASSERT_NEQ(s_g_rotatedFilesQueue, NULL);
+    const LogNode_s* node = store != NULL ? store->root : NULL;
+    for (size_t i = 0; i < query->jsonPathDepth && node != NULL; i++) {
+        node = logNodeFindChild(node, query->jsonPath[i]);
+        if (node != NULL) {
+            logQuery->jsonPath[i] = node->name;
+        }
     }
 
-    size_t rotatedFileLen = strlen(s_g_filePath) + strnlen(timeStr, MAX_TIME_STR_LEN) + 2;
-    char* rotatedFilePath = (char*)malloc(rotatedFileLen);
-    CJSON_LOGGER_ASSERT_NEQ(rotatedFilePath, NULL);
+    int res = 0;
+    uint8_t* callSiteMatches = NULL;
+    if (node != NULL && (query->fileName != NULL || query->funcName != NULL || query->fileLine != 0)) {
+        // Resolve the call site filter once, the logs only hold call site ids.
+        callSiteMatches = (uint8_t*)calloc(store->callSiteCount + 1, sizeof(uint8_t));
+        CJSON_LOGGER_ASSERT_NEQ(callSiteMatches, NULL);
+        if (callSiteMatches == NULL) {
+            res = -1;
+        }
 
-    snprintf(rotatedFilePath, rotatedFileLen, "%s_%s", timeStr, s_g_filePath);
+        logQuery->callSiteMask = 0;
+        for (uint32_t i = 0; callSiteMatches != NULL && i < store->callSiteCount; i++) {
+            const CallSite_s* callSite = &store->callSites[i];
+            if ((query->fileName == NULL || (callSite->fileName != NULL && strcmp(callSite->fileName, query->fileName) == 0))
+                && (query->funcName == NULL || (callSite->funcName != NULL && strcmp(callSite->funcName, query->funcName) == 0))
+                && (query->fileLine == 0 || callSite->fileLine == query->fileLine)) {
+                callSiteMatches[i] = 1;
+                logQuery->callSiteMask |= 1ULL << (i % 64);
+            }
+        }
 
-    if (s_g_rotatedFilesQueue->currentSize < MAX_LOG_ROTATION_FILES) {
-        s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->tail] = strdup(rotatedFilePath);
+        logQuery->callSiteMatches = callSiteMatches;
+    }
 
-        CJSON_LOGGER_ASSERT_NEQ(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->tail], NULL);
+    if (res == 0 && node != NULL && logQuery->callSiteMask != 0) {
+        logNodeQuery(logQuery, node, query->jsonPathDepth);
+    }
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
 
-        s_g_rotatedFilesQueue->tail = (s_g_rotatedFilesQueue->tail + 1) % MAX_LOG_ROTATION_FILES;
-        s_g_rotatedFilesQueue->currentSize++;
+    free(callSiteMatches);
+
+    // The callback runs on the copies once the store is unlocked, it may log, dump or query again.
+    if (res == 0 && logQuery->failed == 0) {
+        logQueryDeliver(logQuery, callback, userData);
+        res = logQuery->matchCount > INT32_MAX ? INT32_MAX : (int)logQuery->matchCount;
     }
 
     else {
-        int res = remove(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head]);
+        res = -1;
+    }
+    logQueryDelete(logQuery);
 
-        CJSON_LOGGER_ASSERT_EQ(res, 0);
+    return res;
+}
 
-        free(s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head]);
-        s_g_rotatedFilesQueue->rotatedFiles[s_g_rotatedFilesQueue->head] = NULL;
-        s_g_rotatedFilesQueue->head = (s_g_rotatedFilesQueue->head + 1) % MAX_LOG_ROTATION_FILES;
-        s_g_rotatedFilesQueue->currentSize--;
+int cJSONLoggerSetNodeCapacity(const char* const* jsonPath, size_t jsonPathDepth, unsigned int capacity)
+{
+    if (jsonPathDepth > MAX_JSON_PATH_DEPTH || (jsonPathDepth != 0 && jsonPath == NULL)) {
+        return -1;
     }
 
-    FILE* file = fopen(rotatedFilePath, "w");
-    CJSON_LOGGER_ASSERT_NEQ(file, NULL);
+    if (cJSONLoggerLazyInit() != 0) {
+        return -1;
+    }
 
-    free(rotatedFilePath);
-    rotatedFilePath = NULL;
-    pthread_mutex_unlock(&s_g_cLoggerMutex);
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    LogNode_s* node = s_g_logStore != NULL ? s_g_logStore->root : NULL;
+    for (size_t i = 0; i < jsonPathDepth && node != NULL; i++) {
+        node = logNodeGetChild(node, jsonPath[i]);
+    }
+
+    int res = node != NULL ? logStoreSetRingCapacity(s_g_logStore, node, capacity) : -1;
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    return res;
+}
+
+int cJSONLoggerDeclarePath(const char* const* jsonPath, size_t jsonPathDepth, unsigned int logCapacity)
+{
+    if (jsonPathDepth > MAX_JSON_PATH_DEPTH || (jsonPathDepth != 0 && jsonPath == NULL)) {
+        return -1;
+    }
+
+    if (cJSONLoggerLazyInit() != 0) {
+        return -1;
+    }
 
     pthread_mutex_lock(&s_g_rootNodeMutex);
-    char* string = NULL;
-    if (s_g_rootNode != NULL) {
-        string = cJSON_Print(s_g_rootNode);
-        cJSON_Delete(s_g_rootNode);
-        s_g_rootNode = cJSON_CreateObject();
+    LogNode_s* node = s_g_logStore != NULL ? s_g_logStore->root : NULL;
+    for (size_t i = 0; i < jsonPathDepth && node != NULL; i++) {
+        node = logNodeGetChild(node, jsonPath[i]);
     }
+
+    int res = node != NULL ? logStoreDeclareNode(s_g_logStore, node, logCapacity) : -1;
     pthread_mutex_unlock(&s_g_rootNodeMutex);
 
-    if (string == NULL) {
-        return;
+    return res;
+}
+
+int cJSONLoggerTail(const char* const* jsonPath, size_t jsonPathDepth, size_t count, CJSONLoggerRecordCallback callback, void* userData)
+{
+    if (callback == NULL || jsonPathDepth > MAX_JSON_PATH_DEPTH || (jsonPathDepth != 0 && jsonPath == NULL)) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&s_g_rootNodeMutex);
+    LogQuery_s* logQuery = logQueryCreate(s_g_logStore);
+    if (logQuery == NULL) {
+        pthread_mutex_unlock(&s_g_rootNodeMutex);
+        return -1;
+    }
+
+    logQuery->maxRecords = SIZE_MAX;
+    const LogNode_s* node = s_g_logStore != NULL ? s_g_logStore->root : NULL;
+    for (size_t i = 0; i < jsonPathDepth && node != NULL; i++) {
+        node = logNodeFindChild(node, jsonPath[i]);
+        if (node != NULL) {
+            logQuery->jsonPath[i] = node->name;
+        }
+    }
+
+    if (node != NULL) {
+        unsigned int tailCount = count != 0 && count < node->logCount ? (unsigned int)count : node->logCount;
+        for (unsigned int i = node->logCount - tailCount; i < node->logCount && logQuery->failed == 0; i++) {
+            logQueryAppend(logQuery, node, jsonPathDepth, logNodeSlot(node, i));
+        }
     }
 
-    fprintf(file, "%s", string);
+    pthread_mutex_unlock(&s_g_rootNodeMutex);
+
+    // The callback runs on the copies once the store is unlocked, it may log, dump or tail again.
+    int res = -1;
+    if (logQuery->failed == 0) {
+        logQueryDeliver(logQuery, callback, userData);
+        res = logQuery->matchCount > INT32_MAX ? INT32_MAX : (int)logQuery->matchCount;
+    }
+    logQueryDelete(logQuery);
 
-    fclose(file);
-    free(string);
-    string = NULL;
+    return res;
 }
 
-void cJSONLoggerSetLogLevel(CJSON_LOG_LEVEL_E logLevel)
+void cJSONLoggerFlightRecorderTrigger()
 {
-    pthread_mutex_lock(&s_g_cLoggerMutex);
-    if (logLevel > __CJSON_LOG_LEVEL_START && logLevel < __CJSON_LOG_LEVEL_END) {
-        s_g_logLevel = logLevel;
+    unsigned int logCount = 0;
+
+    pthread_rwlock_rdlock(&s_g_flightRecorderLock);
+    if (s_g_flightRecorder != NULL) {
+        flightRecorderTrigger(s_g_flightRecorder);
+
+        pthread_mutex_lock(&s_g_rootNodeMutex);
+        if (s_g_logStore != NULL) {
+            flightRecorderDrain(s_g_flightRecorder, flightRecorderPersistRecords, &logCount);
+        }
+        pthread_mutex_unlock(&s_g_rootNodeMutex);
     }
-    pthread_mutex_unlock(&s_g_cLoggerMutex);
-}
\ No newline at end of file
+    pthread_rwlock_unlock(&s_g_flightRecorderLock);
+
+    logCountAdd(logCount);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file cJSONLoggerAssert.h
+ *
+ * @brief This file contains the assertion macros shared by the cJSON logger library sources.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_ASSERT_H
+#define CJSON_LOGGER_ASSERT_H
+
+#include "cJSONLogger.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+/**
+ * @def CJSONLOGGER_DEBUG
+ *
+ * @brief When building for debugging.
+ */
+#ifdef CJSONLOGGER_DEBUG
+
+/**
+ * @def CJSON_LOGGER_ASSERT_EQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Does an assertion when the expression is equal to the expected value.
+ */
+#define CJSON_LOGGER_ASSERT_EQ(expr, expected) \
+    do {                                       \
+        assert(expr == expected);              \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_ASSERT_NEQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Does an assertion when the expression is not equal to the expected value.
+ */
+#define CJSON_LOGGER_ASSERT_NEQ(expr, expected) \
+    do {                                        \
+        assert(expr != expected);               \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_REPORT_ERROR
+ *
+ * @param message The error message.
+ *
+ * @brief Prints an error message, for the failures that can not be returned to the caller and must not abort.
+ */
+#define CJSON_LOGGER_REPORT_ERROR(message)                                                       \
+    do {                                                                                         \
+        fprintf(stderr, "Error at [%s:%s:%d]: %s\n", __FILENAME__, __func__, __LINE__, message); \
+    } while (0);
+
+#endif
+
+/**
+ * @def CJSONLOGGER_RELEASE
+ *
+ * @brief When building for a release.
+ */
+#ifdef CJSONLOGGER_RELEASE
+
+/**
+ * @def CJSON_LOGGER_ASSERT_EQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Prints an error message if the expression is not equal to the expected value.
+ */
+#define CJSON_LOGGER_ASSERT_EQ(expr, expected)                                                     \
+    do {                                                                                           \
+        if (expr != expected) {                                                                    \
+            fprintf(stderr, "Assertion at [%s:%s:%d] failed\n", __FILENAME__, __func__, __LINE__); \
+        }                                                                                          \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_ASSERT_NEQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Prints an error message if the expression is equal to the expected value.
+ */
+#define CJSON_LOGGER_ASSERT_NEQ(expr, expected)                                                    \
+    do {                                                                                           \
+        if (expr == expected) {                                                                    \
+            fprintf(stderr, "Assertion at [%s:%s:%d] failed\n", __FILENAME__, __func__, __LINE__); \
+        }                                                                                          \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_REPORT_ERROR
+ *
+ * @param message The error message.
+ *
+ * @brief Prints an error message, for the failures that can not be returned to the caller and must not abort.
+ */
+#define CJSON_LOGGER_REPORT_ERROR(message)                                                       \
+    do {                                                                                         \
+        fprintf(stderr, "Error at [%s:%s:%d]: %s\n", __FILENAME__, __func__, __LINE__, message); \
+    } while (0);
+
+#endif
+
+/**
+ * @def CJSONLOGGER_DIST
+ *
+ * @brief When building for a distribution.
+ */
+#ifdef CJSONLOGGER_DIST
+
+/**
+ * @def CJSON_LOGGER_ASSERT_EQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Does nothing.
+ */
+#define CJSON_LOGGER_ASSERT_EQ(expr, expected) \
+    do {                                       \
+        if (expr != expected) {                \
+        }                                      \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_ASSERT_NEQ
+ *
+ * @param expr The expression to evaluate.
+ * @param expected The expected value.
+ *
+ * @brief Does nothing.
+ */
+#define CJSON_LOGGER_ASSERT_NEQ(expr, expected) \
+    do {                                        \
+        if (expr == expected) {                 \
+        }                                       \
+    } while (0);
+
+/**
+ * @def CJSON_LOGGER_REPORT_ERROR
+ *
+ * @param message The error message.
+ *
+ * @brief Does nothing.
+ */
+#define CJSON_LOGGER_REPORT_ERROR(message) \
+    do {                                   \
+        (void)(message);                   \
+    } while (0);
+
+#endif
+
+#endif // CJSON_LOGGER_ASSERT_H
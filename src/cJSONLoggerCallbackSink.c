@@ -0,0 +1,88 @@
+/**
+ * @file cJSONLoggerCallbackSink.c
+ *
+ * @brief This file contains the implementation of the sink handing the log records to a user callback.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerCallbackSink.h"
+#include "cJSONLoggerAssert.h"
+
+#include <stdlib.h>
+
+/**
+ * @struct CallbackSink
+ *
+ * @brief Context of a callback sink.
+ *
+ * @var callback The callback receiving the records.
+ * @var userData The user data passed to the callback.
+ */
+typedef struct CallbackSink {
+    CJSONLoggerRecordCallback callback;
+    void* userData;
+} CallbackSink_s;
+
+/**
+ * @brief Hand a batch of records to the callback of a callback sink.
+ *
+ * @param ctx The callback sink.
+ * @param records The records of the batch.
+ * @param count The number of records.
+ *
+ * @return size_t, the number of records handed to the callback.
+ */
+static size_t callbackSinkWriteBatch(void* ctx, const LogRecord_s* records, size_t count)
+{
+    CallbackSink_s* callbackSink = (CallbackSink_s*)ctx;
+    callbackSink->callback(records, count, callbackSink->userData);
+
+    return count;
+}
+
+/**
+ * @brief Close a callback sink.
+ *
+ * @param ctx The callback sink.
+ */
+static void callbackSinkClose(void* ctx)
+{
+    free(ctx);
+}
+
+/**
+ * @brief Operations of the callback sinks.
+ */
+static const SinkOps_s s_g_callbackSinkOps = {
+    .writeBatch = callbackSinkWriteBatch,
+    .flush = NULL,
+    .rotate = NULL,
+    .forkFresh = NULL,
+    .close = callbackSinkClose,
+};
+
+Sink_s* callbackSinkCreate(CJSONLoggerRecordCallback callback, void* userData, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize)
+{
+    if (callback == NULL || queueCapacity == 0) {
+        return NULL;
+    }
+
+    CallbackSink_s* callbackSink = (CallbackSink_s*)calloc(1, sizeof(CallbackSink_s));
+    CJSON_LOGGER_ASSERT_NEQ(callbackSink, NULL);
+    if (callbackSink == NULL) {
+        return NULL;
+    }
+
+    callbackSink->callback = callback;
+    callbackSink->userData = userData;
+
+    Sink_s* sink = sinkCreate(&s_g_callbackSinkOps, callbackSink, logLevel, queueCapacity, batchSize);
+    if (sink == NULL) {
+        callbackSinkClose(callbackSink);
+    }
+
+    return sink;
+}
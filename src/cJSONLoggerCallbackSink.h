@@ -0,0 +1,29 @@
+/**
+ * @file cJSONLoggerCallbackSink.h
+ *
+ * @brief This file contains the interface of the sink handing the log records to a user callback.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_CALLBACK_SINK_H
+#define CJSON_LOGGER_CALLBACK_SINK_H
+
+#include "cJSONLoggerSink.h"
+
+/**
+ * @brief Create a sink handing the log records to a user callback in batches.
+ *
+ * @param callback The callback receiving the records.
+ * @param userData The user data passed to the callback.
+ * @param logLevel The log level severity threshold of the sink, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @param queueCapacity The number of records the queue of the sink can hold, a power of two.
+ * @param batchSize The number of queued records that triggers a call of the callback.
+ *
+ * @return Sink_s* ptr of the new sink, NULL in case of failure.
+ */
+Sink_s* callbackSinkCreate(CJSONLoggerRecordCallback callback, void* userData, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize);
+
+#endif // CJSON_LOGGER_CALLBACK_SINK_H
@@ -0,0 +1,485 @@
+/**
+ * @file cJSONLoggerConfigFile.c
+ *
+ * @brief This file contains the implementation used to load the configuration of the cJSON logger library from a file and the environment.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerConfigFile.h"
+#include "cJSONLoggerAssert.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/**
+ * @def MAX_CONFIG_FILE_LEN
+ *
+ * @brief Max size of a configuration file.
+ */
+#define MAX_CONFIG_FILE_LEN (1024 * 1024)
+
+/**
+ * @brief Names of the log levels, indexed by CJSON_LOG_LEVEL_E.
+ */
+static const char* const s_g_logLevelNames[] = { NULL, "CRITICAL", "ERROR", "WARN", "INFO", "DEBUG" };
+
+/**
+ * @brief Names of the scheduling policies, indexed by CJSON_LOGGER_SCHED_POLICY_E.
+ */
+static const char* const s_g_schedPolicyNames[] = { "INHERIT", "OTHER", "BATCH", "IDLE", "FIFO", "RR" };
+
+/**
+ * @brief Names of the fork modes, indexed by CJSON_LOGGER_FORK_MODE_E.
+ */
+static const char* const s_g_forkModeNames[] = { "INHERIT", "FRESH" };
+
+/**
+ * @brief Names of the time formats, indexed by CJSON_LOGGER_TIME_FORMAT_E.
+ */
+static const char* const s_g_timeFormatNames[] = { "LOCAL", "RFC3339", "RFC3339_UTC" };
+
+/**
+ * @brief Names of the sink types a configuration file can declare, indexed by CJSON_LOGGER_SINK_TYPE_E.
+ */
+static const char* const s_g_sinkTypeNames[] = { "NDJSON", "STDERR", "SOCKET" };
+
+/**
+ * @brief Read a whole file into a NUL terminated buffer.
+ *
+ * @param filePath The path of the file.
+ *
+ * @return char* ptr of the content, NULL in case of failure.
+ */
+static char* configFileRead(const char* filePath)
+{
+    FILE* file = fopen(filePath, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    char* data = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        length = ftell(file);
+    }
+
+    if (length >= 0 && length <= MAX_CONFIG_FILE_LEN && fseek(file, 0, SEEK_SET) == 0) {
+        data = (char*)malloc((size_t)length + 1);
+        CJSON_LOGGER_ASSERT_NEQ(data, NULL);
+    }
+
+    if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+
+    if (data != NULL) {
+        data[length] = '\0';
+    }
+
+    fclose(file);
+
+    return data;
+}
+
+/**
+ * @brief Look up a name in a table of names, case insensitive.
+ *
+ * @param name The name to look up.
+ * @param names The table of names, NULL entries are skipped.
+ * @param count The number of names.
+ * @param index Where the index of the name will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileLookupName(const char* name, const char* const* names, size_t count, int* index)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (names[i] != NULL && strcasecmp(name, names[i]) == 0) {
+            *index = (int)i;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int configFileParseLogLevel(const char* name, CJSON_LOG_LEVEL_E* logLevel)
+{
+    int index = 0;
+    if (name == NULL || configFileLookupName(name, s_g_logLevelNames, sizeof(s_g_logLevelNames) / sizeof(s_g_logLevelNames[0]), &index) != 0) {
+        return -1;
+    }
+
+    *logLevel = (CJSON_LOG_LEVEL_E)index;
+
+    return 0;
+}
+
+/**
+ * @brief Read an optional unsigned integer field of a JSON object.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param value Where the value will be stored, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileUint(const cJSON* object, const char* key, unsigned int* value)
+{
+    const cJSON* item = cJSON_GetObjectItemCaseSensitive(object, key);
+    if (item == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsNumber(item) == 0 || item->valuedouble < 0 || item->valuedouble > UINT_MAX || item->valuedouble != (double)(unsigned int)item->valuedouble) {
+        return -1;
+    }
+
+    *value = (unsigned int)item->valuedouble;
+
+    return 0;
+}
+
+/**
+ * @brief Read an optional integer field of a JSON object.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param value Where the value will be stored, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileInt(const cJSON* object, const char* key, int* value)
+{
+    const cJSON* item = cJSON_GetObjectItemCaseSensitive(object, key);
+    if (item == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsNumber(item) == 0 || item->valuedouble < INT_MIN || item->valuedouble > INT_MAX || item->valuedouble != (double)item->valueint) {
+        return -1;
+    }
+
+    *value = item->valueint;
+
+    return 0;
+}
+
+/**
+ * @brief Read an optional boolean field of a JSON object.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param value Where the value (0 or 1) will be stored, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileBool(const cJSON* object, const char* key, int* value)
+{
+    const cJSON* item = cJSON_GetObjectItemCaseSensitive(object, key);
+    if (item == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsBool(item) == 0) {
+        return -1;
+    }
+
+    *value = cJSON_IsTrue(item) != 0 ? 1 : 0;
+
+    return 0;
+}
+
+/**
+ * @brief Read an optional string field of a JSON object.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param value Where the string will be stored, owned by the object, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileString(const cJSON* object, const char* key, const char** value)
+{
+    const cJSON* item = cJSON_GetObjectItemCaseSensitive(object, key);
+    if (item == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsString(item) == 0) {
+        return -1;
+    }
+
+    *value = item->valuestring;
+
+    return 0;
+}
+
+/**
+ * @brief Read an optional field of a JSON object holding one of a table of names.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param names The table of names.
+ * @param count The number of names.
+ * @param index Where the index of the name will be stored, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileName(const cJSON* object, const char* key, const char* const* names, size_t count, int* index)
+{
+    const char* name = NULL;
+    if (configFileString(object, key, &name) != 0) {
+        return -1;
+    }
+
+    return name != NULL ? configFileLookupName(name, names, count, index) : 0;
+}
+
+/**
+ * @brief Read an optional log level field of a JSON object.
+ *
+ * @param object The JSON object.
+ * @param key The key of the field.
+ * @param logLevel Where the log level will be stored, untouched if the field is missing.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileLogLevel(const cJSON* object, const char* key, CJSON_LOG_LEVEL_E* logLevel)
+{
+    int index = (int)*logLevel;
+    int res = configFileName(object, key, s_g_logLevelNames, sizeof(s_g_logLevelNames) / sizeof(s_g_logLevelNames[0]), &index);
+    *logLevel = (CJSON_LOG_LEVEL_E)index;
+
+    return res;
+}
+
+/**
+ * @brief Read the logger configuration fields of the configuration file.
+ *
+ * @param doc The configuration file.
+ * @param config Where the configuration will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileLoadConfig(const cJSON* doc, CJSONLoggerConfig_s* config)
+{
+    int schedPolicy = (int)config->workerSchedPolicy;
+    int forkMode = (int)config->forkMode;
+    int timeFormat = (int)config->timeFormat;
+
+    int res = configFileLogLevel(doc, "logLevel", &config->logLevel);
+    res |= configFileString(doc, "filePath", &config->filePath);
+    res |= configFileUint(doc, "workerThreads", &config->workerThreads);
+    res |= configFileString(doc, "workerCpuList", &config->workerCpuList);
+    res |= configFileInt(doc, "workerNice", &config->workerNice);
+    res |= configFileName(doc, "workerSchedPolicy", s_g_schedPolicyNames, sizeof(s_g_schedPolicyNames) / sizeof(s_g_schedPolicyNames[0]), &schedPolicy);
+    res |= configFileInt(doc, "workerSchedPriority", &config->workerSchedPriority);
+    res |= configFileName(doc, "forkMode", s_g_forkModeNames, sizeof(s_g_forkModeNames) / sizeof(s_g_forkModeNames[0]), &forkMode);
+    res |= configFileString(doc, "shmName", &config->shmName);
+    res |= configFileUint(doc, "shmCapacity", &config->shmCapacity);
+    res |= configFileString(doc, "socketPath", &config->socketPath);
+    res |= configFileUint(doc, "socketQueueCapacity", &config->socketQueueCapacity);
+    res |= configFileUint(doc, "socketBatchSize", &config->socketBatchSize);
+    res |= configFileUint(doc, "flightRecorderCapacity", &config->flightRecorderCapacity);
+    res |= configFileLogLevel(doc, "flightRecorderTriggerLevel", &config->flightRecorderTriggerLevel);
+    res |= configFileUint(doc, "flightRecorderPostRecords", &config->flightRecorderPostRecords);
+    res |= configFileUint(doc, "rotateLogCount", &config->rotateLogCount);
+    res |= configFileUint(doc, "flushIntervalMs", &config->flushIntervalMs);
+    res |= configFileBool(doc, "preallocate", &config->preallocate);
+    res |= configFileBool(doc, "lazyInit", &config->lazyInit);
+    res |= configFileName(doc, "timeFormat", s_g_timeFormatNames, sizeof(s_g_timeFormatNames) / sizeof(s_g_timeFormatNames[0]), &timeFormat);
+    res |= configFileBool(doc, "sequenceNumbers", &config->sequenceNumbers);
+    res |= configFileBool(doc, "threadIds", &config->threadIds);
+
+    config->workerSchedPolicy = (CJSON_LOGGER_SCHED_POLICY_E)schedPolicy;
+    config->forkMode = (CJSON_LOGGER_FORK_MODE_E)forkMode;
+    config->timeFormat = (CJSON_LOGGER_TIME_FORMAT_E)timeFormat;
+
+    return res != 0 ? -1 : 0;
+}
+
+/**
+ * @brief Read the "sinks" array of the configuration file.
+ *
+ * @param doc The configuration file.
+ * @param configFile Where the sink configurations will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileLoadSinks(const cJSON* doc, ConfigFile_s* configFile)
+{
+    const cJSON* sinks = cJSON_GetObjectItemCaseSensitive(doc, "sinks");
+    if (sinks == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsArray(sinks) == 0) {
+        return -1;
+    }
+
+    size_t sinkCount = (size_t)cJSON_GetArraySize(sinks);
+    if (sinkCount == 0) {
+        return 0;
+    }
+
+    configFile->sinks = (CJSONLoggerSinkConfig_s*)calloc(sinkCount, sizeof(CJSONLoggerSinkConfig_s));
+    CJSON_LOGGER_ASSERT_NEQ(configFile->sinks, NULL);
+    if (configFile->sinks == NULL) {
+        return -1;
+    }
+
+    const cJSON* sink = NULL;
+    cJSON_ArrayForEach(sink, sinks)
+    {
+        CJSONLoggerSinkConfig_s* sinkConfig = &configFile->sinks[configFile->sinkCount++];
+        cJSONLoggerGetDefaultSinkConfig(sinkConfig);
+        if (cJSON_IsObject(sink) == 0) {
+            return -1;
+        }
+
+        int type = (int)sinkConfig->type;
+        int res = configFileName(sink, "type", s_g_sinkTypeNames, sizeof(s_g_sinkTypeNames) / sizeof(s_g_sinkTypeNames[0]), &type);
+        res |= configFileLogLevel(sink, "logLevel", &sinkConfig->logLevel);
+        res |= configFileLogLevel(sink, "mostSevereLogLevel", &sinkConfig->mostSevereLogLevel);
+        res |= configFileString(sink, "path", &sinkConfig->path);
+        res |= configFileUint(sink, "queueCapacity", &sinkConfig->queueCapacity);
+        res |= configFileUint(sink, "batchSize", &sinkConfig->batchSize);
+        res |= configFileUint(sink, "rotateRecords", &sinkConfig->rotateRecords);
+        res |= configFileUint(sink, "rotateSeconds", &sinkConfig->rotateSeconds);
+        res |= configFileUint(sink, "rotateFiles", &sinkConfig->rotateFiles);
+        sinkConfig->type = (CJSON_LOGGER_SINK_TYPE_E)type;
+
+        if (res != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Read the "paths" array of the configuration file.
+ *
+ * @param doc The configuration file.
+ * @param configFile Where the JSON node settings will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int configFileLoadPaths(const cJSON* doc, ConfigFile_s* configFile)
+{
+    const cJSON* paths = cJSON_GetObjectItemCaseSensitive(doc, "paths");
+    if (paths == NULL) {
+        return 0;
+    }
+
+    if (cJSON_IsArray(paths) == 0) {
+        return -1;
+    }
+
+    size_t pathCount = (size_t)cJSON_GetArraySize(paths);
+    if (pathCount == 0) {
+        return 0;
+    }
+
+    configFile->paths = (ConfigFilePath_s*)calloc(pathCount, sizeof(ConfigFilePath_s));
+    CJSON_LOGGER_ASSERT_NEQ(configFile->paths, NULL);
+    if (configFile->paths == NULL) {
+        return -1;
+    }
+
+    const cJSON* path = NULL;
+    cJSON_ArrayForEach(path, paths)
+    {
+        ConfigFilePath_s* configPath = &configFile->paths[configFile->pathCount++];
+        const cJSON* names = cJSON_GetObjectItemCaseSensitive(path, "path");
+        configPath->logLevel = __CJSON_LOG_LEVEL_START;
+        if (cJSON_IsObject(path) == 0 || cJSON_IsArray(names) == 0 || cJSON_GetArraySize(names) == 0
+            || configFileUint(path, "capacity", &configPath->capacity) != 0
+            || configFileUint(path, "reserve", &configPath->reserve) != 0
+            || configFileLogLevel(path, "logLevel", &configPath->logLevel) != 0
+            || configFileUint(path, "rateLimit", &configPath->rateLimit) != 0
+            || configFileUint(path, "rateBurst", &configPath->rateBurst) != 0) {
+            return -1;
+        }
+
+        configPath->jsonPath = (const char**)calloc((size_t)cJSON_GetArraySize(names), sizeof(const char*));
+        CJSON_LOGGER_ASSERT_NEQ(configPath->jsonPath, NULL);
+        if (configPath->jsonPath == NULL) {
+            return -1;
+        }
+
+        const cJSON* name = NULL;
+        cJSON_ArrayForEach(name, names)
+        {
+            if (cJSON_IsString(name) == 0) {
+                return -1;
+            }
+
+            configPath->jsonPath[configPath->jsonPathDepth++] = name->valuestring;
+        }
+    }
+
+    return 0;
+}
+
+int configFileLoad(const char* configPath, ConfigFile_s* configFile)
+{
+    memset(configFile, 0, sizeof(ConfigFile_s));
+    cJSONLoggerGetDefaultConfig(&configFile->config);
+
+    if (configPath == NULL) {
+        configPath = getenv(CONFIG_FILE_ENV);
+    }
+
+    if (configPath != NULL) {
+        char* data = configFileRead(configPath);
+        if (data == NULL) {
+            return -1;
+        }
+
+        configFile->doc = cJSON_Parse(data);
+        free(data);
+
+        if (cJSON_IsObject(configFile->doc) == 0
+            || configFileLoadConfig(configFile->doc, &configFile->config) != 0
+            || configFileLoadSinks(configFile->doc, configFile) != 0
+            || configFileLoadPaths(configFile->doc, configFile) != 0) {
+            configFileRelease(configFile);
+            return -1;
+        }
+    }
+
+    // The environment overrides the file, e.g. to raise the level of a single run.
+    const char* logLevel = getenv(LOG_LEVEL_ENV);
+    if (logLevel != NULL && configFileParseLogLevel(logLevel, &configFile->config.logLevel) != 0) {
+        configFileRelease(configFile);
+        return -1;
+    }
+
+    const char* filePath = getenv(FILE_PATH_ENV);
+    if (filePath != NULL) {
+        configFile->config.filePath = filePath;
+    }
+
+    return 0;
+}
+
+void configFileRelease(ConfigFile_s* configFile)
+{
+    for (size_t i = 0; i < configFile->pathCount; i++) {
+        free(configFile->paths[i].jsonPath);
+    }
+
+    free(configFile->paths);
+    free(configFile->sinks);
+    cJSON_Delete(configFile->doc);
+    memset(configFile, 0, sizeof(ConfigFile_s));
+}
@@ -0,0 +1,113 @@
+/**
+ * @file cJSONLoggerConfigFile.h
+ *
+ * @brief This file contains the interface used to load the configuration of the cJSON logger library from a file and the environment.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_CONFIG_FILE_H
+#define CJSON_LOGGER_CONFIG_FILE_H
+
+#include "cJSONLogger.h"
+
+#include <cJSON.h>
+
+/**
+ * @def CONFIG_FILE_ENV
+ *
+ * @brief Environment variable holding the path of the configuration file.
+ */
+#define CONFIG_FILE_ENV "CJSON_LOGGER_CONFIG"
+
+/**
+ * @def LOG_LEVEL_ENV
+ *
+ * @brief Environment variable overriding the log level of the configuration (e.g. "DEBUG").
+ */
+#define LOG_LEVEL_ENV "CJSON_LOGGER_LEVEL"
+
+/**
+ * @def FILE_PATH_ENV
+ *
+ * @brief Environment variable overriding the output file path of the configuration.
+ */
+#define FILE_PATH_ENV "CJSON_LOGGER_FILE"
+
+/**
+ * @struct ConfigFilePath
+ *
+ * @brief Settings of a JSON node declared by a configuration file.
+ *
+ * @var jsonPath The names of the JSON nodes.
+ * @var jsonPathDepth The number of names in the jsonPath.
+ * @var capacity The number of logs the node keeps, 0 to leave the node as is.
+ * @var reserve The number of logs allocated for the node up front, 0 to not declare the node.
+ * @var logLevel The log level severity threshold of the node and its children, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @var rateLimit The number of logs per second admitted for the node and its children, 0 for no rate limit.
+ * @var rateBurst The number of logs admitted at once above the rate limit, 0 for 1.
+ */
+typedef struct ConfigFilePath {
+    const char** jsonPath;
+    size_t jsonPathDepth;
+    unsigned int capacity;
+    unsigned int reserve;
+    CJSON_LOG_LEVEL_E logLevel;
+    unsigned int rateLimit;
+    unsigned int rateBurst;
+} ConfigFilePath_s;
+
+/**
+ * @struct ConfigFile
+ *
+ * @brief A loaded configuration, the strings are owned by the parsed document until configFileRelease().
+ *
+ * @var config The logger configuration.
+ * @var sinks The sink configurations.
+ * @var sinkCount The number of sink configurations.
+ * @var paths The JSON node settings.
+ * @var pathCount The number of JSON node settings.
+ * @var doc The parsed configuration file, NULL without a configuration file.
+ */
+typedef struct ConfigFile {
+    CJSONLoggerConfig_s config;
+    CJSONLoggerSinkConfig_s* sinks;
+    size_t sinkCount;
+    ConfigFilePath_s* paths;
+    size_t pathCount;
+    cJSON* doc;
+} ConfigFile_s;
+
+/**
+ * @brief Load a configuration from a JSON file, the environment variables override the file.
+ *
+ * @note Missing fields keep the values of cJSONLoggerGetDefaultConfig() and cJSONLoggerGetDefaultSinkConfig(),
+ * fields of the wrong type or with unknown values fail the load.
+ *
+ * @param configPath The path of the configuration file, NULL for the CONFIG_FILE_ENV environment variable (if set).
+ * @param configFile Where the configuration will be stored, released with configFileRelease().
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int configFileLoad(const char* configPath, ConfigFile_s* configFile);
+
+/**
+ * @brief Release a configuration loaded with configFileLoad().
+ *
+ * @param configFile The configuration to release.
+ */
+void configFileRelease(ConfigFile_s* configFile);
+
+/**
+ * @brief Parse the name of a log level (e.g. "debug"), case insensitive.
+ *
+ * @param name The name to parse.
+ * @param logLevel Where the log level will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int configFileParseLogLevel(const char* name, CJSON_LOG_LEVEL_E* logLevel);
+
+#endif // CJSON_LOGGER_CONFIG_FILE_H
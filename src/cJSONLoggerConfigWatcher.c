@@ -0,0 +1,219 @@
+/**
+ * @file cJSONLoggerConfigWatcher.c
+ *
+ * @brief This file contains the implementation of the thread watching the configuration file of the cJSON logger library for changes.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#define _GNU_SOURCE
+
+#include "cJSONLoggerConfigWatcher.h"
+#include "cJSONLoggerAssert.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/**
+ * @def CONFIG_WATCHER_EVENTS_LEN
+ *
+ * @brief Size of the buffer the inotify events are read into.
+ */
+#define CONFIG_WATCHER_EVENTS_LEN (16 * (sizeof(struct inotify_event) + NAME_MAX + 1))
+
+/**
+ * @struct ConfigWatcher
+ *
+ * @brief A configuration file watcher.
+ *
+ * @var thread The watcher thread.
+ * @var filePath The path of the watched file.
+ * @var fileName The name of the watched file in its directory, points into filePath.
+ * @var inotifyFd The inotify instance watching the directory of the file.
+ * @var stopPipe Pipe written to stop the watcher thread.
+ * @var func The function run after the file changed.
+ * @var ctx The context passed to the function.
+ */
+struct ConfigWatcher {
+    pthread_t thread;
+    char* filePath;
+    const char* fileName;
+    int inotifyFd;
+    int stopPipe[2];
+    ConfigWatcherFunc func;
+    void* ctx;
+};
+
+/**
+ * @brief Check whether a buffer of inotify events holds a change of the watched file.
+ *
+ * @param watcher The watcher.
+ * @param events The events.
+ * @param length The length of the events.
+ *
+ * @return int, 1 if the file changed, 0 otherwise.
+ */
+static int configWatcherFileChanged(const ConfigWatcher_s* watcher, const char* events, size_t length)
+{
+    int changed = 0;
+    for (size_t offset = 0; offset + sizeof(struct inotify_event) <= length;) {
+        const struct inotify_event* event = (const struct inotify_event*)(const void*)(events + offset);
+        if (event->len > 0 && strcmp(event->name, watcher->fileName) == 0) {
+            changed = 1;
+        }
+
+        offset += sizeof(struct inotify_event) + event->len;
+    }
+
+    return changed;
+}
+
+/**
+ * @brief Handler of the watcher thread.
+ *
+ * @param ctx The watcher.
+ *
+ * @return void*, always NULL.
+ */
+static void* configWatcherHandler(void* ctx)
+{
+    ConfigWatcher_s* watcher = (ConfigWatcher_s*)ctx;
+    char events[CONFIG_WATCHER_EVENTS_LEN] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    struct pollfd fds[2] = {
+        { .fd = watcher->inotifyFd, .events = POLLIN, .revents = 0 },
+        { .fd = watcher->stopPipe[0], .events = POLLIN, .revents = 0 },
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        if (fds[1].revents != 0) {
+            break;
+        }
+
+        // Every queued event is read before the reload, a save usually comes as several events.
+        int changed = 0;
+        ssize_t length = 0;
+        while ((length = read(watcher->inotifyFd, events, sizeof(events))) > 0) {
+            changed |= configWatcherFileChanged(watcher, events, (size_t)length);
+        }
+
+        if (changed != 0) {
+            watcher->func(watcher->filePath, watcher->ctx);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Release the resources of a watcher whose thread is not running.
+ *
+ * @param watcher The watcher.
+ */
+static void configWatcherFree(ConfigWatcher_s* watcher)
+{
+    if (watcher->inotifyFd != -1) {
+        close(watcher->inotifyFd);
+    }
+
+    if (watcher->stopPipe[0] != -1) {
+        close(watcher->stopPipe[0]);
+        close(watcher->stopPipe[1]);
+    }
+
+    free(watcher->filePath);
+    free(watcher);
+}
+
+ConfigWatcher_s* configWatcherCreate(const char* filePath, const LoggerThreadAttr_s* attr, ConfigWatcherFunc func, void* ctx)
+{
+    if (filePath == NULL || func == NULL) {
+        return NULL;
+    }
+
+    ConfigWatcher_s* watcher = (ConfigWatcher_s*)calloc(1, sizeof(ConfigWatcher_s));
+    CJSON_LOGGER_ASSERT_NEQ(watcher, NULL);
+    if (watcher == NULL) {
+        return NULL;
+    }
+
+    watcher->inotifyFd = -1;
+    watcher->stopPipe[0] = -1;
+    watcher->stopPipe[1] = -1;
+    watcher->func = func;
+    watcher->ctx = ctx;
+    watcher->filePath = strdup(filePath);
+    char* dirPath = strdup(filePath);
+    if (watcher->filePath == NULL || dirPath == NULL) {
+        free(dirPath);
+        configWatcherFree(watcher);
+        return NULL;
+    }
+
+    const char* fileName = strrchr(watcher->filePath, '/');
+    watcher->fileName = fileName != NULL ? fileName + 1 : watcher->filePath;
+
+    watcher->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    int res = watcher->inotifyFd != -1 ? 0 : -1;
+    if (res == 0) {
+        res = inotify_add_watch(watcher->inotifyFd, dirname(dirPath), IN_CLOSE_WRITE | IN_MOVED_TO) != -1 ? 0 : -1;
+    }
+    free(dirPath);
+
+    if (res == 0) {
+        res = pipe2(watcher->stopPipe, O_CLOEXEC);
+    }
+
+    if (res == 0) {
+        res = loggerThreadCreate(&watcher->thread, attr, configWatcherHandler, watcher);
+    }
+
+    if (res != 0) {
+        configWatcherFree(watcher);
+        return NULL;
+    }
+
+    return watcher;
+}
+
+void configWatcherDestroy(ConfigWatcher_s* watcher)
+{
+    if (watcher == NULL) {
+        return;
+    }
+
+    char stop = 1;
+    ssize_t written = -1;
+    do {
+        written = write(watcher->stopPipe[1], &stop, 1);
+    } while (written < 0 && errno == EINTR);
+
+    pthread_join(watcher->thread, NULL);
+    configWatcherFree(watcher);
+}
+
+void configWatcherAbandon(ConfigWatcher_s* watcher)
+{
+    if (watcher == NULL) {
+        return;
+    }
+
+    configWatcherFree(watcher);
+}
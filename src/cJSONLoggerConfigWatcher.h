@@ -0,0 +1,57 @@
+/**
+ * @file cJSONLoggerConfigWatcher.h
+ *
+ * @brief This file contains the interface of the thread watching the configuration file of the cJSON logger library for changes.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_CONFIG_WATCHER_H
+#define CJSON_LOGGER_CONFIG_WATCHER_H
+
+#include "cJSONLoggerThread.h"
+
+/**
+ * @brief Function type of the reload run by a watcher when the file changes.
+ *
+ * @param filePath The path of the watched file.
+ * @param ctx The context the watcher was created with.
+ */
+typedef void (*ConfigWatcherFunc)(const char* filePath, void* ctx);
+
+/**
+ * @brief Opaque configuration file watcher.
+ */
+typedef struct ConfigWatcher ConfigWatcher_s;
+
+/**
+ * @brief Create a thread watching a file with inotify.
+ *
+ * @note The directory of the file is watched, so a file replaced with a rename (as editors save) keeps being watched.
+ *
+ * @param filePath The path of the file to watch.
+ * @param attr The scheduling attributes of the watcher thread, NULL for the defaults.
+ * @param func The function run after the file was written or replaced.
+ * @param ctx The context passed to the function.
+ *
+ * @return ConfigWatcher_s* ptr of the new watcher, NULL in case of failure.
+ */
+ConfigWatcher_s* configWatcherCreate(const char* filePath, const LoggerThreadAttr_s* attr, ConfigWatcherFunc func, void* ctx);
+
+/**
+ * @brief Stop a watcher and wait for its thread to exit, a reload in progress completes first.
+ *
+ * @param watcher The watcher to destroy.
+ */
+void configWatcherDestroy(ConfigWatcher_s* watcher);
+
+/**
+ * @brief Release a watcher inherited by a forked child process, whose thread was not inherited.
+ *
+ * @param watcher The watcher to release.
+ */
+void configWatcherAbandon(ConfigWatcher_s* watcher);
+
+#endif // CJSON_LOGGER_CONFIG_WATCHER_H
@@ -0,0 +1,251 @@
+/**
+ * @file cJSONLoggerEscape.c
+ *
+ * @brief This file contains the implementation of the kernels scanning strings for the characters JSON escapes.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerEscape.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @def ESCAPE_SWAR_ONES
+ *
+ * @brief The 0x01 byte repeated in a 64 bit word.
+ */
+#define ESCAPE_SWAR_ONES 0x0101010101010101ULL
+
+/**
+ * @def ESCAPE_SWAR_HIGHS
+ *
+ * @brief The 0x80 byte repeated in a 64 bit word.
+ */
+#define ESCAPE_SWAR_HIGHS 0x8080808080808080ULL
+
+/**
+ * @brief Check whether a character is escaped inside a JSON string.
+ *
+ * @param c The character.
+ *
+ * @return int, 1 if the character is escaped, 0 otherwise.
+ */
+static inline int escapeNeeded(unsigned char c)
+{
+    return c < 0x20 || c == '\"' || c == '\\';
+}
+
+/**
+ * @brief Scan a string one character at a time, see escapeScan().
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+static size_t escapeScanScalar(const unsigned char* str, size_t length)
+{
+    size_t i = 0;
+    while (i < length && escapeNeeded(str[i]) == 0) {
+        i++;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Scan a string 8 characters at a time in a 64 bit word, see escapeScan().
+ *
+ * @note A word is checked for a byte below 0x20 or equal to the quote or the backslash without branches per byte,
+ * the word holding one is scanned one character at a time.
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+static size_t escapeScanSwar(const unsigned char* str, size_t length)
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, str + i, sizeof(word));
+
+        // (x - n) & ~x & 0x80 flags every byte below n, quotes and backslashes become zero bytes after the xor.
+        // A byte above a flagged one may be flagged by the borrow too, the scalar scan finds the first one exactly.
+        uint64_t quotes = word ^ (ESCAPE_SWAR_ONES * '\"');
+        uint64_t backslashes = word ^ (ESCAPE_SWAR_ONES * '\\');
+        uint64_t found = ((word - ESCAPE_SWAR_ONES * 0x20) & ~word) | ((quotes - ESCAPE_SWAR_ONES) & ~quotes) |
+                         ((backslashes - ESCAPE_SWAR_ONES) & ~backslashes);
+        if ((found & ESCAPE_SWAR_HIGHS) != 0) {
+            break;
+        }
+    }
+
+    return i + escapeScanScalar(str + i, length - i);
+}
+
+#if defined(__x86_64__)
+
+/**
+ * @brief Scan a string 16 characters at a time with SSE2, see escapeScan().
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+static size_t escapeScanSse2(const unsigned char* str, size_t length)
+{
+    const __m128i controls = _mm_set1_epi8(0x1F);
+    const __m128i quotes = _mm_set1_epi8('\"');
+    const __m128i backslashes = _mm_set1_epi8('\\');
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+        __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)(str + i));
+
+        // Unsigned c <= 0x1F is min(c, 0x1F) == c, SSE2 has no unsigned byte comparison.
+        __m128i found = _mm_cmpeq_epi8(_mm_min_epu8(chars, controls), chars);
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, quotes));
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, backslashes));
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(found);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + escapeScanSwar(str + i, length - i);
+}
+
+/**
+ * @brief Scan a string 32 characters at a time with AVX2, see escapeScan().
+ *
+ * @note Only called when the CPU supports AVX2.
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+__attribute__((target("avx2"))) static size_t escapeScanAvx2(const unsigned char* str, size_t length)
+{
+    const __m256i controls = _mm256_set1_epi8(0x1F);
+    const __m256i quotes = _mm256_set1_epi8('\"');
+    const __m256i backslashes = _mm256_set1_epi8('\\');
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i)) {
+        __m256i chars = _mm256_loadu_si256((const __m256i*)(const void*)(str + i));
+
+        __m256i found = _mm256_cmpeq_epi8(_mm256_min_epu8(chars, controls), chars);
+        found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, quotes));
+        found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, backslashes));
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(found);
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + escapeScanSse2(str + i, length - i);
+}
+
+#endif
+
+size_t escapeScan(const char* str, size_t length)
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        return escapeScanAvx2((const unsigned char*)str, length);
+    }
+
+    return escapeScanSse2((const unsigned char*)str, length);
+#else
+    return escapeScanSwar((const unsigned char*)str, length);
+#endif
+}
+
+size_t escapeLength(const char* str, size_t length)
+{
+    size_t escapedLength = length;
+    size_t i = escapeScan(str, length);
+    while (i < length) {
+        switch ((unsigned char)str[i++]) {
+        case '\"':
+        case '\\':
+        case '\b':
+        case '\f':
+        case '\n':
+        case '\r':
+        case '\t':
+            escapedLength += 1;
+            break;
+        default:
+            escapedLength += 5;
+            break;
+        }
+        i += escapeScan(str + i, length - i);
+    }
+
+    return escapedLength;
+}
+
+char* escapeCopy(char* out, const char* str, size_t length)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    size_t i = 0;
+    while (i < length) {
+        size_t cleanLength = escapeScan(str + i, length - i);
+        memcpy(out, str + i, cleanLength);
+        out += cleanLength;
+        i += cleanLength;
+        if (i == length) {
+            break;
+        }
+
+        unsigned char c = (unsigned char)str[i++];
+        *out++ = '\\';
+        switch (c) {
+        case '\"':
+            *out++ = '\"';
+            break;
+        case '\\':
+            *out++ = '\\';
+            break;
+        case '\b':
+            *out++ = 'b';
+            break;
+        case '\f':
+            *out++ = 'f';
+            break;
+        case '\n':
+            *out++ = 'n';
+            break;
+        case '\r':
+            *out++ = 'r';
+            break;
+        case '\t':
+            *out++ = 't';
+            break;
+        default:
+            memcpy(out, "u00", 3);
+            out[3] = hexDigits[c >> 4];
+            out[4] = hexDigits[c & 0xF];
+            out += 5;
+            break;
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file cJSONLoggerEscape.h
+ *
+ * @brief This file contains the interface of the kernels scanning strings for the characters JSON escapes.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_ESCAPE_H
+#define CJSON_LOGGER_ESCAPE_H
+
+#include <stddef.h>
+
+/**
+ * @brief Count the leading characters of a string that print as they are inside a JSON string.
+ *
+ * @note The quote, the backslash and the control characters (below 0x20) are escaped, every other byte is printed as it is.
+ * The scan uses AVX2 or SSE2 when the CPU supports them (checked at run time) and 8 bytes at a time otherwise.
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+size_t escapeScan(const char* str, size_t length);
+
+/**
+ * @brief Get the length of a string once escaped the same way cJSON_Print() escapes it, without the quotes.
+ *
+ * @param str The string to escape.
+ * @param length The number of characters of the string.
+ *
+ * @return size_t, the escaped length, equal to length if nothing needs an escape.
+ */
+size_t escapeLength(const char* str, size_t length);
+
+/**
+ * @brief Escape a string the same way cJSON_Print() escapes it, without the quotes and the NUL terminator.
+ *
+ * @param out Where the escaped string will be written, escapeLength() bytes.
+ * @param str The string to escape.
+ * @param length The number of characters of the string.
+ *
+ * @return char*, the position past the last written character.
+ */
+char* escapeCopy(char* out, const char* str, size_t length);
+
+#endif // CJSON_LOGGER_ESCAPE_H
@@ -0,0 +1,315 @@
+/**
+ * @file cJSONLoggerFlightRecorder.c
+ *
+ * @brief This file contains the implementation of the flight recorder keeping the most recent log records in memory until a trigger persists them.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerFlightRecorder.h"
+#include "cJSONLoggerAssert.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def FLIGHT_RECORD_DATA_LEN
+ *
+ * @brief Bytes of a record holding the node names, the call site names and the log message, longer messages are truncated to fit.
+ */
+#define FLIGHT_RECORD_DATA_LEN 480
+
+/**
+ * @def FLIGHT_RECORD_FILE_NAME
+ *
+ * @brief Flag of a record holding the file name of its call site.
+ */
+#define FLIGHT_RECORD_FILE_NAME 0x1
+
+/**
+ * @def FLIGHT_RECORD_FUNC_NAME
+ *
+ * @brief Flag of a record holding the function name of its call site.
+ */
+#define FLIGHT_RECORD_FUNC_NAME 0x2
+
+/**
+ * @def FLIGHT_RECORDER_MAX_BATCH_RECORDS
+ *
+ * @brief Max number of records handed to a single call of the drain callback.
+ */
+#define FLIGHT_RECORDER_MAX_BATCH_RECORDS 64
+
+/**
+ * @struct FlightRecord
+ *
+ * @brief A record kept by a flight recorder.
+ *
+ * @var timeStamp The time stamp of the record in nanoseconds since the epoch.
+ * @var sequence The sequence number of the record, 0 if not set.
+ * @var logLevel The log level of the record.
+ * @var fileLine The file line of the call site, 0 if not set.
+ * @var threadId The id of the logging thread, 0 if not set.
+ * @var pathDepth The number of node names.
+ * @var flags FLIGHT_RECORD_FILE_NAME and FLIGHT_RECORD_FUNC_NAME set for the call site names held by the record.
+ * @var data The NUL terminated node names, followed by the NUL terminated call site names that are set and the NUL terminated log message.
+ */
+typedef struct FlightRecord {
+    int64_t timeStamp;
+    uint64_t sequence;
+    int32_t logLevel;
+    int32_t fileLine;
+    uint32_t threadId;
+    uint16_t pathDepth;
+    uint8_t flags;
+    char data[FLIGHT_RECORD_DATA_LEN];
+} FlightRecord_s;
+
+_Static_assert(sizeof(FlightRecord_s) == 512, "a flight record must stay within 512 bytes");
+
+/**
+ * @struct FlightRecorder
+ *
+ * @brief A flight recorder.
+ *
+ * @var records The kept records, a ring of capacity records.
+ * @var capacity The number of records kept.
+ * @var head Position of the oldest kept record.
+ * @var count Number of kept records.
+ * @var triggerLevel The log level severity threshold of the records triggering the recorder.
+ * @var postRecords The number of records following a trigger that pass the recorder.
+ * @var postRemaining The number of records that still pass the recorder after the last trigger.
+ * @var dropped Number of records dropped because their node names and call site names alone did not fit a record.
+ * @var mutex Mutex serializing the access to the recorder.
+ */
+struct FlightRecorder {
+    FlightRecord_s* records;
+    unsigned int capacity;
+    unsigned int head;
+    unsigned int count;
+    CJSON_LOG_LEVEL_E triggerLevel;
+    unsigned int postRecords;
+    unsigned int postRemaining;
+    uint64_t dropped;
+    pthread_mutex_t mutex;
+};
+
+FlightRecorder_s* flightRecorderCreate(unsigned int capacity, CJSON_LOG_LEVEL_E triggerLevel, unsigned int postRecords)
+{
+    if (capacity == 0 || triggerLevel <= __CJSON_LOG_LEVEL_START || triggerLevel >= __CJSON_LOG_LEVEL_END) {
+        return NULL;
+    }
+
+    FlightRecorder_s* recorder = (FlightRecorder_s*)calloc(1, sizeof(FlightRecorder_s));
+    CJSON_LOGGER_ASSERT_NEQ(recorder, NULL);
+    if (recorder == NULL) {
+        return NULL;
+    }
+
+    recorder->records = (FlightRecord_s*)malloc(capacity * sizeof(FlightRecord_s));
+    CJSON_LOGGER_ASSERT_NEQ(recorder->records, NULL);
+    if (recorder->records == NULL) {
+        free(recorder);
+        return NULL;
+    }
+
+    recorder->capacity = capacity;
+    recorder->triggerLevel = triggerLevel;
+    recorder->postRecords = postRecords;
+    pthread_mutex_init(&recorder->mutex, NULL);
+
+    return recorder;
+}
+
+void flightRecorderDestroy(FlightRecorder_s* recorder)
+{
+    if (recorder == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&recorder->mutex);
+    free(recorder->records);
+    free(recorder);
+}
+
+FLIGHT_RECORDER_RES_E flightRecorderWrite(FlightRecorder_s* recorder, const LogRecord_s* record)
+{
+    if (record->logLevel > __CJSON_LOG_LEVEL_START && record->logLevel <= recorder->triggerLevel) {
+        pthread_mutex_lock(&recorder->mutex);
+        recorder->postRemaining = recorder->postRecords;
+        pthread_mutex_unlock(&recorder->mutex);
+
+        return FLIGHT_RECORDER_TRIGGERED;
+    }
+
+    size_t pathLen = 0;
+    for (size_t i = 0; i < record->jsonPathDepth && pathLen < FLIGHT_RECORD_DATA_LEN; i++) {
+        pathLen += strlen(record->jsonPath[i]) + 1;
+    }
+
+    // The call site names are copied like the node names, the caller may free them before a trigger replays the record.
+    size_t fileNameLen = record->fileName != NULL ? strnlen(record->fileName, FLIGHT_RECORD_DATA_LEN) + 1 : 0;
+    size_t funcNameLen = record->funcName != NULL ? strnlen(record->funcName, FLIGHT_RECORD_DATA_LEN) + 1 : 0;
+    pathLen += fileNameLen + funcNameLen;
+
+    // The message is truncated to the space left by the node names and the call site names, on a UTF-8 character boundary.
+    size_t msgLen = 0;
+    if (pathLen < FLIGHT_RECORD_DATA_LEN) {
+        msgLen = strnlen(record->logMsg, FLIGHT_RECORD_DATA_LEN - pathLen - 1);
+        while (msgLen > 0 && record->logMsg[msgLen] != '\0' && ((unsigned char)record->logMsg[msgLen] & 0xC0) == 0x80) {
+            msgLen--;
+        }
+    }
+
+    pthread_mutex_lock(&recorder->mutex);
+    if (recorder->postRemaining > 0) {
+        recorder->postRemaining--;
+        pthread_mutex_unlock(&recorder->mutex);
+
+        return FLIGHT_RECORDER_PASS;
+    }
+
+    if (pathLen >= FLIGHT_RECORD_DATA_LEN) {
+        recorder->dropped++;
+        pthread_mutex_unlock(&recorder->mutex);
+
+        return FLIGHT_RECORDER_DROPPED;
+    }
+
+    unsigned int position = recorder->head + recorder->count;
+    if (recorder->count == recorder->capacity) {
+        recorder->head = recorder->head + 1 < recorder->capacity ? recorder->head + 1 : 0;
+    }
+
+    else {
+        recorder->count++;
+    }
+
+    FlightRecord_s* flightRecord = &recorder->records[position < recorder->capacity ? position : position - recorder->capacity];
+    flightRecord->timeStamp = record->timeStamp;
+    flightRecord->sequence = record->sequence;
+    flightRecord->logLevel = (int32_t)record->logLevel;
+    flightRecord->fileLine = (int32_t)record->fileLine;
+    flightRecord->threadId = record->threadId;
+    flightRecord->pathDepth = (uint16_t)record->jsonPathDepth;
+    flightRecord->flags = (uint8_t)((record->fileName != NULL ? FLIGHT_RECORD_FILE_NAME : 0) | (record->funcName != NULL ? FLIGHT_RECORD_FUNC_NAME : 0));
+
+    char* data = flightRecord->data;
+    for (size_t i = 0; i < record->jsonPathDepth; i++) {
+        size_t nameLen = strlen(record->jsonPath[i]) + 1;
+        memcpy(data, record->jsonPath[i], nameLen);
+        data += nameLen;
+    }
+
+    if (record->fileName != NULL) {
+        memcpy(data, record->fileName, fileNameLen);
+        data += fileNameLen;
+    }
+
+    if (record->funcName != NULL) {
+        memcpy(data, record->funcName, funcNameLen);
+        data += funcNameLen;
+    }
+    memcpy(data, record->logMsg, msgLen);
+    data[msgLen] = '\0';
+    pthread_mutex_unlock(&recorder->mutex);
+
+    return FLIGHT_RECORDER_KEPT;
+}
+
+uint64_t flightRecorderDropped(FlightRecorder_s* recorder)
+{
+    pthread_mutex_lock(&recorder->mutex);
+    uint64_t dropped = recorder->dropped;
+    pthread_mutex_unlock(&recorder->mutex);
+
+    return dropped;
+}
+
+void flightRecorderTrigger(FlightRecorder_s* recorder)
+{
+    pthread_mutex_lock(&recorder->mutex);
+    recorder->postRemaining = recorder->postRecords;
+    pthread_mutex_unlock(&recorder->mutex);
+}
+
+size_t flightRecorderDrain(FlightRecorder_s* recorder, CJSONLoggerRecordCallback callback, void* userData)
+{
+    LogRecord_s records[FLIGHT_RECORDER_MAX_BATCH_RECORDS];
+    const char* names[FLIGHT_RECORD_DATA_LEN];
+
+    pthread_mutex_lock(&recorder->mutex);
+    size_t drained = recorder->count;
+
+    while (callback != NULL && recorder->count > 0) {
+        size_t count = 0;
+        size_t nameCount = 0;
+
+        for (unsigned int i = 0; i < recorder->count && count < FLIGHT_RECORDER_MAX_BATCH_RECORDS; i++) {
+            unsigned int position = recorder->head + i;
+            const FlightRecord_s* flightRecord = &recorder->records[position < recorder->capacity ? position : position - recorder->capacity];
+            if (nameCount + flightRecord->pathDepth > FLIGHT_RECORD_DATA_LEN) {
+                break;
+            }
+
+            const char* data = flightRecord->data;
+            for (uint16_t j = 0; j < flightRecord->pathDepth; j++) {
+                names[nameCount + j] = data;
+                data += strlen(data) + 1;
+            }
+
+            records[count].fileName = NULL;
+            if ((flightRecord->flags & FLIGHT_RECORD_FILE_NAME) != 0) {
+                records[count].fileName = data;
+                data += strlen(data) + 1;
+            }
+
+            records[count].funcName = NULL;
+            if ((flightRecord->flags & FLIGHT_RECORD_FUNC_NAME) != 0) {
+                records[count].funcName = data;
+                data += strlen(data) + 1;
+            }
+
+            records[count].jsonPath = &names[nameCount];
+            records[count].jsonPathDepth = flightRecord->pathDepth;
+            records[count].timeStamp = flightRecord->timeStamp;
+            records[count].logLevel = (CJSON_LOG_LEVEL_E)flightRecord->logLevel;
+            records[count].fileLine = flightRecord->fileLine;
+            records[count].logMsg = data;
+            records[count].sequence = flightRecord->sequence;
+            records[count].threadId = flightRecord->threadId;
+
+            nameCount += flightRecord->pathDepth;
+            count++;
+        }
+
+        callback(records, count, userData);
+
+        recorder->head = (unsigned int)((recorder->head + count) % recorder->capacity);
+        recorder->count -= (unsigned int)count;
+    }
+
+    recorder->head = 0;
+    recorder->count = 0;
+    pthread_mutex_unlock(&recorder->mutex);
+
+    return drained;
+}
+
+void flightRecorderAtForkPrepare(FlightRecorder_s* recorder)
+{
+    pthread_mutex_lock(&recorder->mutex);
+}
+
+void flightRecorderAtForkParent(FlightRecorder_s* recorder)
+{
+    pthread_mutex_unlock(&recorder->mutex);
+}
+
+void flightRecorderAtForkChild(FlightRecorder_s* recorder)
+{
+    pthread_mutex_init(&recorder->mutex, NULL);
+}
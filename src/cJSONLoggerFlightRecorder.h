@@ -0,0 +1,114 @@
+/**
+ * @file cJSONLoggerFlightRecorder.h
+ *
+ * @brief This file contains the interface of the flight recorder keeping the most recent log records in memory until a trigger persists them.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_FLIGHT_RECORDER_H
+#define CJSON_LOGGER_FLIGHT_RECORDER_H
+
+#include "cJSONLoggerSink.h"
+
+/**
+ * @enum FLIGHT_RECORDER_RES
+ *
+ * @brief Enumeration used to tell the caller of flightRecorderWrite() what to do with the record.
+ */
+typedef enum FLIGHT_RECORDER_RES {
+    FLIGHT_RECORDER_KEPT = 0,
+    FLIGHT_RECORDER_PASS,
+    FLIGHT_RECORDER_TRIGGERED,
+    FLIGHT_RECORDER_DROPPED
+} FLIGHT_RECORDER_RES_E;
+
+/**
+ * @brief Opaque flight recorder.
+ */
+typedef struct FlightRecorder FlightRecorder_s;
+
+/**
+ * @brief Create a flight recorder.
+ *
+ * @param capacity The number of records kept, the newest record replaces the oldest one.
+ * @param triggerLevel The log level severity threshold of the records triggering the recorder.
+ * @param postRecords The number of records following a trigger that pass the recorder.
+ *
+ * @return FlightRecorder_s* ptr of the new flight recorder, NULL in case of failure.
+ */
+FlightRecorder_s* flightRecorderCreate(unsigned int capacity, CJSON_LOG_LEVEL_E triggerLevel, unsigned int postRecords);
+
+/**
+ * @brief Destroy a flight recorder, the kept records are dropped.
+ *
+ * @param recorder The flight recorder to destroy.
+ */
+void flightRecorderDestroy(FlightRecorder_s* recorder);
+
+/**
+ * @brief Write a record to a flight recorder.
+ *
+ * @note The record is copied, the call site names included. A message not fitting the record is truncated, a record whose
+ * node names and call site names alone do not fit is dropped (and counted).
+ *
+ * @param recorder The flight recorder.
+ * @param record The record to write.
+ *
+ * @return FLIGHT_RECORDER_RES_E, FLIGHT_RECORDER_KEPT if the recorder kept the record, FLIGHT_RECORDER_PASS if the caller
+ * must persist it, FLIGHT_RECORDER_TRIGGERED if the caller must persist the kept records (flightRecorderDrain()) and then it,
+ * FLIGHT_RECORDER_DROPPED if the record was dropped.
+ */
+FLIGHT_RECORDER_RES_E flightRecorderWrite(FlightRecorder_s* recorder, const LogRecord_s* record);
+
+/**
+ * @brief Get the number of records a flight recorder dropped because their node names and call site names did not fit a record.
+ *
+ * @param recorder The flight recorder.
+ *
+ * @return uint64_t, the number of dropped records.
+ */
+uint64_t flightRecorderDropped(FlightRecorder_s* recorder);
+
+/**
+ * @brief Trigger a flight recorder as if a record reached the trigger level, the caller must persist the kept records.
+ *
+ * @param recorder The flight recorder.
+ */
+void flightRecorderTrigger(FlightRecorder_s* recorder);
+
+/**
+ * @brief Hand the kept records of a flight recorder to a callback in batches, oldest first, and drop them.
+ *
+ * @param recorder The flight recorder.
+ * @param callback The callback receiving the records, NULL to only drop them.
+ * @param userData The user data passed to the callback.
+ *
+ * @return size_t, the number of records handed over.
+ */
+size_t flightRecorderDrain(FlightRecorder_s* recorder, CJSONLoggerRecordCallback callback, void* userData);
+
+/**
+ * @brief Lock a flight recorder before a fork.
+ *
+ * @param recorder The flight recorder.
+ */
+void flightRecorderAtForkPrepare(FlightRecorder_s* recorder);
+
+/**
+ * @brief Unlock a flight recorder in the parent after a fork.
+ *
+ * @param recorder The flight recorder.
+ */
+void flightRecorderAtForkParent(FlightRecorder_s* recorder);
+
+/**
+ * @brief Reset the lock of a flight recorder in the child after a fork, the kept records are inherited.
+ *
+ * @param recorder The flight recorder.
+ */
+void flightRecorderAtForkChild(FlightRecorder_s* recorder);
+
+#endif // CJSON_LOGGER_FLIGHT_RECORDER_H
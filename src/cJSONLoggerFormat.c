@@ -0,0 +1,505 @@
+/**
+ * @file cJSONLoggerFormat.c
+ *
+ * @brief This file contains the implementation used to format the logs of the cJSON logger library as JSON text.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerFormat.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerEscape.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def INITIAL_PRINT_BUFFER_CAPACITY
+ *
+ * @brief The initial size of a print buffer.
+ */
+#define INITIAL_PRINT_BUFFER_CAPACITY 4096
+
+/**
+ * @brief Lock held for reading around localtime_r() and for writing by the fork handlers.
+ *
+ * @note glibc does not reset its timezone lock in a forked child, a fork while a logger thread is converting a time stamp
+ * would leave the child deadlocked on its first conversion.
+ */
+static pthread_rwlock_t s_g_localTimeLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * @def MAX_TIME_ZONE_STR_LEN
+ *
+ * @brief The maximum length of the UTC offset ending an RFC 3339 time stamp (+hh:mm).
+ */
+#define MAX_TIME_ZONE_STR_LEN 8
+
+/**
+ * @struct TimeCache
+ *
+ * @brief The text of the last second formatted by a thread, the time stamps of the same second only format their nanoseconds.
+ *
+ * @var seconds The cached second since the epoch.
+ * @var timeFormat The time format of the cached text, -1 while nothing is cached.
+ * @var prefix The text of the time stamp up to its nanoseconds (e.g. "2026-01-07T09:05:03.").
+ * @var prefixLen Length of the prefix.
+ * @var suffix The text of the time stamp after its nanoseconds (e.g. "+02:00"), empty in the local time format.
+ * @var suffixLen Length of the suffix.
+ */
+typedef struct TimeCache {
+    int64_t seconds;
+    int timeFormat;
+    char prefix[MAX_TIME_STR_LEN];
+    size_t prefixLen;
+    char suffix[MAX_TIME_ZONE_STR_LEN];
+    size_t suffixLen;
+} TimeCache_s;
+
+/**
+ * @brief The format of the time stamps, one of CJSON_LOGGER_TIME_FORMAT_E.
+ */
+static atomic_int s_g_timeFormat = CJSON_LOGGER_TIME_LOCAL;
+
+/**
+ * @brief The time stamp text cache of the thread.
+ */
+static _Thread_local TimeCache_s s_t_timeCache = { .timeFormat = -1 };
+
+/**
+ * @brief The decimal digits of 0 to 99, two characters each.
+ */
+static const char s_g_digitPairs[] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
+
+const char* cJSONLoggerGetLogLevelStr(CJSON_LOG_LEVEL_E logLevel)
+{
+    switch (logLevel) {
+    case CJSON_LOG_LEVEL_CRITICAL:
+        return "CRITICAL";
+    case CJSON_LOG_LEVEL_ERROR:
+        return "ERROR";
+    case CJSON_LOG_LEVEL_WARN:
+        return "WARN";
+    case CJSON_LOG_LEVEL_INFO:
+        return "INFO";
+    case CJSON_LOG_LEVEL_DEBUG:
+        return "DEBUG";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+char* formatUInt(char* out, uint64_t value)
+{
+    // The digits are produced two at a time from the lowest ones, right to left.
+    char digits[MAX_INT_STR_LEN];
+    char* digit = digits + sizeof(digits);
+
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        digit -= 2;
+        memcpy(digit, s_g_digitPairs + pair, 2);
+    }
+
+    if (value >= 10) {
+        digit -= 2;
+        memcpy(digit, s_g_digitPairs + value * 2, 2);
+    }
+
+    else {
+        *--digit = (char)('0' + value);
+    }
+
+    size_t length = (size_t)(digits + sizeof(digits) - digit);
+    memcpy(out, digit, length);
+
+    return out + length;
+}
+
+char* formatInt(char* out, int64_t value)
+{
+    if (value < 0) {
+        *out++ = '-';
+        return formatUInt(out, 0 - (uint64_t)value);
+    }
+
+    return formatUInt(out, (uint64_t)value);
+}
+
+char* formatUIntFixed(char* out, uint64_t value, size_t width)
+{
+    char* digit = out + width;
+
+    while (digit - out >= 2) {
+        digit -= 2;
+        memcpy(digit, s_g_digitPairs + (value % 100) * 2, 2);
+        value /= 100;
+    }
+
+    if (digit > out) {
+        *--digit = (char)('0' + value % 10);
+    }
+
+    return out + width;
+}
+
+/**
+ * @brief Fill the time stamp text cache of the thread for a second.
+ *
+ * @param timeCache The cache of the thread.
+ * @param seconds The second since the epoch.
+ * @param timeFormat The time format, one of CJSON_LOGGER_TIME_FORMAT_E.
+ */
+static void timeCacheFill(TimeCache_s* timeCache, int64_t seconds, int timeFormat)
+{
+    struct tm tmInfo;
+    if (timeFormat == CJSON_LOGGER_TIME_RFC3339_UTC) {
+        time_t utcSeconds = (time_t)seconds;
+        gmtime_r(&utcSeconds, &tmInfo);
+    }
+
+    else {
+        formatLocalTime((time_t)seconds, &tmInfo);
+    }
+
+    char* out = timeCache->prefix;
+    char* suffix = timeCache->suffix;
+    int64_t year = (int64_t)tmInfo.tm_year + 1900;
+
+    if (timeFormat == CJSON_LOGGER_TIME_LOCAL) {
+        out = formatInt(out, year);
+        *out++ = '-';
+        out = formatInt(out, tmInfo.tm_mon + 1);
+        *out++ = '-';
+        out = formatInt(out, tmInfo.tm_mday);
+        *out++ = ' ';
+        out = formatInt(out, tmInfo.tm_hour);
+        *out++ = ':';
+        out = formatInt(out, tmInfo.tm_min);
+        *out++ = ':';
+        out = formatInt(out, tmInfo.tm_sec);
+        *out++ = '.';
+    }
+
+    else {
+        // RFC 3339 only has four digit years, the others are printed as they are.
+        out = year >= 0 && year <= 9999 ? formatUIntFixed(out, (uint64_t)year, 4) : formatInt(out, year);
+        *out++ = '-';
+        out = formatUIntFixed(out, (uint64_t)tmInfo.tm_mon + 1, 2);
+        *out++ = '-';
+        out = formatUIntFixed(out, (uint64_t)tmInfo.tm_mday, 2);
+        *out++ = 'T';
+        out = formatUIntFixed(out, (uint64_t)tmInfo.tm_hour, 2);
+        *out++ = ':';
+        out = formatUIntFixed(out, (uint64_t)tmInfo.tm_min, 2);
+        *out++ = ':';
+        out = formatUIntFixed(out, (uint64_t)tmInfo.tm_sec, 2);
+        *out++ = '.';
+
+        if (timeFormat == CJSON_LOGGER_TIME_RFC3339_UTC) {
+            *suffix++ = 'Z';
+        }
+
+        else {
+            long offset = tmInfo.tm_gmtoff;
+            *suffix++ = offset < 0 ? '-' : '+';
+            offset = offset < 0 ? -offset : offset;
+            suffix = formatUIntFixed(suffix, (uint64_t)(offset / 3600), 2);
+            *suffix++ = ':';
+            suffix = formatUIntFixed(suffix, (uint64_t)(offset % 3600 / 60), 2);
+        }
+    }
+
+    timeCache->seconds = seconds;
+    timeCache->timeFormat = timeFormat;
+    timeCache->prefixLen = (size_t)(out - timeCache->prefix);
+    timeCache->suffixLen = (size_t)(suffix - timeCache->suffix);
+}
+
+size_t formatTimeStamp(int64_t timeStamp, char* timeStr, size_t timeStrLen)
+{
+    CJSON_LOGGER_ASSERT_EQ((timeStrLen >= MAX_TIME_STR_LEN), 1);
+    if (timeStrLen < MAX_TIME_STR_LEN) {
+        return 0;
+    }
+
+    int timeFormat = atomic_load_explicit(&s_g_timeFormat, memory_order_relaxed);
+
+    // The local time format keeps its truncated (possibly negative) nanoseconds, RFC 3339 needs them within the second.
+    int64_t seconds = timeStamp / 1000000000;
+    int64_t nanoSeconds = timeStamp % 1000000000;
+    if (timeFormat != CJSON_LOGGER_TIME_LOCAL && nanoSeconds < 0) {
+        seconds--;
+        nanoSeconds += 1000000000;
+    }
+
+    TimeCache_s* timeCache = &s_t_timeCache;
+    if (timeCache->seconds != seconds || timeCache->timeFormat != timeFormat) {
+        timeCacheFill(timeCache, seconds, timeFormat);
+    }
+
+    memcpy(timeStr, timeCache->prefix, timeCache->prefixLen);
+    char* out = timeStr + timeCache->prefixLen;
+    out = timeFormat == CJSON_LOGGER_TIME_LOCAL ? formatInt(out, nanoSeconds) : formatUIntFixed(out, (uint64_t)nanoSeconds, 9);
+    memcpy(out, timeCache->suffix, timeCache->suffixLen);
+    out += timeCache->suffixLen;
+    *out = '\0';
+
+    return (size_t)(out - timeStr);
+}
+
+void formatSetTimeFormat(CJSON_LOGGER_TIME_FORMAT_E timeFormat)
+{
+    atomic_store_explicit(&s_g_timeFormat, (int)timeFormat, memory_order_relaxed);
+}
+
+void formatRotationTime(char* timeStr, size_t timeStrLen)
+{
+    CJSON_LOGGER_ASSERT_EQ((timeStrLen >= MAX_TIME_STR_LEN), 1);
+    if (timeStrLen < MAX_TIME_STR_LEN) {
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    struct tm tmInfo;
+    formatLocalTime(ts.tv_sec, &tmInfo);
+
+    char* out = formatInt(timeStr, tmInfo.tm_hour);
+    *out++ = '_';
+    out = formatInt(out, tmInfo.tm_min);
+    *out++ = '_';
+    out = formatInt(out, tmInfo.tm_sec);
+    *out++ = '_';
+    out = formatInt(out, ts.tv_nsec);
+    *out = '\0';
+}
+
+char* formatForkFilePath(const char* filePath, pid_t pid)
+{
+    const char* baseName = strrchr(filePath, '/');
+    baseName = baseName != NULL ? baseName + 1 : filePath;
+
+    // A leading dot names a hidden file, not an extension.
+    const char* extension = strrchr(baseName, '.');
+    size_t stemLen = extension != NULL && extension != baseName ? (size_t)(extension - filePath) : strlen(filePath);
+
+    size_t forkFilePathLen = strlen(filePath) + 24;
+    char* path = (char*)malloc(forkFilePathLen);
+    CJSON_LOGGER_ASSERT_NEQ(path, NULL);
+    if (path == NULL) {
+        return NULL;
+    }
+
+    snprintf(path, forkFilePathLen, "%.*s.%d%s", (int)stemLen, filePath, (int)pid, filePath + stemLen);
+
+    return path;
+}
+
+void formatLocalTime(time_t seconds, struct tm* tmInfo)
+{
+    pthread_rwlock_rdlock(&s_g_localTimeLock);
+    localtime_r(&seconds, tmInfo);
+    pthread_rwlock_unlock(&s_g_localTimeLock);
+}
+
+void formatAtForkPrepare(void)
+{
+    pthread_rwlock_wrlock(&s_g_localTimeLock);
+}
+
+void formatAtForkParent(void)
+{
+    pthread_rwlock_unlock(&s_g_localTimeLock);
+}
+
+void formatAtForkChild(void)
+{
+    pthread_rwlock_init(&s_g_localTimeLock, NULL);
+}
+
+char* printBufferEnsure(PrintBuffer_s* printBuffer, size_t length)
+{
+    // A failed buffer stays incomplete, appending the rest would print invalid JSON text.
+    if (printBuffer->failed != 0) {
+        return NULL;
+    }
+
+    if (printBuffer->length + length + 1 > printBuffer->capacity) {
+        size_t capacity = printBuffer->capacity == 0 ? INITIAL_PRINT_BUFFER_CAPACITY : printBuffer->capacity * 2;
+        while (printBuffer->length + length + 1 > capacity) {
+            capacity *= 2;
+        }
+
+        char* buffer = (char*)realloc(printBuffer->buffer, capacity);
+        CJSON_LOGGER_ASSERT_NEQ(buffer, NULL);
+        if (buffer == NULL) {
+            printBuffer->failed = 1;
+            return NULL;
+        }
+
+        printBuffer->buffer = buffer;
+        printBuffer->capacity = capacity;
+    }
+
+    return printBuffer->buffer + printBuffer->length;
+}
+
+void printBufferReset(PrintBuffer_s* printBuffer)
+{
+    printBuffer->length = 0;
+    printBuffer->failed = 0;
+}
+
+void printBufferAppend(PrintBuffer_s* printBuffer, const char* str, size_t length)
+{
+    char* out = printBufferEnsure(printBuffer, length);
+    if (out == NULL) {
+        return;
+    }
+
+    memcpy(out, str, length);
+    printBuffer->length += length;
+    printBuffer->buffer[printBuffer->length] = '\0';
+}
+
+void printBufferIndent(PrintBuffer_s* printBuffer, size_t depth)
+{
+    char* out = printBufferEnsure(printBuffer, depth);
+    if (out == NULL) {
+        return;
+    }
+
+    memset(out, '\t', depth);
+    printBuffer->length += depth;
+    printBuffer->buffer[printBuffer->length] = '\0';
+}
+
+void printBufferInt(PrintBuffer_s* printBuffer, int64_t value)
+{
+    char* out = printBufferEnsure(printBuffer, MAX_INT_STR_LEN);
+    if (out == NULL) {
+        return;
+    }
+
+    printBuffer->length += (size_t)(formatInt(out, value) - out);
+    printBuffer->buffer[printBuffer->length] = '\0';
+}
+
+void printBufferUInt(PrintBuffer_s* printBuffer, uint64_t value)
+{
+    char* out = printBufferEnsure(printBuffer, MAX_INT_STR_LEN);
+    if (out == NULL) {
+        return;
+    }
+
+    printBuffer->length += (size_t)(formatUInt(out, value) - out);
+    printBuffer->buffer[printBuffer->length] = '\0';
+}
+
+void printBufferString(PrintBuffer_s* printBuffer, const char* str)
+{
+    size_t length = strlen(str);
+    size_t escapedLength = escapeLength(str, length);
+
+    char* out = printBufferEnsure(printBuffer, escapedLength + 2);
+    if (out == NULL) {
+        return;
+    }
+
+    *out++ = '\"';
+    out = escapeCopy(out, str, length);
+    *out++ = '\"';
+
+    printBuffer->length += escapedLength + 2;
+    *out = '\0';
+}
+
+void printBufferEscapedString(PrintBuffer_s* printBuffer, const char* escapedStr, size_t length)
+{
+    char* out = printBufferEnsure(printBuffer, length + 2);
+    if (out == NULL) {
+        return;
+    }
+
+    *out++ = '\"';
+    memcpy(out, escapedStr, length);
+    out += length;
+    *out++ = '\"';
+
+    printBuffer->length += length + 2;
+    *out = '\0';
+}
+
+void printBufferKey(PrintBuffer_s* printBuffer, size_t depth, const char* key)
+{
+    printBufferIndent(printBuffer, depth);
+    printBufferString(printBuffer, key);
+    printBufferAppend(printBuffer, ":\t", 2);
+}
+
+void printBufferRecordLine(PrintBuffer_s* printBuffer, const CJSONLoggerRecord_s* record)
+{
+    char timeStr[MAX_TIME_STR_LEN] = { 0 };
+    size_t timeStrLen = formatTimeStamp(record->timeStamp, timeStr, sizeof(timeStr));
+
+    // The time stamp holds nothing to escape.
+    printBufferAppend(printBuffer, "{\"Time\":", 8);
+    printBufferEscapedString(printBuffer, timeStr, timeStrLen);
+    printBufferAppend(printBuffer, ",\"LogLevel\":", 12);
+    printBufferString(printBuffer, cJSONLoggerGetLogLevelStr(record->logLevel));
+
+    if (record->sequence != 0) {
+        printBufferAppend(printBuffer, ",\"Sequence\":", 12);
+        printBufferUInt(printBuffer, record->sequence);
+    }
+
+    if (record->threadId != 0) {
+        printBufferAppend(printBuffer, ",\"ThreadId\":", 12);
+        printBufferUInt(printBuffer, record->threadId);
+    }
+
+    if (record->fileName != NULL) {
+        printBufferAppend(printBuffer, ",\"FileName\":", 12);
+        printBufferString(printBuffer, record->fileName);
+    }
+
+    if (record->funcName != NULL) {
+        printBufferAppend(printBuffer, ",\"FuncName\":", 12);
+        printBufferString(printBuffer, record->funcName);
+    }
+
+    if (record->fileLine != 0) {
+        printBufferAppend(printBuffer, ",\"FileLine\":", 12);
+        printBufferInt(printBuffer, record->fileLine);
+    }
+
+    printBufferAppend(printBuffer, ",\"Log\":", 7);
+    printBufferString(printBuffer, record->logMsg);
+    printBufferAppend(printBuffer, ",\"Path\":[", 9);
+
+    for (size_t i = 0; i < record->jsonPathDepth; i++) {
+        if (i > 0) {
+            printBufferAppend(printBuffer, ",", 1);
+        }
+        printBufferString(printBuffer, record->jsonPath[i]);
+    }
+
+    printBufferAppend(printBuffer, "]}\n", 3);
+}
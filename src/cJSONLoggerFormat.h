@@ -0,0 +1,243 @@
+/**
+ * @file cJSONLoggerFormat.h
+ *
+ * @brief This file contains the interface used to format the logs of the cJSON logger library as JSON text.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_FORMAT_H
+#define CJSON_LOGGER_FORMAT_H
+
+#include "cJSONLogger.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+/**
+ * @def MAX_TIME_STR_LEN
+ *
+ * @brief The maximum length of a string representation of time.
+ */
+#define MAX_TIME_STR_LEN 128
+
+/**
+ * @def MAX_INT_STR_LEN
+ *
+ * @brief The maximum length of the decimal representation of a 64 bit integer, sign included.
+ */
+#define MAX_INT_STR_LEN 20
+
+/**
+ * @struct PrintBuffer
+ *
+ * @brief Growable buffer the JSON text of the logs is printed into.
+ *
+ * @var buffer The NUL terminated JSON text.
+ * @var length Length of the JSON text.
+ * @var capacity Allocated size of the buffer.
+ * @var failed Set once the buffer could not grow, the JSON text is incomplete and nothing more is appended until the buffer is reset.
+ */
+typedef struct PrintBuffer {
+    char* buffer;
+    size_t length;
+    size_t capacity;
+    int failed;
+} PrintBuffer_s;
+
+/**
+ * @brief Get the string representation of the log level.
+ *
+ * @param logLevel The log level to convert.
+ *
+ * @return The string representation of the log level.
+ */
+const char* cJSONLoggerGetLogLevelStr(CJSON_LOG_LEVEL_E logLevel);
+
+/**
+ * @brief Convert seconds since the epoch to the local time.
+ *
+ * @note Use this function instead of localtime_r(), it keeps the conversions out of the way of fork().
+ *
+ * @param seconds The seconds since the epoch.
+ * @param tmInfo Where the local time will be stored.
+ */
+void formatLocalTime(time_t seconds, struct tm* tmInfo);
+
+/**
+ * @brief Write the decimal representation of an unsigned integer, two digits at a time from a lookup table.
+ *
+ * @param out Where the digits will be written, at least MAX_INT_STR_LEN bytes, no NUL terminator is written.
+ * @param value The integer to format.
+ *
+ * @return char*, the position past the last written digit.
+ */
+char* formatUInt(char* out, uint64_t value);
+
+/**
+ * @brief Write the decimal representation of a signed integer, see formatUInt().
+ *
+ * @param out Where the sign and the digits will be written, at least MAX_INT_STR_LEN bytes, no NUL terminator is written.
+ * @param value The integer to format.
+ *
+ * @return char*, the position past the last written digit.
+ */
+char* formatInt(char* out, int64_t value);
+
+/**
+ * @brief Write exactly width decimal digits of an unsigned integer, zero padded on the left, see formatUInt().
+ *
+ * @param out Where the digits will be written, no NUL terminator is written.
+ * @param value The integer to format, its digits above width are dropped.
+ * @param width The number of digits to write.
+ *
+ * @return char*, the position past the last written digit.
+ */
+char* formatUIntFixed(char* out, uint64_t value, size_t width);
+
+/**
+ * @brief Format a time stamp into its string representation, in the format set with formatSetTimeFormat().
+ *
+ * @note The text up to the seconds is cached per thread, the time stamps of the same second only format their nanoseconds.
+ *
+ * @param timeStamp The time stamp in nanoseconds since the epoch.
+ * @param timeStr The buffer where the string representation will be stored.
+ * @param timeStrLen The size of the buffer, at least MAX_TIME_STR_LEN.
+ *
+ * @return size_t, the length of the string representation, 0 in case of failure.
+ */
+size_t formatTimeStamp(int64_t timeStamp, char* timeStr, size_t timeStrLen);
+
+/**
+ * @brief Set the format of the time stamps printed by formatTimeStamp(), CJSON_LOGGER_TIME_LOCAL until set.
+ *
+ * @param timeFormat The time format.
+ */
+void formatSetTimeFormat(CJSON_LOGGER_TIME_FORMAT_E timeFormat);
+
+/**
+ * @brief Format the current time into the prefix of the rotated log files (h_m_s_ns).
+ *
+ * @param timeStr The buffer where the string representation will be stored.
+ * @param timeStrLen The size of the buffer, at least MAX_TIME_STR_LEN.
+ */
+void formatRotationTime(char* timeStr, size_t timeStrLen);
+
+/**
+ * @brief Build the file path of a forked child, the pid is inserted before the extension (e.g. log.json -> log.<pid>.json).
+ *
+ * @param filePath The file path of the parent.
+ * @param pid The pid of the child.
+ *
+ * @return char* ptr of the new file path, NULL in case of failure.
+ */
+char* formatForkFilePath(const char* filePath, pid_t pid);
+
+/**
+ * @brief Fork handler run in the parent before the fork, waits for the running local time conversions.
+ */
+void formatAtForkPrepare(void);
+
+/**
+ * @brief Fork handler run in the parent after the fork.
+ */
+void formatAtForkParent(void);
+
+/**
+ * @brief Fork handler run in the child after the fork.
+ */
+void formatAtForkChild(void);
+
+/**
+ * @brief Make room in a print buffer for more characters and the NUL terminator.
+ *
+ * @note A failure marks the print buffer as failed, see printBufferReset().
+ *
+ * @param printBuffer The print buffer to grow.
+ * @param length The number of characters that will be appended.
+ *
+ * @return char* ptr where the characters can be written, NULL in case of failure or if the buffer already failed.
+ */
+char* printBufferEnsure(PrintBuffer_s* printBuffer, size_t length);
+
+/**
+ * @brief Empty a print buffer and clear its failure, the allocated buffer is kept.
+ *
+ * @param printBuffer The print buffer to reset.
+ */
+void printBufferReset(PrintBuffer_s* printBuffer);
+
+/**
+ * @brief Append characters to a print buffer.
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param str The characters to append.
+ * @param length The number of characters to append.
+ */
+void printBufferAppend(PrintBuffer_s* printBuffer, const char* str, size_t length);
+
+/**
+ * @brief Append tab indentation to a print buffer.
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param depth The number of tabs to append.
+ */
+void printBufferIndent(PrintBuffer_s* printBuffer, size_t depth);
+
+/**
+ * @brief Append a quoted and escaped JSON string to a print buffer, escaping the same characters cJSON_Print() does.
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param str The string to append.
+ */
+void printBufferString(PrintBuffer_s* printBuffer, const char* str);
+
+/**
+ * @brief Append the decimal representation of an integer to a print buffer, see formatInt().
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param value The integer to append.
+ */
+void printBufferInt(PrintBuffer_s* printBuffer, int64_t value);
+
+/**
+ * @brief Append the decimal representation of an unsigned integer to a print buffer, see formatUInt().
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param value The integer to append.
+ */
+void printBufferUInt(PrintBuffer_s* printBuffer, uint64_t value);
+
+/**
+ * @brief Append an already escaped JSON string to a print buffer between quotes, see escapeCopy().
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param escapedStr The escaped string, not NUL terminated.
+ * @param length The number of characters of the escaped string.
+ */
+void printBufferEscapedString(PrintBuffer_s* printBuffer, const char* escapedStr, size_t length);
+
+/**
+ * @brief Append an object key (indentation, quoted key and separator) to a print buffer.
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param depth The depth of the object the key belongs to.
+ * @param key The key to append.
+ */
+void printBufferKey(PrintBuffer_s* printBuffer, size_t depth, const char* key);
+
+/**
+ * @brief Append a log record as a single line JSON object (NDJSON) to a print buffer.
+ *
+ * @note The object has the fields of the JSON tree logs followed by the "Path" array of the node names.
+ *
+ * @param printBuffer The print buffer to append to.
+ * @param record The record to append.
+ */
+void printBufferRecordLine(PrintBuffer_s* printBuffer, const CJSONLoggerRecord_s* record);
+
+#endif // CJSON_LOGGER_FORMAT_H
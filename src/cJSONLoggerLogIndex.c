@@ -0,0 +1,197 @@
+/**
+ * @file cJSONLoggerLogIndex.c
+ *
+ * @brief This file contains the implementation of the query index of the logs of a node of the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerLogIndex.h"
+#include "cJSONLoggerAssert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Get the position of a log level in the lists of blocks per log level.
+ *
+ * @param logLevel The log level, out of range log levels share the last list.
+ *
+ * @return unsigned int, the position of the list.
+ */
+static inline unsigned int logIndexLevel(unsigned int logLevel)
+{
+    return logLevel < LOG_INDEX_LEVELS - 1 ? logLevel : LOG_INDEX_LEVELS - 1;
+}
+
+int logIndexReserve(LogIndex_s* index, unsigned int logCapacity, int ordered)
+{
+    unsigned int blockCount = (logCapacity + LOG_BLOCK_LEN - 1) / LOG_BLOCK_LEN;
+
+    LogBlock_s* blocks = (LogBlock_s*)realloc(index->blocks, blockCount * sizeof(LogBlock_s));
+    CJSON_LOGGER_ASSERT_NEQ(blocks, NULL);
+    if (blocks == NULL) {
+        return -1;
+    }
+    index->blocks = blocks;
+
+    if (ordered == 0) {
+        free(index->levelBlocks);
+        index->levelBlocks = NULL;
+        index->levelBlockCapacity = 0;
+        memset(index->levelBlockCounts, 0, sizeof(index->levelBlockCounts));
+        return 0;
+    }
+
+    if (blockCount <= index->levelBlockCapacity) {
+        return 0;
+    }
+
+    uint32_t* levelBlocks = (uint32_t*)realloc(index->levelBlocks, (size_t)blockCount * LOG_INDEX_LEVELS * sizeof(uint32_t));
+    CJSON_LOGGER_ASSERT_NEQ(levelBlocks, NULL);
+    if (levelBlocks == NULL) {
+        return -1;
+    }
+
+    // The lists move to their wider stride, the last one first so none is overwritten before it moved.
+    for (unsigned int level = LOG_INDEX_LEVELS - 1; level > 0; level--) {
+        memmove(levelBlocks + (size_t)level * blockCount, levelBlocks + (size_t)level * index->levelBlockCapacity, index->levelBlockCounts[level] * sizeof(uint32_t));
+    }
+
+    index->levelBlocks = levelBlocks;
+    index->levelBlockCapacity = blockCount;
+    return 0;
+}
+
+void logIndexFree(LogIndex_s* index)
+{
+    free(index->blocks);
+    free(index->levelBlocks);
+    memset(index, 0, sizeof(LogIndex_s));
+}
+
+void logIndexClear(LogIndex_s* index)
+{
+    memset(index->levelBlockCounts, 0, sizeof(index->levelBlockCounts));
+}
+
+void logIndexAdd(LogIndex_s* index, unsigned int logIndex, int64_t timeStamp, uint32_t callSite, unsigned int logLevel, int startsBlock)
+{
+    unsigned int blockIndex = logIndex / LOG_BLOCK_LEN;
+    LogBlock_s* block = &index->blocks[blockIndex];
+
+    if (startsBlock != 0) {
+        block->minTimeStamp = timeStamp;
+        block->maxTimeStamp = timeStamp;
+        block->prefixMaxTimeStamp = blockIndex > 0 && index->levelBlocks != NULL ? index->blocks[blockIndex - 1].prefixMaxTimeStamp : timeStamp;
+        block->callSiteMask = 0;
+        block->logLevelMask = 0;
+    }
+
+    block->minTimeStamp = timeStamp < block->minTimeStamp ? timeStamp : block->minTimeStamp;
+    block->maxTimeStamp = timeStamp > block->maxTimeStamp ? timeStamp : block->maxTimeStamp;
+    block->prefixMaxTimeStamp = timeStamp > block->prefixMaxTimeStamp ? timeStamp : block->prefixMaxTimeStamp;
+    block->callSiteMask |= 1ULL << (callSite % 64);
+    block->logLevelMask |= logLevelMaskBit(logLevel);
+
+    if (index->levelBlocks == NULL) {
+        return;
+    }
+
+    unsigned int level = logIndexLevel(logLevel);
+    uint32_t* levelBlocks = index->levelBlocks + (size_t)level * index->levelBlockCapacity;
+    unsigned int* levelBlockCount = &index->levelBlockCounts[level];
+    if (*levelBlockCount == 0 || levelBlocks[*levelBlockCount - 1] != blockIndex) {
+        levelBlocks[(*levelBlockCount)++] = blockIndex;
+    }
+}
+
+void logIndexCursorInit(LogIndexCursor_s* cursor, const LogIndex_s* index, unsigned int blockCount, uint8_t logLevelMask, int64_t fromTimeStamp)
+{
+    memset(cursor, 0, sizeof(LogIndexCursor_s));
+    cursor->index = index;
+    cursor->blockCount = blockCount;
+    cursor->logLevelMask = logLevelMask;
+
+    if (index->levelBlocks == NULL) {
+        return;
+    }
+
+    // The running max time stamps only grow, every block before the first one reaching fromTimeStamp is older.
+    unsigned int low = 0;
+    unsigned int high = blockCount;
+    while (low < high) {
+        unsigned int mid = low + (high - low) / 2;
+        if (index->blocks[mid].prefixMaxTimeStamp < fromTimeStamp) {
+            low = mid + 1;
+        }
+
+        else {
+            high = mid;
+        }
+    }
+    cursor->nextBlock = low;
+
+    // The lists only pay off when the query leaves out a log level of the node.
+    for (unsigned int level = 0; level < LOG_INDEX_LEVELS; level++) {
+        if (index->levelBlockCounts[level] != 0 && (logLevelMask & (1u << level)) == 0) {
+            cursor->byLevel = 1;
+        }
+    }
+
+    for (unsigned int level = 0; cursor->byLevel != 0 && level < LOG_INDEX_LEVELS; level++) {
+        const uint32_t* levelBlocks = index->levelBlocks + (size_t)level * index->levelBlockCapacity;
+        unsigned int first = 0;
+        unsigned int last = index->levelBlockCounts[level];
+        while (first < last) {
+            unsigned int mid = first + (last - first) / 2;
+            if (levelBlocks[mid] < cursor->nextBlock) {
+                first = mid + 1;
+            }
+
+            else {
+                last = mid;
+            }
+        }
+        cursor->levelPositions[level] = first;
+    }
+}
+
+int logIndexCursorNext(LogIndexCursor_s* cursor, unsigned int* block)
+{
+    if (cursor->byLevel == 0) {
+        if (cursor->nextBlock >= cursor->blockCount) {
+            return 0;
+        }
+
+        *block = cursor->nextBlock++;
+        return 1;
+    }
+
+    // The lists of the log levels of the query are merged, a block holding several of them is walked once.
+    const LogIndex_s* index = cursor->index;
+    unsigned int next = cursor->blockCount;
+    for (unsigned int level = 0; level < LOG_INDEX_LEVELS; level++) {
+        const uint32_t* levelBlocks = index->levelBlocks + (size_t)level * index->levelBlockCapacity;
+        if ((cursor->logLevelMask & (1u << level)) != 0 && cursor->levelPositions[level] < index->levelBlockCounts[level]
+            && levelBlocks[cursor->levelPositions[level]] < next) {
+            next = levelBlocks[cursor->levelPositions[level]];
+        }
+    }
+
+    if (next >= cursor->blockCount) {
+        return 0;
+    }
+
+    for (unsigned int level = 0; level < LOG_INDEX_LEVELS; level++) {
+        const uint32_t* levelBlocks = index->levelBlocks + (size_t)level * index->levelBlockCapacity;
+        if (cursor->levelPositions[level] < index->levelBlockCounts[level] && levelBlocks[cursor->levelPositions[level]] == next) {
+            cursor->levelPositions[level]++;
+        }
+    }
+
+    *block = next;
+    return 1;
+}
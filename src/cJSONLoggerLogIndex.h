@@ -0,0 +1,167 @@
+/**
+ * @file cJSONLoggerLogIndex.h
+ *
+ * @brief This file contains the interface of the query index of the logs of a node of the cJSON logger library.
+ *
+ * @note The logs of a node are summarized per block of LOG_BLOCK_LEN consecutive logs. The index of an ordered node (logs
+ * only appended) also keeps, per log level, the list of the blocks holding that log level and a running max time stamp,
+ * so a query starts at the first block of its time range and only visits the blocks holding its log levels.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_LOG_INDEX_H
+#define CJSON_LOGGER_LOG_INDEX_H
+
+#include <stdint.h>
+
+/**
+ * @def LOG_BLOCK_LEN
+ *
+ * @brief Number of consecutive logs of a node summarized by a block of the query index.
+ */
+#define LOG_BLOCK_LEN 64
+
+/**
+ * @def LOG_INDEX_LEVELS
+ *
+ * @brief Number of log level bits of the query index, out of range log levels share the last one.
+ */
+#define LOG_INDEX_LEVELS 8
+
+/**
+ * @struct LogBlock
+ *
+ * @brief Summary of LOG_BLOCK_LEN consecutive logs of a node, lets the queries skip the blocks that can not match.
+ *
+ * @var minTimeStamp The oldest time stamp of the block.
+ * @var maxTimeStamp The newest time stamp of the block.
+ * @var prefixMaxTimeStamp The newest time stamp of the block and the blocks before it, only kept by an ordered index.
+ * @var callSiteMask Bit (call site id % 64) set for every call site of the block.
+ * @var logLevelMask Bit (log level) set for every log level of the block.
+ */
+typedef struct LogBlock {
+    int64_t minTimeStamp;
+    int64_t maxTimeStamp;
+    int64_t prefixMaxTimeStamp;
+    uint64_t callSiteMask;
+    uint8_t logLevelMask;
+} LogBlock_s;
+
+/**
+ * @struct LogIndex
+ *
+ * @brief Query index of the logs of a node.
+ *
+ * @var blocks One block per LOG_BLOCK_LEN logs.
+ * @var levelBlocks Per log level bit, the increasing positions of the blocks holding the log level, levelBlockCapacity
+ * entries per log level, NULL for an index that is not ordered (the logs of a capped node replace each other).
+ * @var levelBlockCounts Per log level bit, the number of blocks in its list.
+ * @var levelBlockCapacity Allocated size of the list of every log level.
+ */
+typedef struct LogIndex {
+    LogBlock_s* blocks;
+    uint32_t* levelBlocks;
+    unsigned int levelBlockCounts[LOG_INDEX_LEVELS];
+    unsigned int levelBlockCapacity;
+} LogIndex_s;
+
+/**
+ * @struct LogIndexCursor
+ *
+ * @brief Walk over the blocks of an index that may hold logs of a query, in increasing positions.
+ *
+ * @var index The walked index.
+ * @var blockCount Number of blocks holding logs.
+ * @var logLevelMask Bit (log level) set for every log level of the query.
+ * @var nextBlock Position of the next block of a walk over every block.
+ * @var levelPositions Per log level bit, position of the next block in its list.
+ * @var byLevel Whether the walk follows the lists of the log levels of the query.
+ */
+typedef struct LogIndexCursor {
+    const LogIndex_s* index;
+    unsigned int blockCount;
+    uint8_t logLevelMask;
+    unsigned int nextBlock;
+    unsigned int levelPositions[LOG_INDEX_LEVELS];
+    int byLevel;
+} LogIndexCursor_s;
+
+/**
+ * @brief Get the bit of a log level in the log level masks of the query index.
+ *
+ * @param logLevel The log level, out of range log levels share the last bit.
+ *
+ * @return uint8_t, the bit of the log level.
+ */
+static inline uint8_t logLevelMaskBit(unsigned int logLevel)
+{
+    return (uint8_t)(1u << (logLevel < LOG_INDEX_LEVELS - 1 ? logLevel : LOG_INDEX_LEVELS - 1));
+}
+
+/**
+ * @brief Size an index for a number of logs, the blocks (and lists) already indexed are kept.
+ *
+ * @param index The index to size.
+ * @param logCapacity The number of logs the index will hold.
+ * @param ordered Whether the logs are only appended, an index that is not ordered keeps no lists of blocks per log level.
+ *
+ * @return int, 0 in case of success, negative value in case of failure (the index keeps its previous size).
+ */
+int logIndexReserve(LogIndex_s* index, unsigned int logCapacity, int ordered);
+
+/**
+ * @brief Release the memory of an index.
+ *
+ * @param index The index to release.
+ */
+void logIndexFree(LogIndex_s* index);
+
+/**
+ * @brief Empty the lists of blocks per log level of an index, before its logs are indexed again.
+ *
+ * @param index The index to empty.
+ */
+void logIndexClear(LogIndex_s* index);
+
+/**
+ * @brief Add a log to the block of an index holding it.
+ *
+ * @note The logs of an ordered index must be added in increasing positions.
+ *
+ * @param index The index.
+ * @param logIndex The position of the log.
+ * @param timeStamp The time stamp of the log.
+ * @param callSite The call site id of the log.
+ * @param logLevel The log level of the log.
+ * @param startsBlock Whether the log is the first one of its block, the previous summary of the block is dropped.
+ */
+void logIndexAdd(LogIndex_s* index, unsigned int logIndex, int64_t timeStamp, uint32_t callSite, unsigned int logLevel, int startsBlock);
+
+/**
+ * @brief Start a walk over the blocks of an index that may hold logs of a query.
+ *
+ * @note An ordered index starts at the first block that may hold a time stamp not older than fromTimeStamp and only walks
+ * the blocks holding the log levels of the query, the walked blocks must still be checked against the query.
+ *
+ * @param cursor The cursor to start.
+ * @param index The index to walk.
+ * @param blockCount Number of blocks holding logs.
+ * @param logLevelMask Bit (log level) set for every log level of the query.
+ * @param fromTimeStamp The oldest time stamp of the query.
+ */
+void logIndexCursorInit(LogIndexCursor_s* cursor, const LogIndex_s* index, unsigned int blockCount, uint8_t logLevelMask, int64_t fromTimeStamp);
+
+/**
+ * @brief Get the next block of a walk.
+ *
+ * @param cursor The cursor of the walk.
+ * @param block Where the position of the block will be stored.
+ *
+ * @return int, 1 if a block was stored, 0 once the walk is over.
+ */
+int logIndexCursorNext(LogIndexCursor_s* cursor, unsigned int* block);
+
+#endif // CJSON_LOGGER_LOG_INDEX_H
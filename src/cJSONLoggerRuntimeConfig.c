@@ -0,0 +1,214 @@
+/**
+ * @file cJSONLoggerRuntimeConfig.c
+ *
+ * @brief This file contains the implementation of the runtime configuration (per path log levels and rate limits) read by the logging threads.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerRuntimeConfig.h"
+#include "cJSONLoggerAssert.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+/**
+ * @brief The published runtime configuration snapshot, NULL if none.
+ */
+static _Atomic(RuntimeConfig_s*) s_g_runtimeConfig = NULL;
+
+/**
+ * @brief Read epoch, its parity selects the reader counter the new readers use.
+ */
+static atomic_uint s_g_runtimeConfigEpoch = 0;
+
+/**
+ * @brief Number of readers of each epoch parity.
+ */
+static atomic_uint s_g_runtimeConfigReaders[2] = { 0, 0 };
+
+/**
+ * @brief Mutex serializing the publications.
+ */
+static pthread_mutex_t s_g_runtimeConfigPublishMutex = PTHREAD_MUTEX_INITIALIZER;
+
+RuntimeConfig_s* runtimeConfigCreate(size_t ruleCount)
+{
+    RuntimeConfig_s* config = (RuntimeConfig_s*)calloc(1, sizeof(RuntimeConfig_s));
+    CJSON_LOGGER_ASSERT_NEQ(config, NULL);
+    if (config == NULL) {
+        return NULL;
+    }
+
+    if (ruleCount > 0) {
+        config->rules = (RuntimeRule_s*)calloc(ruleCount, sizeof(RuntimeRule_s));
+        CJSON_LOGGER_ASSERT_NEQ(config->rules, NULL);
+        if (config->rules == NULL) {
+            free(config);
+            return NULL;
+        }
+    }
+
+    config->ruleCount = ruleCount;
+    config->mostVerboseLogLevel = __CJSON_LOG_LEVEL_START;
+
+    return config;
+}
+
+int runtimeConfigSetRule(RuntimeConfig_s* config, size_t index, const char* const* jsonPath, size_t jsonPathDepth, CJSON_LOG_LEVEL_E logLevel,
+    unsigned int rateLimit, unsigned int rateBurst)
+{
+    if (index >= config->ruleCount || jsonPath == NULL || jsonPathDepth == 0 || logLevel >= __CJSON_LOG_LEVEL_END) {
+        return -1;
+    }
+
+    RuntimeRule_s* rule = &config->rules[index];
+    rule->jsonPath = (char**)calloc(jsonPathDepth, sizeof(char*));
+    CJSON_LOGGER_ASSERT_NEQ(rule->jsonPath, NULL);
+    if (rule->jsonPath == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < jsonPathDepth; i++) {
+        rule->jsonPath[i] = strdup(jsonPath[i]);
+        CJSON_LOGGER_ASSERT_NEQ(rule->jsonPath[i], NULL);
+        if (rule->jsonPath[i] == NULL) {
+            return -1;
+        }
+
+        rule->jsonPathDepth++;
+    }
+
+    rule->logLevel = logLevel;
+    if (logLevel > config->mostVerboseLogLevel) {
+        config->mostVerboseLogLevel = logLevel;
+    }
+
+    if (rateLimit != 0) {
+        rule->rateIntervalNs = 1000000000ULL / rateLimit;
+        rule->rateBurstNs = (rateBurst != 0 ? rateBurst : 1) * rule->rateIntervalNs;
+    }
+
+    return 0;
+}
+
+void runtimeConfigDelete(RuntimeConfig_s* config)
+{
+    if (config == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < config->ruleCount; i++) {
+        for (size_t j = 0; j < config->rules[i].jsonPathDepth; j++) {
+            free(config->rules[i].jsonPath[j]);
+        }
+
+        free(config->rules[i].jsonPath);
+    }
+
+    free(config->rules);
+    free(config);
+}
+
+void runtimeConfigPublish(RuntimeConfig_s* config)
+{
+    pthread_mutex_lock(&s_g_runtimeConfigPublishMutex);
+    RuntimeConfig_s* oldConfig = atomic_exchange(&s_g_runtimeConfig, config);
+
+    // Two epoch flips, a reader that read the epoch before a previous publication may still count on either parity.
+    for (int phase = 0; oldConfig != NULL && phase < 2; phase++) {
+        unsigned int epoch = atomic_fetch_add(&s_g_runtimeConfigEpoch, 1) & 1;
+        while (atomic_load(&s_g_runtimeConfigReaders[epoch]) != 0) {
+            sched_yield();
+        }
+    }
+    pthread_mutex_unlock(&s_g_runtimeConfigPublishMutex);
+
+    runtimeConfigDelete(oldConfig);
+}
+
+const RuntimeConfig_s* runtimeConfigReadLock(unsigned int* epoch)
+{
+    // Nothing to protect while no snapshot is published, the logs do not pay for the runtime configuration.
+    if (atomic_load_explicit(&s_g_runtimeConfig, memory_order_relaxed) == NULL) {
+        return NULL;
+    }
+
+    *epoch = atomic_load(&s_g_runtimeConfigEpoch) & 1;
+    atomic_fetch_add(&s_g_runtimeConfigReaders[*epoch], 1);
+
+    const RuntimeConfig_s* config = atomic_load(&s_g_runtimeConfig);
+    if (config == NULL) {
+        atomic_fetch_sub(&s_g_runtimeConfigReaders[*epoch], 1);
+    }
+
+    return config;
+}
+
+void runtimeConfigReadUnlock(unsigned int epoch)
+{
+    atomic_fetch_sub(&s_g_runtimeConfigReaders[epoch], 1);
+}
+
+RuntimeRule_s* runtimeConfigMatch(const RuntimeConfig_s* config, const char* const* jsonPath, size_t jsonPathDepth)
+{
+    if (config == NULL) {
+        return NULL;
+    }
+
+    RuntimeRule_s* match = NULL;
+    for (size_t i = 0; i < config->ruleCount; i++) {
+        RuntimeRule_s* rule = &config->rules[i];
+        if (rule->jsonPathDepth > jsonPathDepth || (match != NULL && rule->jsonPathDepth <= match->jsonPathDepth)) {
+            continue;
+        }
+
+        size_t depth = 0;
+        while (depth < rule->jsonPathDepth && strcasecmp(rule->jsonPath[depth], jsonPath[depth]) == 0) {
+            depth++;
+        }
+
+        if (depth == rule->jsonPathDepth) {
+            match = rule;
+        }
+    }
+
+    return match;
+}
+
+int runtimeRuleAdmit(RuntimeRule_s* rule)
+{
+    if (rule->rateIntervalNs == 0) {
+        return 1;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+
+    // Generic cell rate algorithm, a log is admitted while the theoretical arrival time stays within the burst.
+    uint_fast64_t tat = atomic_load_explicit(&rule->rateTat, memory_order_relaxed);
+    for (;;) {
+        uint64_t newTat = (tat > now ? tat : now) + rule->rateIntervalNs;
+        if (newTat - now > rule->rateBurstNs) {
+            return 0;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&rule->rateTat, &tat, newTat, memory_order_relaxed, memory_order_relaxed)) {
+            return 1;
+        }
+    }
+}
+
+void runtimeConfigAtForkChild(void)
+{
+    pthread_mutex_init(&s_g_runtimeConfigPublishMutex, NULL);
+    atomic_store(&s_g_runtimeConfigReaders[0], 0);
+    atomic_store(&s_g_runtimeConfigReaders[1], 0);
+}
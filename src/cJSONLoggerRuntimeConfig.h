@@ -0,0 +1,138 @@
+/**
+ * @file cJSONLoggerRuntimeConfig.h
+ *
+ * @brief This file contains the interface of the runtime configuration (per path log levels and rate limits) read by the logging threads.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_RUNTIME_CONFIG_H
+#define CJSON_LOGGER_RUNTIME_CONFIG_H
+
+#include "cJSONLogger.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/**
+ * @struct RuntimeRule
+ *
+ * @brief Settings applied to the logs of a JSON node and its children.
+ *
+ * @var jsonPath The names of the JSON nodes, compared case insensitively.
+ * @var jsonPathDepth The number of names in the jsonPath.
+ * @var logLevel The log level severity threshold of the node, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @var rateIntervalNs Nanoseconds between two admitted logs at the sustained rate, 0 for no rate limit.
+ * @var rateBurstNs Nanoseconds of logs admitted ahead of the sustained rate (burst * rateIntervalNs).
+ * @var rateTat Theoretical arrival time (CLOCK_MONOTONIC nanoseconds) of the next log at the sustained rate.
+ */
+typedef struct RuntimeRule {
+    char** jsonPath;
+    size_t jsonPathDepth;
+    CJSON_LOG_LEVEL_E logLevel;
+    uint64_t rateIntervalNs;
+    uint64_t rateBurstNs;
+    atomic_uint_fast64_t rateTat;
+} RuntimeRule_s;
+
+/**
+ * @struct RuntimeConfig
+ *
+ * @brief Immutable snapshot of the runtime configuration, replaced as a whole by runtimeConfigPublish().
+ *
+ * @var rules The rules, the deepest rule matching a log applies.
+ * @var ruleCount The number of rules.
+ * @var mostVerboseLogLevel The most verbose log level of the rules, used to let the logs through the level check of the logger.
+ */
+typedef struct RuntimeConfig {
+    RuntimeRule_s* rules;
+    size_t ruleCount;
+    CJSON_LOG_LEVEL_E mostVerboseLogLevel;
+} RuntimeConfig_s;
+
+/**
+ * @brief Create a runtime configuration snapshot with empty rules.
+ *
+ * @param ruleCount The number of rules.
+ *
+ * @return RuntimeConfig_s* ptr of the new snapshot, NULL in case of failure.
+ */
+RuntimeConfig_s* runtimeConfigCreate(size_t ruleCount);
+
+/**
+ * @brief Set a rule of a runtime configuration snapshot that has not been published yet.
+ *
+ * @param config The snapshot.
+ * @param index The index of the rule.
+ * @param jsonPath The names of the JSON nodes, copied.
+ * @param jsonPathDepth The number of names in the jsonPath.
+ * @param logLevel The log level severity threshold of the node, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @param rateLimit The number of logs per second admitted, 0 for no rate limit.
+ * @param rateBurst The number of logs admitted at once above the rate limit, 0 for 1.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int runtimeConfigSetRule(RuntimeConfig_s* config, size_t index, const char* const* jsonPath, size_t jsonPathDepth, CJSON_LOG_LEVEL_E logLevel,
+    unsigned int rateLimit, unsigned int rateBurst);
+
+/**
+ * @brief Free a runtime configuration snapshot that is not published.
+ *
+ * @param config The snapshot to free.
+ */
+void runtimeConfigDelete(RuntimeConfig_s* config);
+
+/**
+ * @brief Publish a runtime configuration snapshot, the previous one is freed once no logging thread reads it anymore.
+ *
+ * @note Only the publishing thread waits for the readers, the readers never wait.
+ *
+ * @param config The snapshot to publish, owned by the runtime configuration, NULL to remove the runtime configuration.
+ */
+void runtimeConfigPublish(RuntimeConfig_s* config);
+
+/**
+ * @brief Start reading the published runtime configuration snapshot.
+ *
+ * @param epoch Where the read epoch will be stored, passed to runtimeConfigReadUnlock().
+ *
+ * @return const RuntimeConfig_s* ptr of the snapshot, valid until runtimeConfigReadUnlock(), NULL if none is published
+ * (runtimeConfigReadUnlock() must not be called).
+ */
+const RuntimeConfig_s* runtimeConfigReadLock(unsigned int* epoch);
+
+/**
+ * @brief Stop reading the runtime configuration snapshot returned by runtimeConfigReadLock().
+ *
+ * @param epoch The read epoch returned by runtimeConfigReadLock().
+ */
+void runtimeConfigReadUnlock(unsigned int epoch);
+
+/**
+ * @brief Find the deepest rule of a snapshot whose JSON path is a prefix of a log JSON path.
+ *
+ * @param config The snapshot, can be NULL.
+ * @param jsonPath The names of the JSON nodes of the log.
+ * @param jsonPathDepth The number of names in the jsonPath.
+ *
+ * @return RuntimeRule_s* ptr of the rule, NULL if no rule matches.
+ */
+RuntimeRule_s* runtimeConfigMatch(const RuntimeConfig_s* config, const char* const* jsonPath, size_t jsonPathDepth);
+
+/**
+ * @brief Check the rate limit of a rule and count a log towards it, lock free.
+ *
+ * @param rule The rule.
+ *
+ * @return int, 1 if the log is admitted, 0 if it is over the rate limit.
+ */
+int runtimeRuleAdmit(RuntimeRule_s* rule);
+
+/**
+ * @brief Reset the readers of the runtime configuration in a forked child, only the forking thread exists in it.
+ */
+void runtimeConfigAtForkChild(void);
+
+#endif // CJSON_LOGGER_RUNTIME_CONFIG_H
@@ -0,0 +1,470 @@
+/**
+ * @file cJSONLoggerShmRing.h
+ *
+ * @brief This file contains the layout of the shared memory ring the cJSON logger library writes its records to.
+ *
+ * @note The layout is shared between the library (producers) and the collector tool (consumer), both sides must be built from the same version of this file.
+ * The ring is a bounded lock free multi producer multi consumer queue (D. Vyukov), every slot carries a sequence number telling whether it is free or holds a record.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_SHM_RING_H
+#define CJSON_LOGGER_SHM_RING_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @def SHM_RING_MAGIC
+ *
+ * @brief Magic number marking an initialized ring ("CJLR").
+ */
+#define SHM_RING_MAGIC 0x434a4c52u
+
+/**
+ * @def SHM_RING_VERSION
+ *
+ * @brief Version of the ring layout.
+ */
+#define SHM_RING_VERSION 3u
+
+/**
+ * @def SHM_RING_SLOT_DATA_LEN
+ *
+ * @brief Size of the variable length data (path, call site and message) of a record.
+ */
+#define SHM_RING_SLOT_DATA_LEN 978
+
+/**
+ * @def SHM_RING_DEFAULT_CAPACITY
+ *
+ * @brief Default number of slots of the ring.
+ */
+#define SHM_RING_DEFAULT_CAPACITY 4096
+
+/**
+ * @def SHM_RING_COMMIT_TIMEOUT_MS
+ *
+ * @brief Time after which a reserved slot whose record is still not committed is taken for abandoned (e.g. its producer died).
+ */
+#define SHM_RING_COMMIT_TIMEOUT_MS 1000
+
+/**
+ * @struct ShmRingHeader
+ *
+ * @brief Header at the start of the shared memory, the slots follow it.
+ *
+ * @var magic SHM_RING_MAGIC once the ring is initialized, stored last by the initializer.
+ * @var version The layout version, SHM_RING_VERSION.
+ * @var capacity The number of slots, a power of two.
+ * @var timeFormat The CJSON_LOGGER_TIME_FORMAT_E the logger prints its time stamps with, so the collector prints the same ones.
+ * @var enqueuePos Position of the next slot producers write to.
+ * @var dequeuePos Position of the next slot consumers read from.
+ * @var dropped Number of records dropped because the ring was full or the record too large.
+ */
+typedef struct ShmRingHeader {
+    _Atomic uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    _Atomic int32_t timeFormat;
+    _Alignas(64) _Atomic uint64_t enqueuePos;
+    _Alignas(64) _Atomic uint64_t dequeuePos;
+    _Alignas(64) _Atomic uint64_t dropped;
+} ShmRingHeader_s;
+
+/**
+ * @struct ShmRingSlot
+ *
+ * @brief A slot of the ring holding one log record.
+ *
+ * @note The data holds, each NUL terminated, the pathDepth node names, the file name, the function name and the message.
+ *
+ * @var sequence Equal to the position of the slot when free, to the position + 1 when it holds a record.
+ * @var timeStamp Time stamp of the record in nanoseconds since the epoch.
+ * @var recordSequence Sequence number of the record, 0 if not set.
+ * @var logLevel Log level of the record, a CJSON_LOG_LEVEL_E value.
+ * @var fileLine File line of the call site, 0 if not set.
+ * @var threadId Id of the logging thread, 0 if not set.
+ * @var pathDepth Number of node names of the record path.
+ * @var pathLen Length of the node names, NUL included.
+ * @var fileNameLen Length of the file name, 0 if not set.
+ * @var funcNameLen Length of the function name, 0 if not set.
+ * @var msgLen Length of the message.
+ * @var data The variable length data of the record.
+ */
+typedef struct ShmRingSlot {
+    _Atomic uint64_t sequence;
+    int64_t timeStamp;
+    uint64_t recordSequence;
+    int32_t logLevel;
+    int32_t fileLine;
+    uint32_t threadId;
+    uint16_t pathDepth;
+    uint16_t pathLen;
+    uint16_t fileNameLen;
+    uint16_t funcNameLen;
+    uint16_t msgLen;
+    char data[SHM_RING_SLOT_DATA_LEN];
+} ShmRingSlot_s;
+
+_Static_assert(sizeof(ShmRingSlot_s) == 1024, "the slot layout must not depend on the compiler");
+
+/**
+ * @brief Get the size of the shared memory of a ring.
+ *
+ * @param capacity The number of slots of the ring.
+ *
+ * @return size_t, the size in bytes.
+ */
+static inline size_t shmRingSize(uint64_t capacity)
+{
+    return sizeof(ShmRingHeader_s) + (size_t)capacity * sizeof(ShmRingSlot_s);
+}
+
+/**
+ * @brief Get a slot of a ring.
+ *
+ * @param header The header of the ring.
+ * @param pos The position of the slot.
+ *
+ * @return ShmRingSlot_s* ptr of the slot.
+ */
+static inline ShmRingSlot_s* shmRingSlot(ShmRingHeader_s* header, uint64_t pos)
+{
+    return (ShmRingSlot_s*)(header + 1) + (pos & (header->capacity - 1));
+}
+
+/**
+ * @brief Initialize the header and the slots of a ring.
+ *
+ * @param header The header of the ring.
+ * @param capacity The number of slots of the ring, a power of two.
+ */
+static inline void shmRingInit(ShmRingHeader_s* header, uint64_t capacity)
+{
+    atomic_store_explicit(&header->magic, 0, memory_order_relaxed);
+    header->version = SHM_RING_VERSION;
+    header->capacity = capacity;
+
+    // CJSON_LOGGER_TIME_LOCAL until the logger owning the ring sets its format.
+    atomic_store_explicit(&header->timeFormat, 0, memory_order_relaxed);
+
+    for (uint64_t pos = 0; pos < capacity; pos++) {
+        atomic_store_explicit(&shmRingSlot(header, pos)->sequence, pos, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&header->enqueuePos, 0, memory_order_relaxed);
+    atomic_store_explicit(&header->dequeuePos, 0, memory_order_relaxed);
+    atomic_store_explicit(&header->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&header->magic, SHM_RING_MAGIC, memory_order_release);
+}
+
+/**
+ * @brief Check that the shared memory holds an initialized ring of this layout version.
+ *
+ * @param header The header of the ring.
+ * @param size The size of the shared memory.
+ *
+ * @return int, 1 if the ring is valid, 0 otherwise.
+ */
+static inline int shmRingIsValid(ShmRingHeader_s* header, size_t size)
+{
+    return size >= sizeof(ShmRingHeader_s)
+        && atomic_load_explicit(&header->magic, memory_order_acquire) == SHM_RING_MAGIC
+        && header->version == SHM_RING_VERSION
+        && header->capacity > 0
+        && (header->capacity & (header->capacity - 1)) == 0
+        && size >= shmRingSize(header->capacity);
+}
+
+/**
+ * @brief Reserve a free slot to write a record to.
+ *
+ * @note The record becomes visible to the consumers with shmRingCommit().
+ *
+ * @param header The header of the ring.
+ * @param pos Where the position of the reserved slot will be stored.
+ *
+ * @return ShmRingSlot_s* ptr of the reserved slot, NULL if the ring is full.
+ */
+static inline ShmRingSlot_s* shmRingReserve(ShmRingHeader_s* header, uint64_t* pos)
+{
+    uint64_t enqueuePos = atomic_load_explicit(&header->enqueuePos, memory_order_relaxed);
+    for (;;) {
+        ShmRingSlot_s* slot = shmRingSlot(header, enqueuePos);
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int64_t diff = (int64_t)(sequence - enqueuePos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&header->enqueuePos, &enqueuePos, enqueuePos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                *pos = enqueuePos;
+                return slot;
+            }
+        }
+
+        else if (diff < 0) {
+            return NULL;
+        }
+
+        else {
+            enqueuePos = atomic_load_explicit(&header->enqueuePos, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Publish a record written to a slot reserved with shmRingReserve().
+ *
+ * @param slot The reserved slot.
+ * @param pos The position of the reserved slot.
+ */
+static inline void shmRingCommit(ShmRingSlot_s* slot, uint64_t pos)
+{
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+/**
+ * @brief Take the oldest record of the ring.
+ *
+ * @note The slot must be handed back with shmRingRelease() once the record has been read.
+ *
+ * @param header The header of the ring.
+ * @param pos Where the position of the taken slot will be stored.
+ *
+ * @return ShmRingSlot_s* ptr of the taken slot, NULL if the ring is empty.
+ */
+static inline ShmRingSlot_s* shmRingTake(ShmRingHeader_s* header, uint64_t* pos)
+{
+    uint64_t dequeuePos = atomic_load_explicit(&header->dequeuePos, memory_order_relaxed);
+    for (;;) {
+        ShmRingSlot_s* slot = shmRingSlot(header, dequeuePos);
+        uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int64_t diff = (int64_t)(sequence - (dequeuePos + 1));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&header->dequeuePos, &dequeuePos, dequeuePos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                *pos = dequeuePos;
+                return slot;
+            }
+        }
+
+        else if (diff < 0) {
+            return NULL;
+        }
+
+        else {
+            dequeuePos = atomic_load_explicit(&header->dequeuePos, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Hand back a slot taken with shmRingTake() to the producers.
+ *
+ * @param header The header of the ring.
+ * @param slot The taken slot.
+ * @param pos The position of the taken slot.
+ */
+static inline void shmRingRelease(ShmRingHeader_s* header, ShmRingSlot_s* slot, uint64_t pos)
+{
+    atomic_store_explicit(&slot->sequence, pos + header->capacity, memory_order_release);
+}
+
+/**
+ * @brief Check whether the oldest slot of a ring is reserved by a producer that did not commit its record yet.
+ *
+ * @note A producer commits its record right after reserving the slot, a slot that stays uncommitted longer than
+ * SHM_RING_COMMIT_TIMEOUT_MS was abandoned and blocks the consumers until it is skipped with shmRingSkip().
+ *
+ * @param header The header of the ring.
+ * @param pos Where the position of the slot will be stored.
+ *
+ * @return int, 1 if the oldest slot is reserved and uncommitted, 0 otherwise (the ring is empty or the record is committed).
+ */
+static inline int shmRingUncommitted(ShmRingHeader_s* header, uint64_t* pos)
+{
+    uint64_t dequeuePos = atomic_load_explicit(&header->dequeuePos, memory_order_relaxed);
+    if (atomic_load_explicit(&header->enqueuePos, memory_order_relaxed) == dequeuePos) {
+        return 0;
+    }
+
+    *pos = dequeuePos;
+    return atomic_load_explicit(&shmRingSlot(header, dequeuePos)->sequence, memory_order_acquire) != dequeuePos + 1;
+}
+
+/**
+ * @brief Skip an abandoned slot found by shmRingUncommitted(), the slot is handed back to the producers.
+ *
+ * @warning A producer committing the slot after the skip corrupts the ring, only skip a slot that stayed uncommitted
+ * for SHM_RING_COMMIT_TIMEOUT_MS.
+ *
+ * @param header The header of the ring.
+ * @param pos The position of the slot.
+ *
+ * @return int, 1 if the slot was skipped, 0 if another consumer took it first.
+ */
+static inline int shmRingSkip(ShmRingHeader_s* header, uint64_t pos)
+{
+    uint64_t dequeuePos = pos;
+    if (!atomic_compare_exchange_strong_explicit(&header->dequeuePos, &dequeuePos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+        return 0;
+    }
+
+    shmRingRelease(header, shmRingSlot(header, pos), pos);
+    return 1;
+}
+
+/**
+ * @brief Get a record of a ring without taking it.
+ *
+ * @warning Only for rings with a single consumer, the records are handed back with shmRingConsume().
+ *
+ * @param header The header of the ring.
+ * @param offset The offset of the record from the oldest one.
+ *
+ * @return ShmRingSlot_s* ptr of the slot holding the record, NULL if the ring holds fewer records.
+ */
+static inline ShmRingSlot_s* shmRingPeek(ShmRingHeader_s* header, uint64_t offset)
+{
+    uint64_t pos = atomic_load_explicit(&header->dequeuePos, memory_order_relaxed) + offset;
+    ShmRingSlot_s* slot = shmRingSlot(header, pos);
+
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) == pos + 1 ? slot : NULL;
+}
+
+/**
+ * @brief Hand back the oldest records of a ring read with shmRingPeek() to the producers.
+ *
+ * @warning Only for rings with a single consumer.
+ *
+ * @param header The header of the ring.
+ * @param count The number of records to hand back.
+ */
+static inline void shmRingConsume(ShmRingHeader_s* header, uint64_t count)
+{
+    uint64_t dequeuePos = atomic_load_explicit(&header->dequeuePos, memory_order_relaxed);
+    atomic_store_explicit(&header->dequeuePos, dequeuePos + count, memory_order_relaxed);
+
+    for (uint64_t pos = dequeuePos; pos < dequeuePos + count; pos++) {
+        shmRingRelease(header, shmRingSlot(header, pos), pos);
+    }
+}
+
+/**
+ * @brief Copy a string into the data of a slot.
+ *
+ * @param data The data of the slot.
+ * @param offset The offset to copy to, advanced past the copied string and its NUL.
+ * @param str The string to copy, NULL copies an empty string.
+ * @param maxLen The max length of the string to copy, longer strings are truncated.
+ *
+ * @return size_t, the length of the copied string.
+ */
+static inline size_t shmRingSlotCopy(char* data, size_t* offset, const char* str, size_t maxLen)
+{
+    size_t len = str != NULL ? strnlen(str, maxLen) : 0;
+    memcpy(data + *offset, str != NULL ? str : "", len);
+    data[*offset + len] = '\0';
+    *offset += len + 1;
+
+    return len;
+}
+
+/**
+ * @brief Write a log record to a ring.
+ *
+ * @note The write never blocks, the record is dropped (and counted) when the ring is full or its path does not fit a slot.
+ * The call site and the message are truncated to the space left by the path.
+ *
+ * @param header The header of the ring.
+ * @param jsonPath The names of the JSON nodes the record belongs to.
+ * @param jsonPathDepth The number of names in the jsonPath.
+ * @param timeStamp The time stamp of the record in nanoseconds since the epoch.
+ * @param logLevel The log level of the record.
+ * @param fileName The file name of the call site, can be NULL.
+ * @param funcName The function name of the call site, can be NULL.
+ * @param fileLine The file line of the call site, 0 if not set.
+ * @param logMsg The log message.
+ * @param recordSequence The sequence number of the record, 0 if not set.
+ * @param threadId The id of the logging thread, 0 if not set.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static inline int shmRingWrite(ShmRingHeader_s* header, const char* const* jsonPath, size_t jsonPathDepth, int64_t timeStamp, int32_t logLevel,
+    const char* fileName, const char* funcName, int32_t fileLine, const char* logMsg, uint64_t recordSequence, uint32_t threadId)
+{
+    size_t pathLen = 0;
+    for (size_t i = 0; i < jsonPathDepth; i++) {
+        pathLen += strlen(jsonPath[i]) + 1;
+    }
+
+    uint64_t pos = 0;
+    ShmRingSlot_s* slot = NULL;
+    if (jsonPathDepth > UINT16_MAX || pathLen + 3 > SHM_RING_SLOT_DATA_LEN || (slot = shmRingReserve(header, &pos)) == NULL) {
+        atomic_fetch_add_explicit(&header->dropped, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < jsonPathDepth; i++) {
+        shmRingSlotCopy(slot->data, &offset, jsonPath[i], SHM_RING_SLOT_DATA_LEN);
+    }
+
+    slot->timeStamp = timeStamp;
+    slot->recordSequence = recordSequence;
+    slot->logLevel = logLevel;
+    slot->fileLine = fileLine;
+    slot->threadId = threadId;
+    slot->pathDepth = (uint16_t)jsonPathDepth;
+    slot->pathLen = (uint16_t)pathLen;
+    slot->fileNameLen = (uint16_t)shmRingSlotCopy(slot->data, &offset, fileName, (SHM_RING_SLOT_DATA_LEN - offset - 3) / 4);
+    slot->funcNameLen = (uint16_t)shmRingSlotCopy(slot->data, &offset, funcName, (SHM_RING_SLOT_DATA_LEN - offset - 2) / 4);
+    slot->msgLen = (uint16_t)shmRingSlotCopy(slot->data, &offset, logMsg, SHM_RING_SLOT_DATA_LEN - offset - 1);
+
+    shmRingCommit(slot, pos);
+
+    return 0;
+}
+
+/**
+ * @brief Get the file name of the record held by a slot.
+ *
+ * @param slot The slot holding the record.
+ *
+ * @return const char* ptr of the file name, NULL if not set.
+ */
+static inline const char* shmRingSlotFileName(const ShmRingSlot_s* slot)
+{
+    return slot->fileNameLen != 0 ? slot->data + slot->pathLen : NULL;
+}
+
+/**
+ * @brief Get the function name of the record held by a slot.
+ *
+ * @param slot The slot holding the record.
+ *
+ * @return const char* ptr of the function name, NULL if not set.
+ */
+static inline const char* shmRingSlotFuncName(const ShmRingSlot_s* slot)
+{
+    return slot->funcNameLen != 0 ? slot->data + slot->pathLen + slot->fileNameLen + 1 : NULL;
+}
+
+/**
+ * @brief Get the message of the record held by a slot.
+ *
+ * @param slot The slot holding the record.
+ *
+ * @return const char* ptr of the message.
+ */
+static inline const char* shmRingSlotLogMsg(const ShmRingSlot_s* slot)
+{
+    return slot->data + slot->pathLen + slot->fileNameLen + slot->funcNameLen + 2;
+}
+
+#endif // CJSON_LOGGER_SHM_RING_H
@@ -0,0 +1,131 @@
+/**
+ * @file cJSONLoggerShmSink.c
+ *
+ * @brief This file contains the implementation of the sink writing the log records to a shared memory ring.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerShmSink.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerShmRing.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @struct ShmSink
+ *
+ * @brief Shared memory sink.
+ *
+ * @var header The mapped ring.
+ * @var size The size of the mapping.
+ */
+struct ShmSink {
+    ShmRingHeader_s* header;
+    size_t size;
+};
+
+/**
+ * @brief Check whether the oldest slot of a ring stays reserved without being committed, which blocks the ring for good.
+ *
+ * @param header The header of the ring.
+ *
+ * @return int, 1 if the slot stayed uncommitted for SHM_RING_COMMIT_TIMEOUT_MS, 0 otherwise.
+ */
+static int shmSinkRingBlocked(ShmRingHeader_s* header)
+{
+    uint64_t pos = 0;
+    uint64_t blockedPos = 0;
+    unsigned int waitedMs = 0;
+
+    // The wait restarts whenever a consumer moves on to another slot.
+    while (shmRingUncommitted(header, &pos) != 0) {
+        waitedMs = pos == blockedPos ? waitedMs + 1 : 0;
+        blockedPos = pos;
+        if (waitedMs > SHM_RING_COMMIT_TIMEOUT_MS) {
+            return 1;
+        }
+
+        usleep(1000);
+    }
+
+    return 0;
+}
+
+ShmSink_s* shmSinkOpen(const char* name, unsigned int capacity, CJSON_LOGGER_TIME_FORMAT_E timeFormat)
+{
+    if (name == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return NULL;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd == -1) {
+        return NULL;
+    }
+
+    size_t size = shmRingSize(capacity);
+
+    // Attach to the ring left by a previous run when it matches, so a running collector keeps reading it. A ring blocked
+    // by a slot its producer never committed (e.g. it died while writing) is initialized again.
+    struct stat st;
+    int reuse = 0;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size == size) {
+        ShmRingHeader_s* header = (ShmRingHeader_s*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (header != MAP_FAILED) {
+            reuse = shmRingIsValid(header, size) && header->capacity == capacity && shmSinkRingBlocked(header) == 0;
+            munmap(header, size);
+        }
+    }
+
+    if (reuse == 0 && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    ShmRingHeader_s* header = (ShmRingHeader_s*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        return NULL;
+    }
+
+    if (reuse == 0) {
+        shmRingInit(header, capacity);
+    }
+
+    // A reused ring takes the format of this run too.
+    atomic_store_explicit(&header->timeFormat, (int32_t)timeFormat, memory_order_relaxed);
+
+    ShmSink_s* sink = (ShmSink_s*)malloc(sizeof(ShmSink_s));
+    CJSON_LOGGER_ASSERT_NEQ(sink, NULL);
+    if (sink == NULL) {
+        munmap(header, size);
+        return NULL;
+    }
+
+    sink->header = header;
+    sink->size = size;
+
+    return sink;
+}
+
+void shmSinkClose(ShmSink_s* sink)
+{
+    if (sink == NULL) {
+        return;
+    }
+
+    munmap(sink->header, sink->size);
+    free(sink);
+}
+
+int shmSinkWrite(ShmSink_s* sink, const CJSONLoggerRecord_s* record)
+{
+    return shmRingWrite(sink->header, record->jsonPath, record->jsonPathDepth, record->timeStamp, (int32_t)record->logLevel, record->fileName,
+        record->funcName, (int32_t)record->fileLine, record->logMsg, record->sequence, record->threadId);
+}
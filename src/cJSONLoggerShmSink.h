@@ -0,0 +1,54 @@
+/**
+ * @file cJSONLoggerShmSink.h
+ *
+ * @brief This file contains the interface of the sink writing the log records to a shared memory ring.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_SHM_SINK_H
+#define CJSON_LOGGER_SHM_SINK_H
+
+#include "cJSONLogger.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Opaque shared memory sink.
+ */
+typedef struct ShmSink ShmSink_s;
+
+/**
+ * @brief Open a shared memory sink, the ring is created if it does not exist or does not match the requested layout.
+ *
+ * @param name The POSIX shared memory object name (e.g. "/cjsonlogger").
+ * @param capacity The number of slots of the ring, a power of two.
+ * @param timeFormat The time format published in the ring header for the collector.
+ *
+ * @return ShmSink_s* ptr of the new sink, NULL in case of failure.
+ */
+ShmSink_s* shmSinkOpen(const char* name, unsigned int capacity, CJSON_LOGGER_TIME_FORMAT_E timeFormat);
+
+/**
+ * @brief Close a shared memory sink, the shared memory object is kept for the collector.
+ *
+ * @param sink The sink to close.
+ */
+void shmSinkClose(ShmSink_s* sink);
+
+/**
+ * @brief Write a log record to the ring of a shared memory sink.
+ *
+ * @note The write never blocks, the record is dropped (and counted) when the ring is full.
+ *
+ * @param sink The sink to write to.
+ * @param record The record to write.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int shmSinkWrite(ShmSink_s* sink, const CJSONLoggerRecord_s* record);
+
+#endif // CJSON_LOGGER_SHM_SINK_H
@@ -0,0 +1,334 @@
+/**
+ * @file cJSONLoggerSink.c
+ *
+ * @brief This file contains the implementation of the sinks the records of the cJSON logger library are fanned out to.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerSink.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerShmRing.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @def SINK_MAX_BATCH_RECORDS
+ *
+ * @brief Max number of records handed to a single writeBatch operation.
+ */
+#define SINK_MAX_BATCH_RECORDS 256
+
+/**
+ * @def SINK_MAX_BATCH_NAMES
+ *
+ * @brief Max number of node names of the records handed to a single writeBatch operation, a record never exceeds it.
+ */
+#define SINK_MAX_BATCH_NAMES SHM_RING_SLOT_DATA_LEN
+
+/**
+ * @def SINK_CLOSE_TIMEOUT_MS
+ *
+ * @brief Time a destroyed sink waits for a busy destination to accept the queued records.
+ */
+#define SINK_CLOSE_TIMEOUT_MS 1000
+
+/**
+ * @def SINK_RETRY_INTERVAL_MS
+ *
+ * @brief Time a failed drain waits before the writes schedule it again, e.g. while the destination is unreachable.
+ */
+#define SINK_RETRY_INTERVAL_MS 100
+
+/**
+ * @struct Sink
+ *
+ * @brief A sink the records are fanned out to.
+ *
+ * @var ops The operations of the sink.
+ * @var ctx The context passed to the operations.
+ * @var logLevel The log level severity threshold, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @var mostSevereLogLevel The most severe log level accepted, __CJSON_LOG_LEVEL_START accepts every severity.
+ * @var queue Bounded lock free queue of the records waiting to be written, same layout as the shared memory ring, NULL if not fed records.
+ * @var batchSize The number of queued records that triggers a drain.
+ * @var drainPending Set while a drain is scheduled or running, and after a failed drain until it is retried.
+ * @var retryAt Time (CLOCK_MONOTONIC milliseconds) from which the writes retry the last failed drain, 0 if no drain failed.
+ * @var mutex Mutex serializing the operations of the sink.
+ */
+struct Sink {
+    const SinkOps_s* ops;
+    void* ctx;
+    CJSON_LOG_LEVEL_E logLevel;
+    CJSON_LOG_LEVEL_E mostSevereLogLevel;
+    ShmRingHeader_s* queue;
+    unsigned int batchSize;
+    atomic_int drainPending;
+    _Atomic int64_t retryAt;
+    pthread_mutex_t mutex;
+};
+
+/**
+ * @brief Get the current CLOCK_MONOTONIC time in milliseconds.
+ *
+ * @return int64_t, the time in milliseconds.
+ */
+static int64_t sinkNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Claim the next drain of a sink.
+ *
+ * @note A failed drain stays pending, only the first write after its retry time schedules it again, so an unreachable
+ * destination is not retried for every record.
+ *
+ * @param sink The sink.
+ *
+ * @return int, 1 if the caller must schedule sinkDrain(), 0 otherwise.
+ */
+static int sinkClaimDrain(Sink_s* sink)
+{
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&sink->drainPending, &expected, 1)) {
+        return 1;
+    }
+
+    int64_t retryAt = atomic_load_explicit(&sink->retryAt, memory_order_relaxed);
+    return retryAt != 0 && sinkNow() >= retryAt && atomic_compare_exchange_strong(&sink->retryAt, &retryAt, 0) ? 1 : 0;
+}
+
+/**
+ * @brief Update the drain state of a sink once its queue was drained.
+ *
+ * @param sink The sink.
+ * @param res The result of sinkDrainLocked().
+ *
+ * @return int, 1 if the records queued while draining need another drain, claimed by the caller, 0 otherwise.
+ */
+static int sinkDrainDone(Sink_s* sink, int res)
+{
+    if (res != 0) {
+        atomic_store(&sink->retryAt, sinkNow() + SINK_RETRY_INTERVAL_MS);
+        atomic_store(&sink->drainPending, 1);
+        return 0;
+    }
+
+    atomic_store(&sink->retryAt, 0);
+    atomic_store(&sink->drainPending, 0);
+
+    // The records queued while draining did not schedule a drain.
+    uint64_t queued = atomic_load_explicit(&sink->queue->enqueuePos, memory_order_relaxed) - atomic_load_explicit(&sink->queue->dequeuePos, memory_order_relaxed);
+    int expected = 0;
+    return queued >= sink->batchSize && atomic_compare_exchange_strong(&sink->drainPending, &expected, 1) ? 1 : 0;
+}
+
+/**
+ * @brief Write the queued records of a sink in batches.
+ *
+ * @note Must be called with the mutex of the sink held.
+ *
+ * @param sink The sink to drain.
+ *
+ * @return int, 0 if the queue was emptied, negative value if the destination is busy.
+ */
+static int sinkDrainLocked(Sink_s* sink)
+{
+    if (sink->queue == NULL) {
+        return 0;
+    }
+
+    LogRecord_s records[SINK_MAX_BATCH_RECORDS];
+    const char* names[SINK_MAX_BATCH_NAMES];
+
+    for (;;) {
+        size_t count = 0;
+        size_t nameCount = 0;
+
+        ShmRingSlot_s* slot = NULL;
+        while (count < SINK_MAX_BATCH_RECORDS && (slot = shmRingPeek(sink->queue, count)) != NULL && nameCount + slot->pathDepth <= SINK_MAX_BATCH_NAMES) {
+            const char* nodeName = slot->data;
+            for (uint16_t i = 0; i < slot->pathDepth; i++) {
+                names[nameCount + i] = nodeName;
+                nodeName += strlen(nodeName) + 1;
+            }
+
+            records[count].jsonPath = &names[nameCount];
+            records[count].jsonPathDepth = slot->pathDepth;
+            records[count].timeStamp = slot->timeStamp;
+            records[count].logLevel = (CJSON_LOG_LEVEL_E)slot->logLevel;
+            records[count].fileName = shmRingSlotFileName(slot);
+            records[count].funcName = shmRingSlotFuncName(slot);
+            records[count].fileLine = slot->fileLine;
+            records[count].logMsg = shmRingSlotLogMsg(slot);
+            records[count].sequence = slot->recordSequence;
+            records[count].threadId = slot->threadId;
+
+            nameCount += slot->pathDepth;
+            count++;
+        }
+
+        if (count == 0) {
+            return 0;
+        }
+
+        size_t written = sink->ops->writeBatch != NULL ? sink->ops->writeBatch(sink->ctx, records, count) : count;
+        shmRingConsume(sink->queue, written);
+
+        if (written < count) {
+            return -1;
+        }
+    }
+}
+
+Sink_s* sinkCreate(const SinkOps_s* ops, void* ctx, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize)
+{
+    if (ops == NULL || (queueCapacity & (queueCapacity - 1)) != 0 || (queueCapacity != 0 && batchSize == 0)) {
+        return NULL;
+    }
+
+    Sink_s* sink = (Sink_s*)calloc(1, sizeof(Sink_s));
+    CJSON_LOGGER_ASSERT_NEQ(sink, NULL);
+    if (sink == NULL) {
+        return NULL;
+    }
+
+    if (queueCapacity != 0) {
+        sink->queue = (ShmRingHeader_s*)aligned_alloc(_Alignof(ShmRingHeader_s), shmRingSize(queueCapacity));
+        CJSON_LOGGER_ASSERT_NEQ(sink->queue, NULL);
+        if (sink->queue == NULL) {
+            free(sink);
+            return NULL;
+        }
+
+        shmRingInit(sink->queue, queueCapacity);
+    }
+
+    sink->ops = ops;
+    sink->ctx = ctx;
+    sink->logLevel = logLevel;
+    sink->batchSize = batchSize;
+    pthread_mutex_init(&sink->mutex, NULL);
+
+    return sink;
+}
+
+void sinkDestroy(Sink_s* sink)
+{
+    if (sink == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&sink->mutex);
+    for (int waitedMs = 0; sinkDrainLocked(sink) != 0 && waitedMs < SINK_CLOSE_TIMEOUT_MS; waitedMs++) {
+        usleep(1000);
+    }
+
+    if (sink->ops->close != NULL) {
+        sink->ops->close(sink->ctx);
+    }
+    pthread_mutex_unlock(&sink->mutex);
+
+    pthread_mutex_destroy(&sink->mutex);
+    free(sink->queue);
+    free(sink);
+}
+
+CJSON_LOG_LEVEL_E sinkLogLevel(const Sink_s* sink)
+{
+    return sink->logLevel;
+}
+
+void sinkSetMostSevereLogLevel(Sink_s* sink, CJSON_LOG_LEVEL_E mostSevereLogLevel)
+{
+    sink->mostSevereLogLevel = mostSevereLogLevel;
+}
+
+int sinkWrite(Sink_s* sink, const LogRecord_s* record, CJSON_LOG_LEVEL_E loggerLogLevel)
+{
+    CJSON_LOG_LEVEL_E threshold = sink->logLevel != __CJSON_LOG_LEVEL_START ? sink->logLevel : loggerLogLevel;
+    if (sink->queue == NULL || logLevelEnabled(record->logLevel, threshold) == 0) {
+        return 0;
+    }
+
+    if (sink->mostSevereLogLevel != __CJSON_LOG_LEVEL_START && record->logLevel > __CJSON_LOG_LEVEL_START && record->logLevel < sink->mostSevereLogLevel) {
+        return 0;
+    }
+
+    // A full queue drops the record and asks for a drain, the queue only empties through one.
+    if (shmRingWrite(sink->queue, record->jsonPath, record->jsonPathDepth, record->timeStamp, (int32_t)record->logLevel,
+            record->fileName, record->funcName, (int32_t)record->fileLine, record->logMsg, record->sequence, record->threadId)
+        != 0) {
+        return sinkClaimDrain(sink);
+    }
+
+    uint64_t queued = atomic_load_explicit(&sink->queue->enqueuePos, memory_order_relaxed) - atomic_load_explicit(&sink->queue->dequeuePos, memory_order_relaxed);
+    if (queued < sink->batchSize) {
+        return 0;
+    }
+
+    return sinkClaimDrain(sink);
+}
+
+void sinkDrain(Sink_s* sink)
+{
+    int res = 0;
+    do {
+        pthread_mutex_lock(&sink->mutex);
+        res = sinkDrainLocked(sink);
+        pthread_mutex_unlock(&sink->mutex);
+    } while (sink->queue != NULL && sinkDrainDone(sink, res) != 0);
+}
+
+void sinkFlush(Sink_s* sink)
+{
+    pthread_mutex_lock(&sink->mutex);
+    int res = sinkDrainLocked(sink);
+    if (sink->ops->flush != NULL) {
+        sink->ops->flush(sink->ctx);
+    }
+    pthread_mutex_unlock(&sink->mutex);
+
+    // The flush also retries a failed drain, the records left queued are drained right away.
+    if (sink->queue != NULL && sinkDrainDone(sink, res) != 0) {
+        sinkDrain(sink);
+    }
+}
+
+void sinkRotate(Sink_s* sink)
+{
+    pthread_mutex_lock(&sink->mutex);
+    sinkDrainLocked(sink);
+    if (sink->ops->rotate != NULL) {
+        sink->ops->rotate(sink->ctx);
+    }
+    pthread_mutex_unlock(&sink->mutex);
+}
+
+uint64_t sinkDropped(Sink_s* sink)
+{
+    return sink->queue != NULL ? atomic_load_explicit(&sink->queue->dropped, memory_order_relaxed) : 0;
+}
+
+void sinkAtForkChild(Sink_s* sink, int fresh)
+{
+    pthread_mutex_init(&sink->mutex, NULL);
+    atomic_store(&sink->drainPending, 0);
+    atomic_store(&sink->retryAt, 0);
+
+    if (sink->queue != NULL) {
+        shmRingInit(sink->queue, sink->queue->capacity);
+    }
+
+    if (fresh != 0 && sink->ops->forkFresh != NULL) {
+        sink->ops->forkFresh(sink->ctx);
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file cJSONLoggerSink.h
+ *
+ * @brief This file contains the interface of the sinks the records of the cJSON logger library are fanned out to.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_SINK_H
+#define CJSON_LOGGER_SINK_H
+
+#include "cJSONLogger.h"
+
+#include <stdint.h>
+
+/**
+ * @brief A log record handed to the sinks, same layout as the records of the callback sinks.
+ */
+typedef CJSONLoggerRecord_s LogRecord_s;
+
+/**
+ * @struct SinkOps
+ *
+ * @brief Operations implemented by a sink, every operation is optional and called with the sink serialized.
+ *
+ * @var writeBatch Write a batch of records, returns the number of records written. Fewer records are written when the
+ * destination is busy, the rest stay queued for the next drain.
+ * @var flush Make the written records durable (e.g. print the in memory JSON tree), called by cJSONLoggerDump().
+ * @var rotate Rotate the destination, called by cJSONLoggerRotate().
+ * @var forkFresh Give a forked child started fresh (CJSON_LOGGER_FORK_FRESH) a destination of its own, e.g. a file under the
+ * path of the child, called in the child after the fork.
+ * @var close Release the context of the sink.
+ */
+typedef struct SinkOps {
+    size_t (*writeBatch)(void* ctx, const LogRecord_s* records, size_t count);
+    void (*flush)(void* ctx);
+    void (*rotate)(void* ctx);
+    void (*forkFresh)(void* ctx);
+    void (*close)(void* ctx);
+} SinkOps_s;
+
+/**
+ * @brief Opaque sink.
+ */
+typedef struct Sink Sink_s;
+
+/**
+ * @brief Check whether a log level passes a log level severity threshold.
+ *
+ * @note Out of range log levels always pass, same as the logger.
+ *
+ * @param logLevel The log level to check.
+ * @param threshold The log level severity threshold.
+ *
+ * @return int, 1 if the log level passes, 0 otherwise.
+ */
+static inline int logLevelEnabled(CJSON_LOG_LEVEL_E logLevel, CJSON_LOG_LEVEL_E threshold)
+{
+    return logLevel <= __CJSON_LOG_LEVEL_START || logLevel <= threshold || logLevel >= __CJSON_LOG_LEVEL_END;
+}
+
+/**
+ * @brief Create a sink.
+ *
+ * @note The records written to a sink are copied into a bounded lock free queue, the sink operations only run when the queue
+ * is drained, normally on a worker thread. A full queue drops (and counts) the new records.
+ *
+ * @param ops The operations of the sink, must outlive the sink.
+ * @param ctx The context passed to the operations, released by the close operation.
+ * @param logLevel The log level severity threshold of the sink, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @param queueCapacity The number of records the queue can hold, a power of two, 0 for a sink that is not fed records.
+ * @param batchSize The number of queued records that triggers a drain.
+ *
+ * @return Sink_s* ptr of the new sink, NULL in case of failure.
+ */
+Sink_s* sinkCreate(const SinkOps_s* ops, void* ctx, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize);
+
+/**
+ * @brief Destroy a sink, the queued records are written first (waiting a bounded time for a busy destination).
+ *
+ * @param sink The sink to destroy.
+ */
+void sinkDestroy(Sink_s* sink);
+
+/**
+ * @brief Get the log level severity threshold of a sink.
+ *
+ * @param sink The sink.
+ *
+ * @return CJSON_LOG_LEVEL_E, the threshold, __CJSON_LOG_LEVEL_START if the sink follows the level of the logger.
+ */
+CJSON_LOG_LEVEL_E sinkLogLevel(const Sink_s* sink);
+
+/**
+ * @brief Bound the severity of the records accepted by a sink, together with its threshold it accepts a range of log levels.
+ *
+ * @warning Must be called before the sink is written to.
+ *
+ * @param sink The sink.
+ * @param mostSevereLogLevel The most severe log level accepted, __CJSON_LOG_LEVEL_START accepts every severity.
+ */
+void sinkSetMostSevereLogLevel(Sink_s* sink, CJSON_LOG_LEVEL_E mostSevereLogLevel);
+
+/**
+ * @brief Queue a record on a sink.
+ *
+ * @note The write never blocks.
+ *
+ * @param sink The sink to write to.
+ * @param record The record to queue.
+ * @param loggerLogLevel The log level of the logger, used by the sinks following it.
+ *
+ * @return int, 1 if a batch is ready or the queue is full and the caller must schedule sinkDrain(), 0 otherwise.
+ */
+int sinkWrite(Sink_s* sink, const LogRecord_s* record, CJSON_LOG_LEVEL_E loggerLogLevel);
+
+/**
+ * @brief Write the queued records of a sink.
+ *
+ * @note When the destination does not take every record the drain stays pending, the writes schedule it again after
+ * a short backoff and sinkFlush() retries it right away.
+ *
+ * @param sink The sink to drain.
+ */
+void sinkDrain(Sink_s* sink);
+
+/**
+ * @brief Write the queued records of a sink and flush it.
+ *
+ * @param sink The sink to flush.
+ */
+void sinkFlush(Sink_s* sink);
+
+/**
+ * @brief Write the queued records of a sink and rotate it.
+ *
+ * @param sink The sink to rotate.
+ */
+void sinkRotate(Sink_s* sink);
+
+/**
+ * @brief Get the number of records a sink dropped because its queue was full.
+ *
+ * @param sink The sink.
+ *
+ * @return uint64_t, the number of dropped records.
+ */
+uint64_t sinkDropped(Sink_s* sink);
+
+/**
+ * @brief Reset a sink in a forked child, the records queued by the parent are dropped.
+ *
+ * @warning The sink must not be in use at the time of the fork.
+ *
+ * @param sink The sink to reset.
+ * @param fresh Whether the child is started fresh (CJSON_LOGGER_FORK_FRESH) and the sink moves to a destination of its own.
+ */
+void sinkAtForkChild(Sink_s* sink, int fresh);
+
+#endif // CJSON_LOGGER_SINK_H
@@ -0,0 +1,184 @@
+/**
+ * @file cJSONLoggerSocketSink.c
+ *
+ * @brief This file contains the implementation of the sink shipping batches of log records over a Unix domain socket.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerSocketSink.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerFormat.h"
+#include "cJSONLoggerShmRing.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @def SOCKET_SINK_MAX_RECORD_LEN
+ *
+ * @brief Max length of the NDJSON line of a record, every queued character escapes to at most six.
+ */
+#define SOCKET_SINK_MAX_RECORD_LEN (8 * SHM_RING_SLOT_DATA_LEN)
+
+/**
+ * @struct SocketSink
+ *
+ * @brief Context of a socket sink.
+ *
+ * @var socketPath The path of the Unix domain socket of the receiver.
+ * @var fd The connected socket, -1 while not connected.
+ * @var packet The buffer the packets are printed into.
+ */
+typedef struct SocketSink {
+    char* socketPath;
+    int fd;
+    PrintBuffer_s packet;
+} SocketSink_s;
+
+/**
+ * @brief Connect a socket sink to its receiver.
+ *
+ * @param socketSink The sink to connect.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int socketSinkConnect(SocketSink_s* socketSink)
+{
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return -1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketSink->socketPath, sizeof(addr.sun_path) - 1);
+
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    socketSink->fd = fd;
+
+    return 0;
+}
+
+/**
+ * @brief Send a batch of records to the receiver of a socket sink, as many packets as needed.
+ *
+ * @param ctx The socket sink.
+ * @param records The records to send.
+ * @param count The number of records.
+ *
+ * @return size_t, the number of records sent, the rest are sent by the next drain.
+ */
+static size_t socketSinkWriteBatch(void* ctx, const LogRecord_s* records, size_t count)
+{
+    SocketSink_s* socketSink = (SocketSink_s*)ctx;
+    if (socketSink->fd == -1 && socketSinkConnect(socketSink) != 0) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    while (sent < count) {
+        size_t packetCount = 0;
+        printBufferReset(&socketSink->packet);
+        while (sent + packetCount < count && socketSink->packet.length <= SOCKET_SINK_MAX_PACKET_LEN - SOCKET_SINK_MAX_RECORD_LEN) {
+            printBufferRecordLine(&socketSink->packet, &records[sent + packetCount]);
+            packetCount++;
+        }
+
+        // An incomplete packet is not sent, its records are sent by the next drain.
+        if (socketSink->packet.failed != 0) {
+            break;
+        }
+
+        ssize_t res = send(socketSink->fd, socketSink->packet.buffer, socketSink->packet.length, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (res >= 0) {
+            sent += packetCount;
+            continue;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        // The receiver went away, the records are sent again over the next connection.
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            close(socketSink->fd);
+            socketSink->fd = -1;
+        }
+
+        break;
+    }
+
+    return sent;
+}
+
+/**
+ * @brief Close a socket sink.
+ *
+ * @param ctx The socket sink.
+ */
+static void socketSinkClose(void* ctx)
+{
+    SocketSink_s* socketSink = (SocketSink_s*)ctx;
+
+    if (socketSink->fd != -1) {
+        close(socketSink->fd);
+    }
+
+    free(socketSink->packet.buffer);
+    free(socketSink->socketPath);
+    free(socketSink);
+}
+
+/**
+ * @brief Operations of the socket sinks.
+ */
+static const SinkOps_s s_g_socketSinkOps = {
+    .writeBatch = socketSinkWriteBatch,
+    .flush = NULL,
+    .rotate = NULL,
+    .forkFresh = NULL,
+    .close = socketSinkClose,
+};
+
+Sink_s* socketSinkCreate(const char* socketPath, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize)
+{
+    if (socketPath == NULL || strlen(socketPath) > SOCKET_SINK_MAX_PATH_LEN || queueCapacity == 0) {
+        return NULL;
+    }
+
+    SocketSink_s* socketSink = (SocketSink_s*)calloc(1, sizeof(SocketSink_s));
+    CJSON_LOGGER_ASSERT_NEQ(socketSink, NULL);
+    if (socketSink == NULL) {
+        return NULL;
+    }
+
+    socketSink->fd = -1;
+    socketSink->socketPath = strdup(socketPath);
+    CJSON_LOGGER_ASSERT_NEQ(socketSink->socketPath, NULL);
+    if (socketSink->socketPath == NULL) {
+        socketSinkClose(socketSink);
+        return NULL;
+    }
+
+    // The receiver may not be up yet, the connection is retried by the drains.
+    socketSinkConnect(socketSink);
+
+    Sink_s* sink = sinkCreate(&s_g_socketSinkOps, socketSink, logLevel, queueCapacity, batchSize);
+    if (sink == NULL) {
+        socketSinkClose(socketSink);
+    }
+
+    return sink;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file cJSONLoggerSocketSink.h
+ *
+ * @brief This file contains the interface of the sink shipping batches of log records over a Unix domain socket.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_SOCKET_SINK_H
+#define CJSON_LOGGER_SOCKET_SINK_H
+
+#include "cJSONLoggerSink.h"
+
+#include <sys/un.h>
+
+/**
+ * @def SOCKET_SINK_MAX_PACKET_LEN
+ *
+ * @brief Max length of a packet sent by the socket sink.
+ */
+#define SOCKET_SINK_MAX_PACKET_LEN 65536
+
+/**
+ * @def SOCKET_SINK_MAX_PATH_LEN
+ *
+ * @brief Max length of the path of the Unix domain socket, NUL excluded.
+ */
+#define SOCKET_SINK_MAX_PATH_LEN (sizeof(((struct sockaddr_un*)0)->sun_path) - 1)
+
+/**
+ * @brief Create a sink sending the log records to a Unix domain socket.
+ *
+ * @note The records are sent as packets of NDJSON lines over a SOCK_SEQPACKET socket, a packet never splits a record.
+ * The sends never block, records the receiver can not take yet (busy or not started) stay queued for the next drain
+ * and the connection is (re)established on demand.
+ *
+ * @param socketPath The path of the Unix domain socket of the receiver.
+ * @param logLevel The log level severity threshold of the sink, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @param queueCapacity The number of records the queue of the sink can hold, a power of two.
+ * @param batchSize The number of queued records that triggers a send.
+ *
+ * @return Sink_s* ptr of the new sink, NULL in case of failure.
+ */
+Sink_s* socketSinkCreate(const char* socketPath, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize);
+
+#endif // CJSON_LOGGER_SOCKET_SINK_H
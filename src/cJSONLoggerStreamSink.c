@@ -0,0 +1,320 @@
+/**
+ * @file cJSONLoggerStreamSink.c
+ *
+ * @brief This file contains the implementation of the sink appending the log records as NDJSON to a file or the standard error.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerStreamSink.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerFormat.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @struct StreamSink
+ *
+ * @brief Context of a stream sink.
+ *
+ * @var filePath The path of the file, NULL for the standard error.
+ * @var fd The file descriptor the records are appended to.
+ * @var printBuffer The buffer the records are printed into.
+ * @var rotation The rotation policy of the file.
+ * @var fileRecords Number of records written to the file since it was opened.
+ * @var fileOpenTime Time (CLOCK_MONOTONIC seconds) the file was opened.
+ * @var rotatedFiles Ring of the paths of the kept rotated files, rotation.maxFiles long, NULL if every rotated file is kept.
+ * @var rotatedHead Position of the oldest kept rotated file.
+ * @var rotatedCount Number of kept rotated files.
+ */
+typedef struct StreamSink {
+    char* filePath;
+    int fd;
+    PrintBuffer_s printBuffer;
+    StreamSinkRotation_s rotation;
+    unsigned int fileRecords;
+    time_t fileOpenTime;
+    char** rotatedFiles;
+    unsigned int rotatedHead;
+    unsigned int rotatedCount;
+} StreamSink_s;
+
+/**
+ * @brief Open the file of a stream sink for appending.
+ *
+ * @param filePath The path of the file.
+ *
+ * @return int, the file descriptor, -1 in case of failure.
+ */
+static int streamSinkOpenFile(const char* filePath)
+{
+    return open(filePath, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+}
+
+/**
+ * @brief Get the current CLOCK_MONOTONIC time in seconds.
+ *
+ * @return time_t, the time in seconds.
+ */
+static time_t streamSinkNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec;
+}
+
+static void streamSinkRotate(void* ctx);
+
+/**
+ * @brief Check whether the rotation policy of a stream sink requires its file to rotate.
+ *
+ * @param streamSink The stream sink.
+ *
+ * @return int, 1 if the file must rotate, 0 otherwise.
+ */
+static int streamSinkRotationDue(const StreamSink_s* streamSink)
+{
+    if (streamSink->filePath == NULL || streamSink->fileRecords == 0) {
+        return 0;
+    }
+
+    return (streamSink->rotation.maxRecords != 0 && streamSink->fileRecords >= streamSink->rotation.maxRecords)
+        || (streamSink->rotation.maxSeconds != 0 && streamSinkNow() - streamSink->fileOpenTime >= (time_t)streamSink->rotation.maxSeconds);
+}
+
+/**
+ * @brief Write a batch of records to the file of a stream sink.
+ *
+ * @param streamSink The stream sink.
+ * @param records The records to write.
+ * @param count The number of records.
+ */
+static void streamSinkWriteRecords(StreamSink_s* streamSink, const LogRecord_s* records, size_t count)
+{
+    printBufferReset(&streamSink->printBuffer);
+    for (size_t i = 0; i < count; i++) {
+        printBufferRecordLine(&streamSink->printBuffer, &records[i]);
+    }
+
+    // An incomplete batch is dropped like a failed write, a cut line would break the NDJSON file.
+    size_t offset = 0;
+    while (streamSink->fd != -1 && streamSink->printBuffer.failed == 0 && offset < streamSink->printBuffer.length) {
+        ssize_t written = write(streamSink->fd, streamSink->printBuffer.buffer + offset, streamSink->printBuffer.length - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            break;
+        }
+
+        offset += (size_t)written;
+    }
+
+    streamSink->fileRecords += (unsigned int)count;
+}
+
+/**
+ * @brief Write a batch of records to a stream sink.
+ *
+ * @note Records that can not be written are dropped, a broken file must not stall the queue.
+ *
+ * @param ctx The stream sink.
+ * @param records The records to write.
+ * @param count The number of records.
+ *
+ * @return size_t, the number of records written.
+ */
+static size_t streamSinkWriteBatch(void* ctx, const LogRecord_s* records, size_t count)
+{
+    StreamSink_s* streamSink = (StreamSink_s*)ctx;
+
+    // The batch is split where the rotation policy rotates the file.
+    size_t written = 0;
+    while (written < count) {
+        if (streamSinkRotationDue(streamSink) != 0) {
+            streamSinkRotate(streamSink);
+        }
+
+        size_t chunk = count - written;
+        if (streamSink->filePath != NULL && streamSink->rotation.maxRecords != 0 && chunk > streamSink->rotation.maxRecords - streamSink->fileRecords) {
+            chunk = streamSink->rotation.maxRecords - streamSink->fileRecords;
+        }
+
+        streamSinkWriteRecords(streamSink, records + written, chunk);
+        written += chunk;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Rotate the file of a stream sink.
+ *
+ * @param ctx The stream sink.
+ */
+static void streamSinkRotate(void* ctx)
+{
+    StreamSink_s* streamSink = (StreamSink_s*)ctx;
+    if (streamSink->filePath == NULL) {
+        return;
+    }
+
+    char timeStr[MAX_TIME_STR_LEN] = { 0 };
+    formatRotationTime(timeStr, sizeof(timeStr));
+
+    size_t rotatedFileLen = strlen(streamSink->filePath) + strnlen(timeStr, MAX_TIME_STR_LEN) + 2;
+    char* rotatedFilePath = (char*)malloc(rotatedFileLen);
+    CJSON_LOGGER_ASSERT_NEQ(rotatedFilePath, NULL);
+    if (rotatedFilePath == NULL) {
+        return;
+    }
+
+    snprintf(rotatedFilePath, rotatedFileLen, "%s_%s", timeStr, streamSink->filePath);
+    rename(streamSink->filePath, rotatedFilePath);
+
+    // Keep the newest rotated files only, the ring holds the paths of the kept ones.
+    if (streamSink->rotatedFiles != NULL) {
+        if (streamSink->rotatedCount == streamSink->rotation.maxFiles) {
+            remove(streamSink->rotatedFiles[streamSink->rotatedHead]);
+            free(streamSink->rotatedFiles[streamSink->rotatedHead]);
+            streamSink->rotatedHead = (streamSink->rotatedHead + 1) % streamSink->rotation.maxFiles;
+            streamSink->rotatedCount--;
+        }
+
+        streamSink->rotatedFiles[(streamSink->rotatedHead + streamSink->rotatedCount) % streamSink->rotation.maxFiles] = rotatedFilePath;
+        streamSink->rotatedCount++;
+        rotatedFilePath = NULL;
+    }
+
+    free(rotatedFilePath);
+
+    if (streamSink->fd != -1) {
+        close(streamSink->fd);
+    }
+
+    streamSink->fd = streamSinkOpenFile(streamSink->filePath);
+    CJSON_LOGGER_ASSERT_NEQ(streamSink->fd, -1);
+    streamSink->fileRecords = 0;
+    streamSink->fileOpenTime = streamSinkNow();
+}
+
+/**
+ * @brief Move the file of a stream sink to the path of a forked child, the parent keeps writing, rotating and removing its own files.
+ *
+ * @param ctx The stream sink.
+ */
+static void streamSinkForkFresh(void* ctx)
+{
+    StreamSink_s* streamSink = (StreamSink_s*)ctx;
+    if (streamSink->filePath == NULL) {
+        return;
+    }
+
+    char* filePath = formatForkFilePath(streamSink->filePath, getpid());
+    if (filePath == NULL) {
+        return;
+    }
+
+    free(streamSink->filePath);
+    streamSink->filePath = filePath;
+
+    // The rotated files of the parent are forgotten, not removed.
+    for (unsigned int i = 0; i < streamSink->rotatedCount; i++) {
+        free(streamSink->rotatedFiles[(streamSink->rotatedHead + i) % streamSink->rotation.maxFiles]);
+    }
+    streamSink->rotatedHead = 0;
+    streamSink->rotatedCount = 0;
+
+    if (streamSink->fd != -1) {
+        close(streamSink->fd);
+    }
+
+    streamSink->fd = streamSinkOpenFile(streamSink->filePath);
+    CJSON_LOGGER_ASSERT_NEQ(streamSink->fd, -1);
+    streamSink->fileRecords = 0;
+    streamSink->fileOpenTime = streamSinkNow();
+}
+
+/**
+ * @brief Close a stream sink.
+ *
+ * @param ctx The stream sink.
+ */
+static void streamSinkClose(void* ctx)
+{
+    StreamSink_s* streamSink = (StreamSink_s*)ctx;
+
+    if (streamSink->filePath != NULL && streamSink->fd != -1) {
+        close(streamSink->fd);
+    }
+
+    for (unsigned int i = 0; i < streamSink->rotatedCount; i++) {
+        free(streamSink->rotatedFiles[(streamSink->rotatedHead + i) % streamSink->rotation.maxFiles]);
+    }
+
+    free(streamSink->rotatedFiles);
+    free(streamSink->printBuffer.buffer);
+    free(streamSink->filePath);
+    free(streamSink);
+}
+
+/**
+ * @brief Operations of the stream sinks.
+ */
+static const SinkOps_s s_g_streamSinkOps = {
+    .writeBatch = streamSinkWriteBatch,
+    .flush = NULL,
+    .rotate = streamSinkRotate,
+    .forkFresh = streamSinkForkFresh,
+    .close = streamSinkClose,
+};
+
+Sink_s* streamSinkCreate(const char* filePath, const StreamSinkRotation_s* rotation, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize)
+{
+    if (queueCapacity == 0) {
+        return NULL;
+    }
+
+    StreamSink_s* streamSink = (StreamSink_s*)calloc(1, sizeof(StreamSink_s));
+    CJSON_LOGGER_ASSERT_NEQ(streamSink, NULL);
+    if (streamSink == NULL) {
+        return NULL;
+    }
+
+    streamSink->fd = STDERR_FILENO;
+    streamSink->fileOpenTime = streamSinkNow();
+    if (rotation != NULL) {
+        streamSink->rotation = *rotation;
+    }
+
+    if (filePath != NULL) {
+        streamSink->filePath = strdup(filePath);
+        streamSink->fd = streamSinkOpenFile(filePath);
+        if (streamSink->rotation.maxFiles != 0) {
+            streamSink->rotatedFiles = (char**)calloc(streamSink->rotation.maxFiles, sizeof(char*));
+            CJSON_LOGGER_ASSERT_NEQ(streamSink->rotatedFiles, NULL);
+        }
+
+        if (streamSink->filePath == NULL || streamSink->fd == -1 || (streamSink->rotation.maxFiles != 0 && streamSink->rotatedFiles == NULL)) {
+            streamSinkClose(streamSink);
+            return NULL;
+        }
+    }
+
+    Sink_s* sink = sinkCreate(&s_g_streamSinkOps, streamSink, logLevel, queueCapacity, batchSize);
+    if (sink == NULL) {
+        streamSinkClose(streamSink);
+    }
+
+    return sink;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file cJSONLoggerStreamSink.h
+ *
+ * @brief This file contains the interface of the sink appending the log records as NDJSON to a file or the standard error.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_STREAM_SINK_H
+#define CJSON_LOGGER_STREAM_SINK_H
+
+#include "cJSONLoggerSink.h"
+
+/**
+ * @struct StreamSinkRotation
+ *
+ * @brief Rotation policy of the file of a stream sink, every field is optional (0).
+ *
+ * @var maxRecords Number of records after which the file rotates.
+ * @var maxSeconds Age in seconds after which the file rotates, checked when records are written.
+ * @var maxFiles Number of rotated files kept, the oldest one is removed once exceeded.
+ */
+typedef struct StreamSinkRotation {
+    unsigned int maxRecords;
+    unsigned int maxSeconds;
+    unsigned int maxFiles;
+} StreamSinkRotation_s;
+
+/**
+ * @brief Create a sink appending one JSON object per record (NDJSON) to a file or the standard error.
+ *
+ * @note A rotation renames the file with the same h_m_s_ns prefix as the rotated JSON tree files and starts a new one.
+ *
+ * @param filePath The path of the file, NULL for the standard error.
+ * @param rotation The rotation policy of the file, NULL to only rotate with cJSONLoggerRotate().
+ * @param logLevel The log level severity threshold of the sink, __CJSON_LOG_LEVEL_START follows the level of the logger.
+ * @param queueCapacity The number of records the queue of the sink can hold, a power of two.
+ * @param batchSize The number of queued records that triggers a write.
+ *
+ * @return Sink_s* ptr of the new sink, NULL in case of failure.
+ */
+Sink_s* streamSinkCreate(const char* filePath, const StreamSinkRotation_s* rotation, CJSON_LOG_LEVEL_E logLevel, unsigned int queueCapacity, unsigned int batchSize);
+
+#endif // CJSON_LOGGER_STREAM_SINK_H
@@ -0,0 +1,239 @@
+/**
+ * @file cJSONLoggerThread.c
+ *
+ * @brief This file contains the implementation used to create the threads owned by the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#define _GNU_SOURCE
+
+#include "cJSONLoggerThread.h"
+#include "cJSONLoggerAssert.h"
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/**
+ * @struct LoggerThreadStart
+ *
+ * @brief Start context of a logger thread.
+ *
+ * @var handler The thread handler.
+ * @var ctx The context passed to the thread handler.
+ * @var nice The nice value the thread applies to itself, CJSON_LOGGER_NICE_INHERIT keeps the inherited value.
+ */
+typedef struct LoggerThreadStart {
+    void* (*handler)(void*);
+    void* ctx;
+    int nice;
+} LoggerThreadStart_s;
+
+/**
+ * @brief The kernel thread id of the calling thread, 0 until loggerThreadId() is called.
+ */
+static _Thread_local uint32_t s_t_threadId = 0;
+
+/**
+ * @brief Parse a CPU list such as "0-3,8" into a CPU set.
+ *
+ * @param cpuList The CPU list to parse.
+ * @param cpuSet Where the CPU set will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int parseCpuList(const char* cpuList, cpu_set_t* cpuSet)
+{
+    CPU_ZERO(cpuSet);
+
+    const char* c = cpuList;
+    while (*c != '\0') {
+        char* end = NULL;
+        long first = strtol(c, &end, 10);
+        if (end == c || first < 0 || first >= CPU_SETSIZE) {
+            return -1;
+        }
+
+        long last = first;
+        c = end;
+        if (*c == '-') {
+            c++;
+            last = strtol(c, &end, 10);
+            if (end == c || last < first || last >= CPU_SETSIZE) {
+                return -1;
+            }
+            c = end;
+        }
+
+        for (long cpu = first; cpu <= last; cpu++) {
+            CPU_SET((size_t)cpu, cpuSet);
+        }
+
+        if (*c == ',') {
+            c++;
+        }
+
+        else if (*c != '\0') {
+            return -1;
+        }
+    }
+
+    return CPU_COUNT(cpuSet) > 0 ? 0 : -1;
+}
+
+/**
+ * @brief Convert a logger scheduling policy to its POSIX value.
+ *
+ * @param schedPolicy The logger scheduling policy.
+ *
+ * @return int, the POSIX scheduling policy, -1 when the policy is inherited or invalid.
+ */
+static int toPosixSchedPolicy(CJSON_LOGGER_SCHED_POLICY_E schedPolicy)
+{
+    switch (schedPolicy) {
+    case CJSON_LOGGER_SCHED_OTHER:
+        return SCHED_OTHER;
+    case CJSON_LOGGER_SCHED_BATCH:
+        return SCHED_BATCH;
+    case CJSON_LOGGER_SCHED_IDLE:
+        return SCHED_IDLE;
+    case CJSON_LOGGER_SCHED_FIFO:
+        return SCHED_FIFO;
+    case CJSON_LOGGER_SCHED_RR:
+        return SCHED_RR;
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Logger thread trampoline, applies the nice value before running the handler.
+ *
+ * @note A nice value the process is not allowed to apply (EPERM without CAP_SYS_NICE) is ignored, the thread keeps the inherited one.
+ *
+ * @param ctx The start context of the thread.
+ *
+ * @return The value returned by the thread handler.
+ */
+static void* loggerThreadHandler(void* ctx)
+{
+    LoggerThreadStart_s start = *(LoggerThreadStart_s*)ctx;
+    free(ctx);
+
+    if (start.nice != CJSON_LOGGER_NICE_INHERIT) {
+        // On Linux the nice value is a per thread attribute addressed by the thread id.
+        // Failing to lower it only costs priority, the thread must not take the process down.
+        (void)setpriority(PRIO_PROCESS, (id_t)gettid(), start.nice);
+    }
+
+    return start.handler(start.ctx);
+}
+
+int loggerThreadAttrValidate(const LoggerThreadAttr_s* attr)
+{
+    cpu_set_t cpuSet;
+    if (attr->cpuList != NULL && parseCpuList(attr->cpuList, &cpuSet) != 0) {
+        return -1;
+    }
+
+    if (attr->nice != CJSON_LOGGER_NICE_INHERIT && (attr->nice < -20 || attr->nice > 19)) {
+        return -1;
+    }
+
+    if (attr->schedPolicy < CJSON_LOGGER_SCHED_INHERIT || attr->schedPolicy > CJSON_LOGGER_SCHED_RR) {
+        return -1;
+    }
+
+    int policy = toPosixSchedPolicy(attr->schedPolicy);
+    if (policy != -1 && (attr->schedPriority < sched_get_priority_min(policy) || attr->schedPriority > sched_get_priority_max(policy))) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int loggerThreadCreate(pthread_t* thread, const LoggerThreadAttr_s* attr, void* (*handler)(void*), void* ctx)
+{
+    if (attr != NULL && loggerThreadAttrValidate(attr) != 0) {
+        return -1;
+    }
+
+    LoggerThreadStart_s* start = (LoggerThreadStart_s*)malloc(sizeof(LoggerThreadStart_s));
+    CJSON_LOGGER_ASSERT_NEQ(start, NULL);
+    if (start == NULL) {
+        return -1;
+    }
+
+    start->handler = handler;
+    start->ctx = ctx;
+    start->nice = attr != NULL ? attr->nice : CJSON_LOGGER_NICE_INHERIT;
+
+    pthread_attr_t pthreadAttr;
+    int res = pthread_attr_init(&pthreadAttr);
+    if (res != 0) {
+        free(start);
+        return -1;
+    }
+
+    if (attr != NULL && attr->cpuList != NULL) {
+        cpu_set_t cpuSet;
+        parseCpuList(attr->cpuList, &cpuSet);
+        res = pthread_attr_setaffinity_np(&pthreadAttr, sizeof(cpuSet), &cpuSet);
+        if (res != 0) {
+            CJSON_LOGGER_REPORT_ERROR("the CPU affinity of a logger thread could not be set");
+        }
+    }
+
+    // The thread attributes only take the POSIX policies, SCHED_BATCH and SCHED_IDLE are set once the thread exists.
+    int policy = attr != NULL ? toPosixSchedPolicy(attr->schedPolicy) : -1;
+    struct sched_param param = { 0 };
+    param.sched_priority = attr != NULL ? attr->schedPriority : 0;
+    if (res == 0 && (policy == SCHED_OTHER || policy == SCHED_FIFO || policy == SCHED_RR)) {
+        res = pthread_attr_setinheritsched(&pthreadAttr, PTHREAD_EXPLICIT_SCHED);
+        res = res == 0 ? pthread_attr_setschedpolicy(&pthreadAttr, policy) : res;
+        res = res == 0 ? pthread_attr_setschedparam(&pthreadAttr, &param) : res;
+        if (res != 0) {
+            CJSON_LOGGER_REPORT_ERROR("the scheduling policy of a logger thread could not be set");
+        }
+    }
+
+    // The CPU list may only name offline CPUs, or the policy may need privileges, only the creation tells.
+    if (res == 0) {
+        res = pthread_create(thread, &pthreadAttr, loggerThreadHandler, start);
+        if (res != 0) {
+            CJSON_LOGGER_REPORT_ERROR("a logger thread could not be created with its attributes");
+        }
+    }
+    pthread_attr_destroy(&pthreadAttr);
+
+    if (res != 0) {
+        free(start);
+        return -1;
+    }
+
+    // The thread already runs, it keeps the inherited policy when the new one can not be applied.
+    if ((policy == SCHED_BATCH || policy == SCHED_IDLE) && pthread_setschedparam(*thread, policy, &param) != 0) {
+        CJSON_LOGGER_REPORT_ERROR("the scheduling policy of a logger thread could not be set");
+    }
+
+    return 0;
+}
+
+uint32_t loggerThreadId(void)
+{
+    if (s_t_threadId == 0) {
+        s_t_threadId = (uint32_t)gettid();
+    }
+
+    return s_t_threadId;
+}
+
+void loggerThreadAtForkChild(void)
+{
+    s_t_threadId = 0;
+}
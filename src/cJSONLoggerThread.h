@@ -0,0 +1,73 @@
+/**
+ * @file cJSONLoggerThread.h
+ *
+ * @brief This file contains the interface used to create the threads owned by the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_THREAD_H
+#define CJSON_LOGGER_THREAD_H
+
+#include "cJSONLogger.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+/**
+ * @struct LoggerThreadAttr
+ *
+ * @brief Scheduling attributes applied to every thread owned by the logger.
+ *
+ * @var cpuList The CPU list (e.g. "0-3,8") the threads are pinned to, NULL to leave them unpinned.
+ * @var nice The nice value of the threads, CJSON_LOGGER_NICE_INHERIT keeps the inherited value.
+ * @var schedPolicy The scheduling policy of the threads.
+ * @var schedPriority The scheduling priority of the threads, only used by the real time policies.
+ */
+typedef struct LoggerThreadAttr {
+    const char* cpuList;
+    int nice;
+    CJSON_LOGGER_SCHED_POLICY_E schedPolicy;
+    int schedPriority;
+} LoggerThreadAttr_s;
+
+/**
+ * @brief Check that thread attributes are valid.
+ *
+ * @param attr The thread attributes to check.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int loggerThreadAttrValidate(const LoggerThreadAttr_s* attr);
+
+/**
+ * @brief Create a thread owned by the logger with the given attributes.
+ *
+ * @note The CPU affinity and scheduling policy are set before the thread starts, the nice value is set by the thread itself before it runs the handler.
+ *
+ * @param thread Where the thread id will be stored.
+ * @param attr The thread attributes, NULL for the defaults.
+ * @param handler The thread handler.
+ * @param ctx The context passed to the thread handler.
+ *
+ * @return int, 0 in case of success, negative value in case of failure (e.g. insufficient privileges for the scheduling policy).
+ */
+int loggerThreadCreate(pthread_t* thread, const LoggerThreadAttr_s* attr, void* (*handler)(void*), void* ctx);
+
+/**
+ * @brief Get the kernel thread id of the calling thread.
+ *
+ * @note The id is cached per thread after the first call, the later calls make no system call.
+ *
+ * @return uint32_t, the kernel thread id.
+ */
+uint32_t loggerThreadId(void);
+
+/**
+ * @brief Fork handler run in the child after the fork, drops the thread id cached by the forking thread.
+ */
+void loggerThreadAtForkChild(void);
+
+#endif // CJSON_LOGGER_THREAD_H
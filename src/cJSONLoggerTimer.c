@@ -0,0 +1,144 @@
+/**
+ * @file cJSONLoggerTimer.c
+ *
+ * @brief This file contains the implementation of the timer thread running the periodic work of the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include "cJSONLoggerTimer.h"
+#include "cJSONLoggerAssert.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @struct LoggerTimer
+ *
+ * @brief A timer thread.
+ *
+ * @var thread The timer thread.
+ * @var intervalMs The interval in milliseconds between two runs.
+ * @var func The function to run.
+ * @var ctx The context passed to the function.
+ * @var stop Set when the timer is destroyed.
+ * @var mutex Mutex protecting stop.
+ * @var cond Signaled when the timer is destroyed, waited on with CLOCK_MONOTONIC timeouts.
+ */
+struct LoggerTimer {
+    pthread_t thread;
+    unsigned int intervalMs;
+    LoggerTimerFunc func;
+    void* ctx;
+    int stop;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+/**
+ * @brief Handler of the timer thread.
+ *
+ * @param ctx The timer.
+ *
+ * @return void*, always NULL.
+ */
+static void* loggerTimerHandler(void* ctx)
+{
+    LoggerTimer_s* timer = (LoggerTimer_s*)ctx;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    pthread_mutex_lock(&timer->mutex);
+    while (timer->stop == 0) {
+        deadline.tv_sec += (time_t)(timer->intervalMs / 1000);
+        deadline.tv_nsec += (long)(timer->intervalMs % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        // Spurious wake ups wait again until the deadline.
+        int waitRes = 0;
+        while (timer->stop == 0 && waitRes == 0) {
+            waitRes = pthread_cond_timedwait(&timer->cond, &timer->mutex, &deadline);
+        }
+
+        if (timer->stop != 0) {
+            break;
+        }
+
+        pthread_mutex_unlock(&timer->mutex);
+        timer->func(timer->ctx);
+        pthread_mutex_lock(&timer->mutex);
+
+        // A run longer than the interval skips the missed runs instead of running back to back.
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec > deadline.tv_nsec)) {
+            deadline = now;
+        }
+    }
+    pthread_mutex_unlock(&timer->mutex);
+
+    return NULL;
+}
+
+LoggerTimer_s* loggerTimerCreate(unsigned int intervalMs, const LoggerThreadAttr_s* attr, LoggerTimerFunc func, void* ctx)
+{
+    if (intervalMs == 0 || func == NULL) {
+        return NULL;
+    }
+
+    LoggerTimer_s* timer = (LoggerTimer_s*)calloc(1, sizeof(LoggerTimer_s));
+    CJSON_LOGGER_ASSERT_NEQ(timer, NULL);
+    if (timer == NULL) {
+        return NULL;
+    }
+
+    timer->intervalMs = intervalMs;
+    timer->func = func;
+    timer->ctx = ctx;
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->cond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    pthread_mutex_init(&timer->mutex, NULL);
+
+    if (loggerThreadCreate(&timer->thread, attr, loggerTimerHandler, timer) != 0) {
+        pthread_cond_destroy(&timer->cond);
+        pthread_mutex_destroy(&timer->mutex);
+        free(timer);
+        return NULL;
+    }
+
+    return timer;
+}
+
+void loggerTimerDestroy(LoggerTimer_s* timer)
+{
+    if (timer == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&timer->mutex);
+    timer->stop = 1;
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    pthread_join(timer->thread, NULL);
+
+    pthread_cond_destroy(&timer->cond);
+    pthread_mutex_destroy(&timer->mutex);
+    free(timer);
+}
+
+void loggerTimerAbandon(LoggerTimer_s* timer)
+{
+    free(timer);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file cJSONLoggerTimer.h
+ *
+ * @brief This file contains the interface of the timer thread running the periodic work of the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_TIMER_H
+#define CJSON_LOGGER_TIMER_H
+
+#include "cJSONLoggerThread.h"
+
+/**
+ * @brief Function type of the work run by a timer.
+ *
+ * @param ctx The context the timer was created with.
+ */
+typedef void (*LoggerTimerFunc)(void* ctx);
+
+/**
+ * @brief Opaque timer.
+ */
+typedef struct LoggerTimer LoggerTimer_s;
+
+/**
+ * @brief Create a timer thread running a function at a fixed interval.
+ *
+ * @param intervalMs The interval in milliseconds between two runs.
+ * @param attr The scheduling attributes of the timer thread, NULL for the defaults.
+ * @param func The function to run.
+ * @param ctx The context passed to the function.
+ *
+ * @return LoggerTimer_s* ptr of the new timer, NULL in case of failure.
+ */
+LoggerTimer_s* loggerTimerCreate(unsigned int intervalMs, const LoggerThreadAttr_s* attr, LoggerTimerFunc func, void* ctx);
+
+/**
+ * @brief Stop a timer and wait for its thread to exit, a run in progress completes first.
+ *
+ * @param timer The timer to destroy.
+ */
+void loggerTimerDestroy(LoggerTimer_s* timer);
+
+/**
+ * @brief Release a timer inherited by a forked child process, whose thread was not inherited.
+ *
+ * @param timer The timer to release.
+ */
+void loggerTimerAbandon(LoggerTimer_s* timer);
+
+#endif // CJSON_LOGGER_TIMER_H
@@ -0,0 +1,497 @@
+/**
+ * @file cJSONLoggerWorkerPool.c
+ *
+ * @brief This file contains the implementation of the worker pool that runs the background work of the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#define _GNU_SOURCE
+
+#include "cJSONLoggerWorkerPool.h"
+#include "cJSONLoggerAssert.h"
+#include "cJSONLoggerThread.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @def INITIAL_DEQUE_CAPACITY
+ *
+ * @brief The initial number of tasks the deque of a worker can hold.
+ */
+#define INITIAL_DEQUE_CAPACITY 32
+
+/**
+ * @struct WorkerPoolTask
+ *
+ * @brief A task queued in the worker pool.
+ *
+ * @var func The task function.
+ * @var ctx The context passed to the task function.
+ * @var group The group the task belongs to, can be NULL.
+ */
+typedef struct WorkerPoolTask {
+    WorkerPoolTaskFunc func;
+    void* ctx;
+    WorkerPoolGroup_s* group;
+} WorkerPoolTask_s;
+
+/**
+ * @struct WorkerPoolWorker
+ *
+ * @brief A worker thread and its task deque.
+ *
+ * @var pool The pool the worker belongs to.
+ * @var thread The worker thread.
+ * @var tasks Circular deque of the tasks, the owner pops from the bottom and thieves steal from the top.
+ * @var top Index of the oldest task.
+ * @var taskCount Number of queued tasks.
+ * @var taskCapacity Allocated size of the deque.
+ * @var mutex Mutex protecting the deque.
+ */
+typedef struct WorkerPoolWorker {
+    struct WorkerPool* pool;
+    pthread_t thread;
+    WorkerPoolTask_s* tasks;
+    unsigned int top;
+    unsigned int taskCount;
+    unsigned int taskCapacity;
+    pthread_mutex_t mutex;
+} WorkerPoolWorker_s;
+
+/**
+ * @struct WorkerPool
+ *
+ * @brief Fixed size pool of work stealing worker threads.
+ *
+ * @var workers The workers.
+ * @var workerCount The number of workers.
+ * @var nextWorker Round robin index of the worker receiving the next task submitted from outside the pool.
+ * @var queuedTasks Number of tasks queued over all the deques.
+ * @var stop Set when the pool is destroyed.
+ * @var periodicFunc The periodic task function, NULL if none.
+ * @var periodicCtx The context passed to the periodic task function.
+ * @var periodicIntervalMs The interval in milliseconds between two runs of the periodic task.
+ * @var periodicDeadline Time (CLOCK_MONOTONIC) of the next run of the periodic task.
+ * @var periodicRunning Set while a worker runs the periodic task.
+ * @var mutex Mutex used to put idle threads to sleep, protects the periodic task.
+ * @var taskCond Signaled when a task is queued, the periodic task changes or the pool is stopped, waited on with CLOCK_MONOTONIC timeouts.
+ * @var doneCond Signaled when a group has no more pending tasks.
+ */
+struct WorkerPool {
+    WorkerPoolWorker_s* workers;
+    unsigned int workerCount;
+    atomic_uint nextWorker;
+    atomic_uint queuedTasks;
+    int stop;
+    WorkerPoolTaskFunc periodicFunc;
+    void* periodicCtx;
+    unsigned int periodicIntervalMs;
+    struct timespec periodicDeadline;
+    int periodicRunning;
+    pthread_mutex_t mutex;
+    pthread_cond_t taskCond;
+    pthread_cond_t doneCond;
+};
+
+/**
+ * @brief The worker the current thread runs, NULL for threads outside the pool.
+ */
+static _Thread_local WorkerPoolWorker_s* s_t_worker = NULL;
+
+/**
+ * @brief Push a task at the bottom of a worker deque.
+ *
+ * @param worker The worker owning the deque.
+ * @param task The task to push.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int workerPush(WorkerPoolWorker_s* worker, const WorkerPoolTask_s* task)
+{
+    pthread_mutex_lock(&worker->mutex);
+    if (worker->taskCount == worker->taskCapacity) {
+        unsigned int capacity = worker->taskCapacity * 2;
+        WorkerPoolTask_s* tasks = (WorkerPoolTask_s*)malloc(capacity * sizeof(WorkerPoolTask_s));
+        CJSON_LOGGER_ASSERT_NEQ(tasks, NULL);
+        if (tasks == NULL) {
+            pthread_mutex_unlock(&worker->mutex);
+            return -1;
+        }
+
+        for (unsigned int i = 0; i < worker->taskCount; i++) {
+            tasks[i] = worker->tasks[(worker->top + i) % worker->taskCapacity];
+        }
+
+        free(worker->tasks);
+        worker->tasks = tasks;
+        worker->top = 0;
+        worker->taskCapacity = capacity;
+    }
+
+    worker->tasks[(worker->top + worker->taskCount) % worker->taskCapacity] = *task;
+    worker->taskCount++;
+    pthread_mutex_unlock(&worker->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief Take a task out of a worker deque.
+ *
+ * @param worker The worker owning the deque.
+ * @param task Where the task will be stored.
+ * @param fromBottom Take the newest task (owner) instead of the oldest one (thief).
+ * @param group Only take a task of this group, NULL to take any task.
+ *
+ * @return int, 1 if a task was taken, 0 otherwise.
+ */
+static int workerTake(WorkerPoolWorker_s* worker, WorkerPoolTask_s* task, int fromBottom, const WorkerPoolGroup_s* group)
+{
+    pthread_mutex_lock(&worker->mutex);
+    for (unsigned int i = 0; i < worker->taskCount; i++) {
+        unsigned int position = fromBottom ? worker->taskCount - 1 - i : i;
+        unsigned int index = (worker->top + position) % worker->taskCapacity;
+        if (group != NULL && worker->tasks[index].group != group) {
+            continue;
+        }
+
+        *task = worker->tasks[index];
+
+        // Close the gap, tasks are usually taken from either end so this rarely moves anything.
+        if (position == 0) {
+            worker->top = (worker->top + 1) % worker->taskCapacity;
+        }
+
+        else {
+            for (unsigned int j = position; j + 1 < worker->taskCount; j++) {
+                worker->tasks[(worker->top + j) % worker->taskCapacity] = worker->tasks[(worker->top + j + 1) % worker->taskCapacity];
+            }
+        }
+
+        worker->taskCount--;
+        pthread_mutex_unlock(&worker->mutex);
+
+        atomic_fetch_sub(&worker->pool->queuedTasks, 1);
+        return 1;
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief Find a task to execute, first from the own deque and then by stealing from the other workers.
+ *
+ * @param pool The pool to search.
+ * @param self The worker searching, NULL for threads outside the pool.
+ * @param task Where the task will be stored.
+ * @param group Only take a task of this group, NULL to take any task.
+ *
+ * @return int, 1 if a task was found, 0 otherwise.
+ */
+static int workerPoolFind(WorkerPool_s* pool, WorkerPoolWorker_s* self, WorkerPoolTask_s* task, const WorkerPoolGroup_s* group)
+{
+    if (atomic_load(&pool->queuedTasks) == 0) {
+        return 0;
+    }
+
+    if (self != NULL && workerTake(self, task, 1, group) != 0) {
+        return 1;
+    }
+
+    unsigned int start = self != NULL ? (unsigned int)(self - pool->workers) + 1 : 0;
+    for (unsigned int i = 0; i < pool->workerCount; i++) {
+        WorkerPoolWorker_s* victim = &pool->workers[(start + i) % pool->workerCount];
+        if (victim != self && workerTake(victim, task, 0, group) != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Execute a task and account for its completion.
+ *
+ * @param pool The pool the task was taken from.
+ * @param task The task to execute.
+ */
+static void workerPoolRun(WorkerPool_s* pool, const WorkerPoolTask_s* task)
+{
+    task->func(task->ctx);
+
+    if (task->group != NULL && atomic_fetch_sub(&task->group->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->mutex);
+        pthread_cond_broadcast(&pool->doneCond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+/**
+ * @brief Add milliseconds to a time.
+ *
+ * @param time The time to advance.
+ * @param ms The milliseconds to add.
+ */
+static void workerPoolTimeAdd(struct timespec* time, unsigned int ms)
+{
+    time->tv_sec += (time_t)(ms / 1000);
+    time->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (time->tv_nsec >= 1000000000L) {
+        time->tv_sec++;
+        time->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief Run the periodic task if it is due, or sleep until it is, on an idle worker.
+ *
+ * @note Must be called with the pool mutex held, it is released while the task runs.
+ *
+ * @param pool The pool.
+ */
+static void workerPoolRunPeriodic(WorkerPool_s* pool)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    const struct timespec* deadline = &pool->periodicDeadline;
+    if (now.tv_sec < deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec < deadline->tv_nsec)) {
+        pthread_cond_timedwait(&pool->taskCond, &pool->mutex, deadline);
+        return;
+    }
+
+    WorkerPoolTaskFunc func = pool->periodicFunc;
+    void* ctx = pool->periodicCtx;
+    pool->periodicRunning = 1;
+    pthread_mutex_unlock(&pool->mutex);
+
+    func(ctx);
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->periodicRunning = 0;
+
+    // A run longer than the interval skips the missed runs instead of running back to back.
+    workerPoolTimeAdd(&pool->periodicDeadline, pool->periodicIntervalMs);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec > deadline->tv_nsec)) {
+        pool->periodicDeadline = now;
+        workerPoolTimeAdd(&pool->periodicDeadline, pool->periodicIntervalMs);
+    }
+}
+
+/**
+ * @brief Worker thread handler.
+ *
+ * @param ctx The worker.
+ *
+ * @return always NULL
+ */
+static void* workerPoolHandler(void* ctx)
+{
+    WorkerPoolWorker_s* self = (WorkerPoolWorker_s*)ctx;
+    WorkerPool_s* pool = self->pool;
+    s_t_worker = self;
+
+    for (;;) {
+        WorkerPoolTask_s task;
+        if (workerPoolFind(pool, self, &task, NULL) != 0) {
+            workerPoolRun(pool, &task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        if (atomic_load(&pool->queuedTasks) == 0) {
+            if (pool->stop != 0) {
+                pthread_mutex_unlock(&pool->mutex);
+                break;
+            }
+
+            // One idle worker at a time waits for the periodic task, the others wait for tasks.
+            if (pool->periodicFunc != NULL && pool->periodicRunning == 0) {
+                workerPoolRunPeriodic(pool);
+            }
+
+            else {
+                pthread_cond_wait(&pool->taskCond, &pool->mutex);
+            }
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+
+    s_t_worker = NULL;
+    return NULL;
+}
+
+WorkerPool_s* workerPoolCreate(unsigned int threadCount, const LoggerThreadAttr_s* attr)
+{
+    if (attr != NULL && loggerThreadAttrValidate(attr) != 0) {
+        return NULL;
+    }
+
+    WorkerPool_s* pool = (WorkerPool_s*)calloc(1, sizeof(WorkerPool_s));
+    CJSON_LOGGER_ASSERT_NEQ(pool, NULL);
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->workers = (WorkerPoolWorker_s*)calloc(threadCount, sizeof(WorkerPoolWorker_s));
+    CJSON_LOGGER_ASSERT_NEQ(pool->workers, NULL);
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pool->taskCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->doneCond, NULL);
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        WorkerPoolWorker_s* worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->tasks = (WorkerPoolTask_s*)malloc(INITIAL_DEQUE_CAPACITY * sizeof(WorkerPoolTask_s));
+        worker->taskCapacity = INITIAL_DEQUE_CAPACITY;
+        CJSON_LOGGER_ASSERT_NEQ(worker->tasks, NULL);
+        if (worker->tasks == NULL) {
+            break;
+        }
+
+        pthread_mutex_init(&worker->mutex, NULL);
+
+        int res = loggerThreadCreate(&worker->thread, attr, workerPoolHandler, worker);
+        if (res != 0) {
+            pthread_mutex_destroy(&worker->mutex);
+            free(worker->tasks);
+            worker->tasks = NULL;
+            break;
+        }
+
+        pool->workerCount++;
+    }
+
+    // The scheduling attributes can be refused at runtime (e.g. real time policies without privileges), so a short pool is a failure, not a bug.
+    if (pool->workerCount != threadCount) {
+        workerPoolDestroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void workerPoolDestroy(WorkerPool_s* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->taskCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (unsigned int i = 0; i < pool->workerCount; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (unsigned int i = 0; i < pool->workerCount; i++) {
+        pthread_mutex_destroy(&pool->workers[i].mutex);
+        free(pool->workers[i].tasks);
+    }
+
+    pthread_cond_destroy(&pool->doneCond);
+    pthread_cond_destroy(&pool->taskCond);
+    pthread_mutex_destroy(&pool->mutex);
+
+    free(pool->workers);
+    free(pool);
+}
+
+void workerPoolAbandon(WorkerPool_s* pool)
+{
+    // The forking thread is the only thread of the child, it can not be running a task of the pool anymore.
+    s_t_worker = NULL;
+
+    if (pool == NULL) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < pool->workerCount; i++) {
+        free(pool->workers[i].tasks);
+    }
+
+    free(pool->workers);
+    free(pool);
+}
+
+int workerPoolSubmit(WorkerPool_s* pool, WorkerPoolGroup_s* group, WorkerPoolTaskFunc func, void* ctx)
+{
+    WorkerPoolTask_s task = { func, ctx, group };
+
+    WorkerPoolWorker_s* worker = s_t_worker;
+    if (worker == NULL || worker->pool != pool) {
+        worker = &pool->workers[atomic_fetch_add(&pool->nextWorker, 1) % pool->workerCount];
+    }
+
+    if (group != NULL) {
+        atomic_fetch_add(&group->pending, 1);
+    }
+
+    // Count the task before it becomes visible, so that taking it can never underflow the counter.
+    atomic_fetch_add(&pool->queuedTasks, 1);
+
+    if (workerPush(worker, &task) != 0) {
+        atomic_fetch_sub(&pool->queuedTasks, 1);
+        if (group != NULL) {
+            atomic_fetch_sub(&group->pending, 1);
+        }
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pthread_cond_signal(&pool->taskCond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return 0;
+}
+
+void workerPoolSetPeriodic(WorkerPool_s* pool, unsigned int intervalMs, WorkerPoolTaskFunc func, void* ctx)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->periodicFunc = intervalMs != 0 ? func : NULL;
+    pool->periodicCtx = ctx;
+    pool->periodicIntervalMs = intervalMs;
+    clock_gettime(CLOCK_MONOTONIC, &pool->periodicDeadline);
+    workerPoolTimeAdd(&pool->periodicDeadline, intervalMs);
+
+    // The sleeping workers pick up the new deadline.
+    pthread_cond_broadcast(&pool->taskCond);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void workerPoolWait(WorkerPool_s* pool, WorkerPoolGroup_s* group)
+{
+    WorkerPoolWorker_s* self = s_t_worker != NULL && s_t_worker->pool == pool ? s_t_worker : NULL;
+
+    while (atomic_load(&group->pending) != 0) {
+        WorkerPoolTask_s task;
+        if (workerPoolFind(pool, self, &task, group) != 0) {
+            workerPoolRun(pool, &task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        if (atomic_load(&group->pending) != 0) {
+            pthread_cond_wait(&pool->doneCond, &pool->mutex);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
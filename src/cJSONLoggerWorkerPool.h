@@ -0,0 +1,105 @@
+/**
+ * @file cJSONLoggerWorkerPool.h
+ *
+ * @brief This file contains the interface of the worker pool that runs the background work of the cJSON logger library.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CJSON_LOGGER_WORKER_POOL_H
+#define CJSON_LOGGER_WORKER_POOL_H
+
+#include "cJSONLoggerThread.h"
+
+#include <stdatomic.h>
+
+/**
+ * @brief Function type of a task executed by the worker pool.
+ *
+ * @param ctx The context the task was submitted with.
+ */
+typedef void (*WorkerPoolTaskFunc)(void* ctx);
+
+/**
+ * @struct WorkerPoolGroup
+ *
+ * @brief Group of tasks that can be waited on together.
+ *
+ * @var pending Number of tasks of the group that have not finished yet.
+ */
+typedef struct WorkerPoolGroup {
+    atomic_uint pending;
+} WorkerPoolGroup_s;
+
+/**
+ * @brief Opaque worker pool.
+ */
+typedef struct WorkerPool WorkerPool_s;
+
+/**
+ * @brief Create a worker pool.
+ *
+ * @param threadCount The number of worker threads.
+ * @param attr The scheduling attributes of the worker threads, NULL for the defaults.
+ *
+ * @return WorkerPool_s* ptr of the new pool, NULL in case of failure.
+ */
+WorkerPool_s* workerPoolCreate(unsigned int threadCount, const LoggerThreadAttr_s* attr);
+
+/**
+ * @brief Destroy a worker pool, queued tasks are executed before the worker threads exit.
+ *
+ * @param pool The pool to destroy.
+ */
+void workerPoolDestroy(WorkerPool_s* pool);
+
+/**
+ * @brief Release a worker pool inherited by a forked child process.
+ *
+ * @note The worker threads do not exist in the child and the pool mutexes may have been held at the time of the fork,
+ * so the queued tasks are dropped and only the memory of the pool is released.
+ *
+ * @param pool The pool to release.
+ */
+void workerPoolAbandon(WorkerPool_s* pool);
+
+/**
+ * @brief Submit a task to the worker pool.
+ *
+ * @note Tasks submitted by a worker thread are queued on its own deque, other tasks are spread over the workers. Idle workers steal from the others.
+ *
+ * @param pool The pool that will execute the task.
+ * @param group The group the task belongs to, can be NULL.
+ * @param func The task function.
+ * @param ctx The context passed to the task function.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int workerPoolSubmit(WorkerPool_s* pool, WorkerPoolGroup_s* group, WorkerPoolTaskFunc func, void* ctx);
+
+/**
+ * @brief Run a task periodically on an idle worker of the pool, so periodic work needs no thread of its own.
+ *
+ * @note The task runs once no task is queued, a run longer than the interval skips the missed runs. It replaces the previous
+ * periodic task and a run in progress completes first when the pool is destroyed.
+ *
+ * @param pool The pool that will execute the task.
+ * @param intervalMs The interval in milliseconds between two runs, 0 stops the periodic task.
+ * @param func The task function.
+ * @param ctx The context passed to the task function.
+ */
+void workerPoolSetPeriodic(WorkerPool_s* pool, unsigned int intervalMs, WorkerPoolTaskFunc func, void* ctx);
+
+/**
+ * @brief Wait until every task of a group has finished.
+ *
+ * @note The calling thread executes the queued tasks of the group while it waits, so waiting from a worker thread cannot starve the pool.
+ *
+ * @param pool The pool the tasks were submitted to.
+ * @param group The group to wait on.
+ */
+void workerPoolWait(WorkerPool_s* pool, WorkerPoolGroup_s* group);
+
+#endif // CJSON_LOGGER_WORKER_POOL_H
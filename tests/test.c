@@ -8,10 +8,25 @@
  * @date 2025-08-26
  */
 
+#define _GNU_SOURCE
+
 #include <cJSONLogger.h>
+#include <cJSONLoggerEscape.h>
+#include <cJSONLoggerLogIndex.h>
+#include <cJSONLoggerShmRing.h>
 
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
+#include <poll.h>
+#include <sched.h>
 #include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -426,30 +441,44 @@ static int test_cJSONLogger_severity_reached(void)
  */
 static int test_cJSONLogger_destroy(void)
 {
+    remove(LOG_FILE);
+
     int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
     assert(res == 0);
+
+    // Destroying a clean logger does no I/O, destroying it again does nothing.
+    cJSONLoggerDestroy();
     cJSONLoggerDestroy();
 
     CJSON_LOG_CRITICAL("bar");
 
     cJSONLoggerDump();
 
+    if (access(LOG_FILE, F_OK) == 0) {
+        return FAILED;
+    }
+
+    // Destroying a dirty logger writes its logs.
+    res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+    CJSON_LOG_CRITICAL("%" JNO "bar", "foo");
+    cJSONLoggerDestroy();
+
     char* logData = readFile(LOG_FILE);
     if (logData == NULL) {
         return FAILED;
     }
 
-    cJSON* expectedLogs = cJSON_CreateObject();
-    char* expectedLogsStr = cJSON_Print(expectedLogs);
-    cJSON_Delete(expectedLogs);
+    cJSON* loggedJson = cJSON_Parse(logData);
+    free(logData);
+    logData = NULL;
 
-    int ret = FAILED;
-    if (strncmp(expectedLogsStr, logData, strlen(logData)) == 0) {
-        ret = PASSED;
+    if (loggedJson == NULL) {
+        return FAILED;
     }
 
-    free(logData);
-    free(expectedLogsStr);
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(loggedJson, "foo"), "logs")) == 1 ? PASSED : FAILED;
+    cJSON_Delete(loggedJson);
 
     return ret;
 }
@@ -568,6 +597,3621 @@ static int test_cJSONLogger_rotate(void)
     return PASSED;
 }
 
+/**
+ * @brief Check that the dumped log file is byte identical to printing it with cJSON_Print().
+ *
+ * @param jsonLogsDoc Where the parsed log file will be stored if it matches, to be deleted with cJSON_Delete(), NULL to only check it.
+ *
+ * @return int, PASSED if the file matches, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int dumpMatchesCJSONPrint(cJSON** jsonLogsDoc)
+{
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* parsedLogsDoc = cJSON_Parse(logData);
+    if (parsedLogsDoc == NULL) {
+        RELEASE_RESOURCE_AND_RETURN_FAIL(logData, free);
+    }
+
+    char* expectedLogsStr = cJSON_Print(parsedLogsDoc);
+
+    int ret = FAILED;
+    if (expectedLogsStr != NULL && strcmp(expectedLogsStr, logData) == 0) {
+        ret = PASSED;
+    }
+
+    if (ret == PASSED && jsonLogsDoc != NULL) {
+        *jsonLogsDoc = parsedLogsDoc;
+    }
+
+    else {
+        cJSON_Delete(parsedLogsDoc);
+    }
+
+    free(logData);
+    free(expectedLogsStr);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the dumped logs are byte identical to printing them with cJSON_Print().
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_dump_cjson_equivalence(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_DEBUG, LOG_FILE);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "%" JNO "value %d", "foo", "bar", 1);
+    CJSON_LOG_WARN("%" JNO "value %d", "foo", 2);
+    CJSON_LOG_ERROR("%" JNO "%" JNO "value %d", "FOO", "baz", 3);
+    CJSON_LOG_CRITICAL("quote \" backslash \\ control \n\t\r\b\f\x01 utf8 \xc3\xa9");
+    CJSON_LOG_DEBUG("before %" JNO "inside %" JNO "deeper", "qux", "quux");
+    cJSONLoggerLog(CJSON_LOG_LEVEL_INFO, "%" JNO "no call site", "foo");
+    CJSON_LOG_INFO("%s", "");
+
+    cJSONLoggerDump();
+
+    return dumpMatchesCJSONPrint(NULL);
+}
+
+/**
+ * @struct ExpectedLog
+ *
+ * @brief A log of test_cJSONLogger_dump_matches_cjson_tree() and the call site it is logged from.
+ *
+ * @var logLevel The log level of the log.
+ * @var logLevelStr The printed log level of the log.
+ * @var jsonPath The names of the JSON nodes of the log.
+ * @var jsonPathDepth The number of names in the jsonPath, up to 2.
+ * @var fileName The file name of the call site, NULL for a log without call site.
+ * @var funcName The function name of the call site.
+ * @var fileLine The file line of the call site.
+ * @var logMsg The log message.
+ */
+typedef struct ExpectedLog {
+    CJSON_LOG_LEVEL_E logLevel;
+    const char* logLevelStr;
+    const char* jsonPath[2];
+    size_t jsonPathDepth;
+    const char* fileName;
+    const char* funcName;
+    int fileLine;
+    const char* logMsg;
+} ExpectedLog_s;
+
+/**
+ * @brief Log an expected log with cJSONLoggerLog(), passing its call site the way the CJSON_LOG_XXX macros do.
+ *
+ * @param log The log.
+ */
+static void logExpectedLog(const ExpectedLog_s* log)
+{
+    if (log->fileName == NULL) {
+        cJSONLoggerLog(log->logLevel, "%" JNO "%s", log->jsonPath[0], log->logMsg);
+        return;
+    }
+
+    switch (log->jsonPathDepth) {
+    case 0:
+        cJSONLoggerLog(log->logLevel, "$$%s$$%s$$%d$$%s", log->fileName, log->funcName, log->fileLine, log->logMsg);
+        break;
+    case 1:
+        cJSONLoggerLog(log->logLevel, "$$%s$$%s$$%d$$%" JNO "%s", log->fileName, log->funcName, log->fileLine, log->jsonPath[0], log->logMsg);
+        break;
+    default:
+        cJSONLoggerLog(log->logLevel, "$$%s$$%s$$%d$$%" JNO "%" JNO "%s", log->fileName, log->funcName, log->fileLine, log->jsonPath[0],
+            log->jsonPath[1], log->logMsg);
+        break;
+    }
+}
+
+/**
+ * @brief Add an expected log to a cJSON tree the way the logger built its tree with cJSON, the time is taken from the same log of the dump.
+ *
+ * @param root The root of the tree.
+ * @param dumped The root of the dumped tree.
+ * @param log The log.
+ */
+static void addExpectedLog(cJSON* root, const cJSON* dumped, const ExpectedLog_s* log)
+{
+    cJSON* node = root;
+    for (size_t i = 0; i < log->jsonPathDepth || (log->fileName == NULL && i < 1); i++) {
+        cJSON* child = cJSON_GetObjectItem(node, log->jsonPath[i]);
+        if (child == NULL) {
+            child = cJSON_CreateObject();
+            cJSON_AddItemToObject(node, log->jsonPath[i], child);
+        }
+        node = child;
+        dumped = cJSON_GetObjectItem(dumped, log->jsonPath[i]);
+    }
+
+    cJSON* logs = cJSON_GetObjectItem(node, "logs");
+    if (logs == NULL) {
+        logs = cJSON_CreateArray();
+        cJSON_AddItemToObject(node, "logs", logs);
+    }
+
+    const cJSON* time = cJSON_GetObjectItem(cJSON_GetArrayItem(cJSON_GetObjectItem(dumped, "logs"), cJSON_GetArraySize(logs)), "Time");
+
+    cJSON* jsonLog = cJSON_CreateObject();
+    cJSON_AddItemToArray(logs, jsonLog);
+    cJSON_AddItemToObject(jsonLog, "Time", cJSON_CreateString(cJSON_IsString(time) ? time->valuestring : ""));
+    cJSON_AddItemToObject(jsonLog, "LogLevel", cJSON_CreateString(log->logLevelStr));
+    if (log->fileName != NULL) {
+        cJSON_AddItemToObject(jsonLog, "FileName", cJSON_CreateString(log->fileName));
+        cJSON_AddItemToObject(jsonLog, "FuncName", cJSON_CreateString(log->funcName));
+        cJSON_AddItemToObject(jsonLog, "FileLine", cJSON_CreateNumber(log->fileLine));
+    }
+    cJSON_AddItemToObject(jsonLog, "Log", cJSON_CreateString(log->logMsg));
+}
+
+/**
+ * @brief Test that the dump of a mixed tree is byte identical to printing the same tree built with cJSON.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_dump_matches_cjson_tree(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_DEBUG, LOG_FILE);
+    assert(res == 0);
+
+    // Every log level, nodes gaining logs after their children, a node named in another case, repeated call sites and a log without call site.
+    const ExpectedLog_s logs[] = {
+        { CJSON_LOG_LEVEL_INFO, "INFO", { "foo", "bar" }, 2, "test.c", "funcA", 10, "value 1" },
+        { CJSON_LOG_LEVEL_WARN, "WARN", { "foo" }, 1, "test.c", "funcA", 11, "value 2" },
+        { CJSON_LOG_LEVEL_ERROR, "ERROR", { "FOO", "baz" }, 2, "test.c", "funcB", 20, "value 3" },
+        { CJSON_LOG_LEVEL_CRITICAL, "CRITICAL", { 0 }, 0, "other.c", "funcC", 30, "quote \" backslash \\ control \n\t\r\b\f\x01 utf8 \xc3\xa9" },
+        { CJSON_LOG_LEVEL_DEBUG, "DEBUG", { "qux" }, 1, NULL, NULL, 0, "no call site" },
+        { CJSON_LOG_LEVEL_INFO, "INFO", { 0 }, 0, "test.c", "funcA", 10, "" },
+        { CJSON_LOG_LEVEL_INFO, "INFO", { "foo", "bar" }, 2, "test.c", "funcA", 10, "value 1 again" },
+        { CJSON_LOG_LEVEL_WARN, "WARN", { "qux", "quux" }, 2, "other.c", "funcC", 31, "tab \t slash /" },
+        { CJSON_LOG_LEVEL_ERROR, "ERROR", { "foo" }, 1, "test.c", "funcB", 20, "value 4" },
+    };
+
+    const size_t logCount = sizeof(logs) / sizeof(logs[0]);
+    for (size_t i = 0; i < logCount; i++) {
+        logExpectedLog(&logs[i]);
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    cJSON* expected = cJSON_CreateObject();
+    for (size_t i = 0; i < logCount; i++) {
+        addExpectedLog(expected, jsonLogsDoc, &logs[i]);
+    }
+
+    char* expectedLogsStr = cJSON_Print(expected);
+    int ret = expectedLogsStr != NULL && strcmp(expectedLogsStr, logData) == 0 ? PASSED : FAILED;
+
+    free(expectedLogsStr);
+    cJSON_Delete(expected);
+    cJSON_Delete(jsonLogsDoc);
+    free(logData);
+
+    return ret;
+}
+
+/**
+ * @def CALL_SITE_COUNT
+ *
+ * @brief The number of call sites of test_cJSONLogger_call_site_interning(), more than the interned call site table starts with.
+ */
+#define CALL_SITE_COUNT 100
+
+/**
+ * @struct CallSiteState
+ *
+ * @brief Call sites observed by the callback of test_cJSONLogger_call_site_interning().
+ *
+ * @var fileNames Per file line, the file name of the first record.
+ * @var funcNames Per file line, the function name of the first record.
+ * @var records Per file line, the number of records received.
+ * @var badRecords Number of records whose call site strings differ from the first record of their file line.
+ */
+typedef struct CallSiteState {
+    const char* fileNames[CALL_SITE_COUNT + 1];
+    const char* funcNames[CALL_SITE_COUNT + 1];
+    int records[CALL_SITE_COUNT + 1];
+    int badRecords;
+} CallSiteState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_call_site_interning(), checks the records of a call site share its strings.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The CallSiteState_s of the test.
+ */
+static void callSiteRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    CallSiteState_s* state = (CallSiteState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        int fileLine = records[i].fileLine;
+        if (fileLine < 1 || fileLine > CALL_SITE_COUNT || records[i].fileName == NULL || records[i].funcName == NULL
+            || strcmp(records[i].fileName, "interned.c") != 0 || strcmp(records[i].funcName, "internedFunc") != 0) {
+            state->badRecords++;
+            continue;
+        }
+
+        if (state->records[fileLine]++ == 0) {
+            state->fileNames[fileLine] = records[i].fileName;
+            state->funcNames[fileLine] = records[i].funcName;
+        }
+
+        else if (records[i].fileName != state->fileNames[fileLine] || records[i].funcName != state->funcNames[fileLine]) {
+            state->badRecords++;
+        }
+    }
+}
+
+/**
+ * @brief Test that the logs of a call site share one interned call site, also once the interned call site table grew.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_call_site_interning(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    // The call sites are interleaved so every one of them is looked up again after the table grew.
+    for (int i = 0; i < 4; i++) {
+        for (int fileLine = 1; fileLine <= CALL_SITE_COUNT; fileLine++) {
+            cJSONLoggerLog(CJSON_LOG_LEVEL_INFO, "$$%s$$%s$$%d$$%" JNO "value %d", "interned.c", "internedFunc", fileLine, "foo", i);
+        }
+    }
+
+    static CallSiteState_s state;
+    memset(&state, 0, sizeof(state));
+
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    if (cJSONLoggerQuery(&query, callSiteRecords, &state) != 4 * CALL_SITE_COUNT || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    // Every call site holds its own strings, shared by its logs.
+    for (int fileLine = 1; fileLine <= CALL_SITE_COUNT; fileLine++) {
+        if (state.records[fileLine] != 4 || (fileLine > 1 && state.fileNames[fileLine] == state.fileNames[fileLine - 1])) {
+            return FAILED;
+        }
+    }
+
+    memset(&state, 0, sizeof(state));
+    query.fileLine = CALL_SITE_COUNT / 2;
+    if (cJSONLoggerQuery(&query, callSiteRecords, &state) != 4 || state.records[CALL_SITE_COUNT / 2] != 4) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    return dumpMatchesCJSONPrint(NULL);
+}
+
+/**
+ * @struct ReusedBufferState
+ *
+ * @brief Call sites observed by the callback of test_cJSONLogger_call_site_reused_buffer().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records whose call site strings differ from the ones formatted into the buffer for them.
+ */
+typedef struct ReusedBufferState {
+    int records;
+    int badRecords;
+} ReusedBufferState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_call_site_reused_buffer(), the even records were logged from "first.c" and the odd ones from "second.c".
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The ReusedBufferState_s of the test.
+ */
+static void reusedBufferRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    ReusedBufferState_s* state = (ReusedBufferState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        int second = state->records++ % 2;
+        if (records[i].fileName == NULL || records[i].funcName == NULL || strcmp(records[i].fileName, second != 0 ? "second.c" : "first.c") != 0
+            || strcmp(records[i].funcName, second != 0 ? "secondFunc" : "firstFunc") != 0) {
+            state->badRecords++;
+        }
+    }
+}
+
+/**
+ * @brief Test that the call sites are interned by the contents of their names, a logging wrapper may format them into one reused buffer.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_call_site_reused_buffer(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    char fileName[MAX_STRING_LEN];
+    char funcName[MAX_STRING_LEN];
+    for (int i = 0; i < 8; i++) {
+        snprintf(fileName, sizeof(fileName), "%s", i % 2 != 0 ? "second.c" : "first.c");
+        snprintf(funcName, sizeof(funcName), "%s", i % 2 != 0 ? "secondFunc" : "firstFunc");
+        cJSONLoggerLog(CJSON_LOG_LEVEL_INFO, "$$%s$$%s$$%d$$%" JNO "value %d", fileName, funcName, 7, "foo", i);
+    }
+
+    ReusedBufferState_s state = { 0 };
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    if (cJSONLoggerQuery(&query, reusedBufferRecords, &state) != 8 || state.records != 8 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    // The call sites differ by their names only, each one is found by a query on its file name.
+    memset(&state, 0, sizeof(state));
+    query.fileName = "first.c";
+    if (cJSONLoggerQuery(&query, reusedBufferRecords, &state) != 4) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    cJSON* jsonLogsDoc = NULL;
+    if (dumpMatchesCJSONPrint(&jsonLogsDoc) != PASSED) {
+        return FAILED;
+    }
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == 8 ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < 8; i++) {
+        cJSON* fileNameItem = cJSON_GetObjectItem(cJSON_GetArrayItem(logs, i), "FileName");
+        if (!cJSON_IsString(fileNameItem) || strcmp(fileNameItem->valuestring, i % 2 != 0 ? "second.c" : "first.c") != 0) {
+            ret = FAILED;
+        }
+    }
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @def ARENA_LOG_COUNT
+ *
+ * @brief The number of logs of test_cJSONLogger_arena_growth(), their messages fill several times the first block of the string arena.
+ */
+#define ARENA_LOG_COUNT 400
+
+/**
+ * @brief Build the message of a log of test_cJSONLogger_arena_growth(), of a varying length with or without characters to escape.
+ *
+ * @param index The index of the log.
+ * @param logMsg Where the message will be stored.
+ * @param size The size of logMsg.
+ */
+static void arenaMessage(int index, char* logMsg, size_t size)
+{
+    size_t length = 1 + (size_t)(index * 37) % 200;
+    length = length < size - 1 ? length : size - 1;
+
+    for (size_t i = 0; i < length; i++) {
+        logMsg[i] = (char)('a' + (index + (int)i) % 26);
+        if (index % 3 == 0 && i % 17 == 5) {
+            logMsg[i] = '\"';
+        }
+
+        else if (index % 5 == 0 && i % 23 == 7) {
+            logMsg[i] = '\n';
+        }
+    }
+    logMsg[length] = '\0';
+}
+
+/**
+ * @struct ArenaState
+ *
+ * @brief Messages received by the callback of test_cJSONLogger_arena_growth().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records whose message differs from the logged one.
+ */
+typedef struct ArenaState {
+    int records;
+    int badRecords;
+} ArenaState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_arena_growth(), compares the records with the logged messages.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The ArenaState_s of the test.
+ */
+static void arenaRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    ArenaState_s* state = (ArenaState_s*)userData;
+    char logMsg[256];
+
+    for (size_t i = 0; i < count; i++) {
+        arenaMessage(state->records++, logMsg, sizeof(logMsg));
+        if (strcmp(records[i].logMsg, logMsg) != 0) {
+            state->badRecords++;
+        }
+    }
+}
+
+/**
+ * @brief Test that the messages stay intact once the string arena grew past its first block, for the queries and the dump.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_arena_growth(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    char logMsg[256];
+    for (int i = 0; i < ARENA_LOG_COUNT; i++) {
+        arenaMessage(i, logMsg, sizeof(logMsg));
+        CJSON_LOG_INFO("%" JNO "%s", "foo", logMsg);
+    }
+
+    ArenaState_s state = { 0 };
+    const char* jsonPath[] = { "foo" };
+    if (cJSONLoggerTail(jsonPath, 1, 0, arenaRecords, &state) != ARENA_LOG_COUNT || state.records != ARENA_LOG_COUNT || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    cJSON* jsonLogsDoc = NULL;
+    if (dumpMatchesCJSONPrint(&jsonLogsDoc) != PASSED) {
+        return FAILED;
+    }
+
+    const cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == ARENA_LOG_COUNT ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < ARENA_LOG_COUNT; i++) {
+        const cJSON* message = cJSON_GetObjectItem(cJSON_GetArrayItem(logs, i), "Log");
+        arenaMessage(i, logMsg, sizeof(logMsg));
+        ret = cJSON_IsString(message) && strcmp(message->valuestring, logMsg) == 0 ? PASSED : FAILED;
+    }
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Test initializing the cJSON logger with a configuration and printing a large log tree on the worker pool.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_init_with_config(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.workerCpuList = "0-";
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.workerCpuList = "0";
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    const char* nodes[] = { "foo", "bar", "baz", "qux" };
+    for (int i = 0; i < 400; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "value %d", nodes[i % 4], nodes[(i / 4) % 4], i);
+    }
+
+    cJSONLoggerDump();
+
+    cJSON* jsonLogsDoc = NULL;
+    if (dumpMatchesCJSONPrint(&jsonLogsDoc) != PASSED) {
+        return FAILED;
+    }
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "qux"), "qux"), "logs")) == 25 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Test that a later initialization keeps the settings of the resources and dumps the JSON tree it drops.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_reinit(void)
+{
+    char shmName[MAX_STRING_LEN];
+    snprintf(shmName, sizeof(shmName), "/cjsonlogger_reinit_%d", (int)getpid());
+
+    char socketPath[MAX_STRING_LEN];
+    snprintf(socketPath, sizeof(socketPath), "cjsonlogger_test_%d.sock", (int)getpid());
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.shmName = shmName;
+    config.shmCapacity = 8;
+    config.workerThreads = 2;
+    config.flushIntervalMs = 1000;
+    config.socketPath = socketPath;
+    config.socketQueueCapacity = 16;
+    config.socketBatchSize = 4;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    shm_unlink(shmName);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "kept value", "foo");
+
+    // The resources keep their settings until the logger is destroyed.
+    config.shmCapacity = 16;
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+    config.shmCapacity = 8;
+
+    config.workerThreads = 3;
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+    config.workerThreads = 2;
+
+    config.flushIntervalMs = 2000;
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+    config.flushIntervalMs = 1000;
+
+    config.socketBatchSize = 8;
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+    config.socketBatchSize = 4;
+
+    // Without a file path the JSON tree is dropped, its logs are dumped first.
+    config.filePath = NULL;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    char* logData = readFile(LOG_FILE);
+    int ret = logData != NULL && strstr(logData, "kept value") != NULL ? PASSED : FAILED;
+    free(logData);
+
+    // The flight recorder needs a file path, it is created by the next initialization and keeps its settings as well.
+    config.filePath = LOG_FILE;
+    config.flightRecorderCapacity = 16;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    config.flightRecorderCapacity = 32;
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+    config.flightRecorderCapacity = 16;
+
+    return ret;
+}
+
+/**
+ * @brief Count the threads of the process running with a scheduling policy.
+ *
+ * @param policy The POSIX scheduling policy of the counted threads.
+ *
+ * @return int, the number of threads running with the policy, negative value if they can not be counted.
+ */
+static int countThreadsWithPolicy(int policy)
+{
+    DIR* dir = opendir("/proc/self/task");
+    if (dir == NULL) {
+        return -1;
+    }
+
+    int threads = 0;
+    for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+        if (entry->d_name[0] != '.' && sched_getscheduler((pid_t)atoi(entry->d_name)) == policy) {
+            threads++;
+        }
+    }
+    closedir(dir);
+
+    return threads;
+}
+
+/**
+ * @brief Test that the scheduling attributes of the logger threads are validated and applied.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_thread_attributes(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.workerNice = 20;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.workerNice = 0;
+    config.workerSchedPolicy = CJSON_LOGGER_SCHED_FIFO;
+    config.workerSchedPriority = 0;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.workerNice = 19;
+    config.workerSchedPolicy = CJSON_LOGGER_SCHED_BATCH;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // SCHED_BATCH is not a thread attribute, it is applied to the running workers.
+    if (countThreadsWithPolicy(SCHED_BATCH) != 2) {
+        return FAILED;
+    }
+
+    for (int i = 0; i < 600; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+    if (jsonLogsDoc == NULL) {
+        return FAILED;
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return PASSED;
+}
+
+/**
+ * @brief Remove the files of the current directory matching a pattern.
+ *
+ * @param pattern The fnmatch() pattern of the files.
+ *
+ * @return int, the number of removed files.
+ */
+static int removeMatchingFiles(const char* pattern)
+{
+    DIR* dir = opendir(".");
+    if (dir == NULL) {
+        return 0;
+    }
+
+    int removed = 0;
+    for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+        if (fnmatch(pattern, entry->d_name, 0) == 0 && remove(entry->d_name) == 0) {
+            removed++;
+        }
+    }
+    closedir(dir);
+
+    return removed;
+}
+
+/**
+ * @brief Count the lines of a file and remove it.
+ *
+ * @param filePath The path of the file.
+ *
+ * @return int, the number of lines, negative value if the file can not be read.
+ */
+static int countLinesAndRemove(const char* filePath)
+{
+    char* data = readFile(filePath);
+    remove(filePath);
+    if (data == NULL) {
+        return -1;
+    }
+
+    int lines = 0;
+    for (const char* c = data; *c != '\0'; c++) {
+        lines += *c == '\n' ? 1 : 0;
+    }
+    free(data);
+
+    return lines;
+}
+
+/**
+ * @brief Test that a child process forked after the initialization writes its own logs and sink records to pid suffixed files.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_fork_fresh(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.forkMode = CJSON_LOGGER_FORK_FRESH;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    char sinkFile[MAX_STRING_LEN];
+    snprintf(sinkFile, sizeof(sinkFile), "fork_%d.ndjson", (int)getpid());
+
+    // The sink rotates every 100 records and keeps a single rotated file.
+    CJSONLoggerSinkConfig_s sinkConfig;
+    cJSONLoggerGetDefaultSinkConfig(&sinkConfig);
+    sinkConfig.path = sinkFile;
+    sinkConfig.rotateRecords = 100;
+    sinkConfig.rotateFiles = 1;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "value %d", "parent", 1);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Enough logs over two nodes for the dump to run on the recreated worker pool.
+        for (int i = 0; i < 300; i++) {
+            CJSON_LOG_INFO("%" JNO "value %d", i % 2 == 0 ? "foo" : "bar", i);
+        }
+
+        cJSONLoggerDump();
+        _exit(0);
+    }
+
+    int childExitStatus;
+    if (pid < 0 || waitpid(pid, &childExitStatus, 0) != pid || !WIFEXITED(childExitStatus) || WEXITSTATUS(childExitStatus) != 0) {
+        return FAILED;
+    }
+
+    char childLogFile[MAX_STRING_LEN];
+    snprintf(childLogFile, sizeof(childLogFile), "log.%d.json", (int)pid);
+
+    char* logData = readFile(childLogFile);
+    remove(childLogFile);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+    if (jsonLogsDoc == NULL) {
+        return FAILED;
+    }
+
+    int ret = PASSED;
+    if (cJSON_GetObjectItem(jsonLogsDoc, "parent") != NULL || cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) != 150) {
+        ret = FAILED;
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    // The child rotated its own sink file twice and removed its own oldest rotated file, the file of the parent is untouched.
+    char childSinkFile[MAX_STRING_LEN];
+    snprintf(childSinkFile, sizeof(childSinkFile), "fork_%d.%d.ndjson", (int)getpid(), (int)pid);
+    char rotatedPattern[MAX_STRING_LEN];
+    snprintf(rotatedPattern, sizeof(rotatedPattern), "*_%s", childSinkFile);
+
+    if (countLinesAndRemove(childSinkFile) != 100 || removeMatchingFiles(rotatedPattern) != 1) {
+        ret = FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    snprintf(rotatedPattern, sizeof(rotatedPattern), "*_%s", sinkFile);
+    if (countLinesAndRemove(sinkFile) != 1 || removeMatchingFiles(rotatedPattern) != 0) {
+        ret = FAILED;
+    }
+
+    logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+    if (jsonLogsDoc == NULL) {
+        return FAILED;
+    }
+
+    if (cJSON_GetObjectItem(jsonLogsDoc, "parent") == NULL || cJSON_GetObjectItem(jsonLogsDoc, "foo") != NULL) {
+        ret = FAILED;
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the records are written to the shared memory ring when no output file is configured.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_shm_sink(void)
+{
+    char shmName[MAX_STRING_LEN];
+    snprintf(shmName, sizeof(shmName), "/cjsonlogger_test_%d", (int)getpid());
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = NULL;
+    config.shmName = shmName;
+    config.shmCapacity = 6;
+    config.timeFormat = CJSON_LOGGER_TIME_RFC3339_UTC;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.shmCapacity = 8;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 0; i < 10; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "value %d", "foo", "bar", i);
+    }
+
+    int fd = shm_open(shmName, O_RDWR, 0);
+    shm_unlink(shmName);
+    if (fd == -1) {
+        return FAILED;
+    }
+
+    size_t size = shmRingSize(8);
+    ShmRingHeader_s* header = (ShmRingHeader_s*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        return FAILED;
+    }
+
+    // The collector prints the time stamps in the format published by the logger.
+    int ret = shmRingIsValid(header, size) && atomic_load(&header->dropped) == 2 && atomic_load(&header->timeFormat) == CJSON_LOGGER_TIME_RFC3339_UTC
+        ? PASSED
+        : FAILED;
+
+    // The ring is full, the last two records were dropped.
+    for (int i = 0; i < 8 && ret == PASSED; i++) {
+        char expectedMsg[MAX_STRING_LEN];
+        snprintf(expectedMsg, sizeof(expectedMsg), "value %d", i);
+
+        uint64_t pos = 0;
+        ShmRingSlot_s* slot = shmRingTake(header, &pos);
+        if (slot == NULL
+            || slot->pathDepth != 2
+            || slot->logLevel != CJSON_LOG_LEVEL_INFO
+            || strcmp(slot->data, "foo") != 0
+            || strcmp(slot->data + 4, "bar") != 0
+            || strcmp(shmRingSlotLogMsg(slot), expectedMsg) != 0) {
+            ret = FAILED;
+        }
+
+        else {
+            shmRingRelease(header, slot, pos);
+        }
+    }
+
+    uint64_t pos = 0;
+    if (ret == PASSED && shmRingTake(header, &pos) != NULL) {
+        ret = FAILED;
+    }
+
+    munmap(header, size);
+
+    return ret;
+}
+
+/**
+ * @brief Test that a ring blocked by a slot its producer never committed is skipped by the consumer and not reused by the logger.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_shm_sink_abandoned_slot(void)
+{
+    char shmName[MAX_STRING_LEN];
+    snprintf(shmName, sizeof(shmName), "/cjsonlogger_test_%d", (int)getpid());
+
+    int fd = shm_open(shmName, O_RDWR | O_CREAT, 0666);
+    if (fd == -1) {
+        return FAILED;
+    }
+
+    size_t size = shmRingSize(8);
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(shmName);
+        return FAILED;
+    }
+
+    ShmRingHeader_s* header = (ShmRingHeader_s*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        shm_unlink(shmName);
+        return FAILED;
+    }
+
+    // A producer dies between reserving its slot and committing it, the record behind it can not be taken.
+    shmRingInit(header, 8);
+
+    uint64_t pos = 0;
+    int ret = shmRingReserve(header, &pos) != NULL ? PASSED : FAILED;
+    const char* jsonPath[] = { "foo" };
+    if (ret == PASSED && shmRingWrite(header, jsonPath, 1, 0, CJSON_LOG_LEVEL_INFO, NULL, NULL, 0, "behind", 0, 0) != 0) {
+        ret = FAILED;
+    }
+
+    uint64_t blockedPos = 1;
+    if (ret == PASSED && (shmRingTake(header, &pos) != NULL || shmRingUncommitted(header, &blockedPos) != 1 || blockedPos != 0)) {
+        ret = FAILED;
+    }
+
+    // The consumer skips the abandoned slot and takes the record behind it.
+    ShmRingSlot_s* slot = NULL;
+    if (ret == PASSED && (shmRingSkip(header, blockedPos) != 1 || (slot = shmRingTake(header, &pos)) == NULL || strcmp(shmRingSlotLogMsg(slot), "behind") != 0)) {
+        ret = FAILED;
+    }
+
+    if (slot != NULL) {
+        shmRingRelease(header, slot, pos);
+    }
+
+    // A ring left blocked by a previous run is initialized again instead of being reused.
+    if (ret == PASSED && shmRingReserve(header, &pos) == NULL) {
+        ret = FAILED;
+    }
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = NULL;
+    config.shmName = shmName;
+    config.shmCapacity = 8;
+
+    if (ret == PASSED) {
+        int res = cJSONLoggerInitWithConfig(&config);
+        assert(res == 0);
+
+        CJSON_LOG_INFO("%" JNO "value", "foo");
+
+        slot = shmRingTake(header, &pos);
+        if (slot == NULL || strcmp(shmRingSlotLogMsg(slot), "value") != 0) {
+            ret = FAILED;
+        }
+    }
+
+    munmap(header, size);
+    shm_unlink(shmName);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the records are sent in order to the socket sink when no output file is configured.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_socket_sink(void)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "cjsonlogger_test_%d.sock", (int)getpid());
+
+    int listenFd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    assert(listenFd != -1);
+
+    unlink(addr.sun_path);
+    if (bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 1) != 0) {
+        return FAILED;
+    }
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = NULL;
+    config.socketPath = addr.sun_path;
+    config.socketQueueCapacity = 12;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.socketQueueCapacity = 16;
+    config.socketBatchSize = 4;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // Initializing again keeps the socket sink instead of adding a second one.
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 0; i < 10; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "value %d", "foo", "bar", i);
+    }
+
+    // The last records do not fill a batch, they are sent by the dump.
+    cJSONLoggerDump();
+
+    int clientFd = accept(listenFd, NULL, NULL);
+    struct pollfd listenPfd = { listenFd, POLLIN, 0 };
+    int pendingConnections = poll(&listenPfd, 1, 0);
+    unlink(addr.sun_path);
+    close(listenFd);
+    if (clientFd == -1 || pendingConnections != 0) {
+        if (clientFd != -1) {
+            close(clientFd);
+        }
+        return FAILED;
+    }
+
+    char received[4096] = { 0 };
+    size_t receivedLen = 0;
+    int lines = 0;
+    while (lines < 10 && receivedLen < sizeof(received) - 1) {
+        struct pollfd pfd = { clientFd, POLLIN, 0 };
+        if (poll(&pfd, 1, 5000) <= 0) {
+            break;
+        }
+
+        ssize_t len = recv(clientFd, received + receivedLen, sizeof(received) - 1 - receivedLen, 0);
+        if (len <= 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < len; i++) {
+            lines += received[receivedLen + (size_t)i] == '\n';
+        }
+        receivedLen += (size_t)len;
+    }
+
+    close(clientFd);
+
+    if (lines != 10) {
+        return FAILED;
+    }
+
+    const char* line = received;
+    for (int i = 0; i < 10; i++) {
+        char expectedMsg[MAX_STRING_LEN];
+        snprintf(expectedMsg, sizeof(expectedMsg), "\"Log\":\"value %d\",\"Path\":[\"foo\",\"bar\"]}\n", i);
+
+        const char* lineEnd = strchr(line, '\n');
+        if (strncmp(line, "{\"Time\":", strlen("{\"Time\":")) != 0
+            || strstr(line, "\"LogLevel\":\"INFO\",") == NULL
+            || strncmp(lineEnd + 1 - strlen(expectedMsg), expectedMsg, strlen(expectedMsg)) != 0) {
+            return FAILED;
+        }
+
+        line = lineEnd + 1;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Test that the socket sink sends its queued records once a receiver started after the queue filled up.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_socket_sink_late_receiver(void)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "cjsonlogger_test_%d.sock", (int)getpid());
+    unlink(addr.sun_path);
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = NULL;
+    config.socketPath = addr.sun_path;
+    config.socketQueueCapacity = 16;
+    config.socketBatchSize = 4;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // Nothing listens yet, the queue keeps the first 16 records and drops the rest.
+    for (int i = 0; i < 40; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    // The drains scheduled by the writes and the one of the dump fail while the receiver is down.
+    usleep(100000);
+    cJSONLoggerDump();
+
+    int listenFd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    assert(listenFd != -1);
+
+    if (bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 1) != 0) {
+        return FAILED;
+    }
+
+    // Once the failed drain backed off, a write to the full queue schedules it again, no dump is needed.
+    usleep(300000);
+    CJSON_LOG_INFO("%" JNO "dropped", "foo");
+
+    struct pollfd listenPfd = { listenFd, POLLIN, 0 };
+    int clientFd = poll(&listenPfd, 1, 5000) == 1 ? accept(listenFd, NULL, NULL) : -1;
+    unlink(addr.sun_path);
+    close(listenFd);
+    if (clientFd == -1) {
+        return FAILED;
+    }
+
+    char received[4096] = { 0 };
+    size_t receivedLen = 0;
+    int lines = 0;
+    while (lines < 16 && receivedLen < sizeof(received) - 1) {
+        struct pollfd pfd = { clientFd, POLLIN, 0 };
+        if (poll(&pfd, 1, 5000) <= 0) {
+            break;
+        }
+
+        ssize_t len = recv(clientFd, received + receivedLen, sizeof(received) - 1 - receivedLen, 0);
+        if (len <= 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < len; i++) {
+            lines += received[receivedLen + (size_t)i] == '\n';
+        }
+        receivedLen += (size_t)len;
+    }
+
+    close(clientFd);
+
+    if (lines != 16 || strstr(received, "\"Log\":\"value 0\"") == NULL || strstr(received, "\"Log\":\"value 15\"") == NULL
+        || strstr(received, "\"Log\":\"value 16\"") != NULL) {
+        return FAILED;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Test that the records are fanned out to the sinks according to the log level of each sink.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_sinks(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    CJSONLoggerSinkConfig_s sinkConfig;
+    cJSONLoggerGetDefaultSinkConfig(&sinkConfig);
+
+    if (cJSONLoggerAddSink(&sinkConfig) == 0) {
+        return FAILED;
+    }
+
+    char warnSinkFile[MAX_STRING_LEN];
+    snprintf(warnSinkFile, sizeof(warnSinkFile), "warn_%d.ndjson", (int)getpid());
+    char debugSinkFile[MAX_STRING_LEN];
+    snprintf(debugSinkFile, sizeof(debugSinkFile), "debug_%d.ndjson", (int)getpid());
+
+    sinkConfig.path = warnSinkFile;
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_WARN;
+    sinkConfig.queueCapacity = 3;
+
+    if (cJSONLoggerAddSink(&sinkConfig) == 0) {
+        return FAILED;
+    }
+
+    sinkConfig.queueCapacity = 4;
+    sinkConfig.batchSize = 2;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    sinkConfig.path = debugSinkFile;
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_DEBUG;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "info", "foo");
+    CJSON_LOG_WARN("%" JNO "warn", "foo");
+    CJSON_LOG_DEBUG("%" JNO "debug", "foo");
+
+    cJSONLoggerDump();
+
+    int expectedLines[] = { 1, 3 };
+    const char* sinkFiles[] = { warnSinkFile, debugSinkFile };
+    for (int i = 0; i < 2; i++) {
+        char* sinkData = readFile(sinkFiles[i]);
+        remove(sinkFiles[i]);
+        if (sinkData == NULL) {
+            return FAILED;
+        }
+
+        int lines = 0;
+        char* savePtr = NULL;
+        for (char* line = strtok_r(sinkData, "\n", &savePtr); line != NULL; line = strtok_r(NULL, "\n", &savePtr)) {
+            cJSON* record = cJSON_Parse(line);
+            cJSON* path = cJSON_GetObjectItem(record, "Path");
+            if (record == NULL || cJSON_GetArraySize(path) != 1 || strcmp(cJSON_GetArrayItem(path, 0)->valuestring, "foo") != 0) {
+                cJSON_Delete(record);
+                free(sinkData);
+                return FAILED;
+            }
+
+            // The first record of the WARN sink is the WARN log.
+            if (lines == 0 && i == 0 && strcmp(cJSON_GetObjectItem(record, "Log")->valuestring, "warn") != 0) {
+                cJSON_Delete(record);
+                free(sinkData);
+                return FAILED;
+            }
+
+            cJSON_Delete(record);
+            lines++;
+        }
+
+        free(sinkData);
+        if (lines != expectedLines[i]) {
+            return FAILED;
+        }
+    }
+
+    // The JSON tree keeps the level of the logger.
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+    if (jsonLogsDoc == NULL) {
+        return FAILED;
+    }
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) == 2 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @struct CallbackSinkState
+ *
+ * @brief Records observed by the callback of test_cJSONLogger_callback_sink().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records received out of order or with unexpected fields.
+ */
+typedef struct CallbackSinkState {
+    int records;
+    int badRecords;
+} CallbackSinkState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_callback_sink(), checks the records arrive in logging order.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The CallbackSinkState_s of the test.
+ */
+static void callbackSinkRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    CallbackSinkState_s* state = (CallbackSinkState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        char expectedMsg[MAX_STRING_LEN];
+        snprintf(expectedMsg, sizeof(expectedMsg), "value %d", state->records);
+
+        if (records[i].jsonPathDepth != 2
+            || strcmp(records[i].jsonPath[0], "foo") != 0
+            || strcmp(records[i].jsonPath[1], "bar") != 0
+            || records[i].logLevel != CJSON_LOG_LEVEL_WARN
+            || records[i].fileName == NULL
+            || strcmp(records[i].fileName, "test.c") != 0
+            || records[i].fileLine <= 0
+            || strcmp(records[i].logMsg, expectedMsg) != 0) {
+            state->badRecords++;
+        }
+
+        state->records++;
+    }
+}
+
+/**
+ * @brief Test that a callback sink receives every record in a structured form.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_callback_sink(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    CallbackSinkState_s state = { 0 };
+
+    CJSONLoggerSinkConfig_s sinkConfig;
+    cJSONLoggerGetDefaultSinkConfig(&sinkConfig);
+    sinkConfig.type = CJSON_LOGGER_SINK_CALLBACK;
+
+    if (cJSONLoggerAddSink(&sinkConfig) == 0) {
+        return FAILED;
+    }
+
+    sinkConfig.callback = callbackSinkRecords;
+    sinkConfig.userData = &state;
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_WARN;
+    sinkConfig.batchSize = 4;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    for (int i = 0; i < 10; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "info %d", "foo", "bar", i);
+        CJSON_LOG_WARN("%" JNO "%" JNO "value %d", "foo", "bar", i);
+    }
+
+    // The full batches were handed to the worker threads, the dump hands over the rest.
+    cJSONLoggerDump();
+
+    return state.records == 10 && state.badRecords == 0 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Records observed by the callback of test_cJSONLogger_query().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records received under another node or below the queried log level.
+ * @var lastValue The value of the last record received.
+ */
+typedef struct QueryState {
+    int records;
+    int badRecords;
+    int lastValue;
+} QueryState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_query(), checks the records are errors under the foo node.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The QueryState_s of the test.
+ */
+static void queryRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    QueryState_s* state = (QueryState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].jsonPathDepth != 2
+            || strcmp(records[i].jsonPath[0], "foo") != 0
+            || strcmp(records[i].jsonPath[1], "baz") != 0
+            || records[i].logLevel > CJSON_LOG_LEVEL_ERROR
+            || sscanf(records[i].logMsg, "error %d", &state->lastValue) != 1) {
+            state->badRecords++;
+        }
+
+        state->records++;
+    }
+}
+
+/**
+ * @brief Test that the logs held in memory can be queried by path prefix, log level, call site and time range.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_query(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_DEBUG, LOG_FILE);
+    assert(res == 0);
+
+    struct timespec ts;
+    int64_t middleTimeStamp = 0;
+    int errorLine = 0;
+
+    for (int i = 0; i < 200; i++) {
+        if (i == 100) {
+            clock_gettime(CLOCK_REALTIME, &ts);
+            middleTimeStamp = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+        }
+
+        CJSON_LOG_DEBUG("%" JNO "%" JNO "debug %d", "foo", "bar", i);
+        CJSON_LOG_WARN("%" JNO "warn %d", "qux", i);
+        if (i % 20 == 0) {
+            errorLine = __LINE__ + 1;
+            CJSON_LOG_ERROR("%" JNO "%" JNO "error %d", "foo", "baz", i);
+        }
+    }
+
+    QueryState_s state = { 0 };
+    const char* jsonPath[] = { "FOO" };
+
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    query.logLevel = __CJSON_LOG_LEVEL_END;
+    if (cJSONLoggerQuery(&query, queryRecords, &state) >= 0) {
+        return FAILED;
+    }
+
+    query.jsonPath = jsonPath;
+    query.jsonPathDepth = 1;
+    query.logLevel = CJSON_LOG_LEVEL_ERROR;
+    if (cJSONLoggerQuery(&query, queryRecords, &state) != 10 || state.records != 10 || state.badRecords != 0 || state.lastValue != 180) {
+        return FAILED;
+    }
+
+    memset(&state, 0, sizeof(state));
+    query.fromTimeStamp = middleTimeStamp;
+    query.fileName = "test.c";
+    query.fileLine = errorLine;
+    if (cJSONLoggerQuery(&query, queryRecords, &state) != 5 || state.records != 5 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    memset(&state, 0, sizeof(state));
+    query.maxRecords = 2;
+    if (cJSONLoggerQuery(&query, queryRecords, &state) != 2 || state.records != 2 || state.lastValue != 120) {
+        return FAILED;
+    }
+
+    memset(&state, 0, sizeof(state));
+    query.fileLine = errorLine + 1;
+    if (cJSONLoggerQuery(&query, queryRecords, &state) != 0 || state.records != 0) {
+        return FAILED;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Records observed by the callback of test_cJSONLogger_query_reentrant().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records received under another node, or of nested calls that failed.
+ * @var nestedRecords Number of records received by the nested queries.
+ */
+typedef struct ReentrantState {
+    int records;
+    int badRecords;
+    int nestedRecords;
+} ReentrantState_s;
+
+/**
+ * @brief Callback of the nested queries of test_cJSONLogger_query_reentrant(), counts the records.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The ReentrantState_s of the test.
+ */
+static void nestedRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    (void)records;
+    ((ReentrantState_s*)userData)->nestedRecords += (int)count;
+}
+
+/**
+ * @brief Callback of test_cJSONLogger_query_reentrant(), logs every record again under the bar node, then queries, tails and dumps the logs.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The ReentrantState_s of the test.
+ */
+static void reentrantRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    ReentrantState_s* state = (ReentrantState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].jsonPathDepth != 1 || strcmp(records[i].jsonPath[0], "foo") != 0 || strncmp(records[i].logMsg, "value ", 6) != 0) {
+            state->badRecords++;
+        }
+
+        CJSON_LOG_INFO("%" JNO "copy of %s", "bar", records[i].logMsg);
+        state->records++;
+    }
+
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    if (cJSONLoggerQuery(&query, nestedRecords, state) < 0) {
+        state->badRecords++;
+    }
+
+    const char* jsonPath[] = { "bar" };
+    if (cJSONLoggerTail(jsonPath, 1, 1, nestedRecords, state) != 1) {
+        state->badRecords++;
+    }
+
+    cJSONLoggerDump();
+}
+
+/**
+ * @brief Test that the callbacks of a query and of a tail can call the cJSON logger API, the records are copied before they run.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_query_reentrant(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    for (int i = 0; i < 100; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    ReentrantState_s state = { 0 };
+    const char* jsonPath[] = { "foo" };
+
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    query.jsonPath = jsonPath;
+    query.jsonPathDepth = 1;
+
+    // A callback running while the logs are locked would deadlock, the alarm ends the test instead.
+    alarm(10);
+    res = cJSONLoggerQuery(&query, reentrantRecords, &state);
+    alarm(0);
+
+    if (res != 100 || state.records != 100 || state.badRecords != 0 || state.nestedRecords < 100) {
+        return FAILED;
+    }
+
+    // Every record was logged again by the callback, the dump of its last call holds them all.
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "bar"), "logs")) == 100 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    // The tail hands over the same records, logged again once more.
+    memset(&state, 0, sizeof(state));
+    alarm(10);
+    res = cJSONLoggerTail(jsonPath, 1, 0, reentrantRecords, &state);
+    alarm(0);
+
+    if (res != 100 || state.records != 100 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief The number of blocks of the index of test_cJSONLogger_log_index().
+ */
+#define LOG_INDEX_TEST_BLOCKS 100
+
+/**
+ * @brief Walk the blocks of an index of test_cJSONLogger_log_index() that may hold logs of a query.
+ *
+ * @param index The index to walk.
+ * @param logLevelMask Bit (log level) set for every log level of the query.
+ * @param fromTimeStamp The oldest time stamp of the query.
+ * @param blocks Where the positions of the walked blocks will be stored, LOG_INDEX_TEST_BLOCKS entries.
+ *
+ * @return int, the number of walked blocks.
+ */
+static int logIndexWalk(const LogIndex_s* index, uint8_t logLevelMask, int64_t fromTimeStamp, unsigned int* blocks)
+{
+    LogIndexCursor_s cursor;
+    logIndexCursorInit(&cursor, index, LOG_INDEX_TEST_BLOCKS, logLevelMask, fromTimeStamp);
+
+    int blockCount = 0;
+    unsigned int block;
+    while (blockCount < LOG_INDEX_TEST_BLOCKS && logIndexCursorNext(&cursor, &block) != 0) {
+        blocks[blockCount++] = block;
+    }
+
+    return blockCount;
+}
+
+/**
+ * @brief Test that the index of the logs of a node starts a query at its time range and skips the blocks without its log levels.
+ *
+ * @return int, PASSED in case of success, FAILED in case of failure.
+ */
+static int test_cJSONLogger_log_index(void)
+{
+    LogIndex_s index = { 0 };
+    unsigned int logCapacity = 0;
+
+    // Debug logs ten nanoseconds apart, errors only in the blocks 10 and 90, block 20 holds a log as late as block 30.
+    for (unsigned int i = 0; i < LOG_INDEX_TEST_BLOCKS * LOG_BLOCK_LEN; i++) {
+        if (i == logCapacity) {
+            logCapacity = logCapacity == 0 ? LOG_BLOCK_LEN : logCapacity * 2;
+            if (logIndexReserve(&index, logCapacity, 1) != 0) {
+                logIndexFree(&index);
+                return FAILED;
+            }
+        }
+
+        int64_t timeStamp = i == 20 * LOG_BLOCK_LEN + 1 ? 30 * LOG_BLOCK_LEN * 10 : (int64_t)i * 10;
+        unsigned int logLevel = i == 10 * LOG_BLOCK_LEN + 5 || i == 90 * LOG_BLOCK_LEN + 63 ? CJSON_LOG_LEVEL_ERROR : CJSON_LOG_LEVEL_DEBUG;
+        logIndexAdd(&index, i, timeStamp, 0, logLevel, i % LOG_BLOCK_LEN == 0);
+    }
+
+    unsigned int blocks[LOG_INDEX_TEST_BLOCKS];
+    int ret = PASSED;
+
+    // The recent errors only visit the blocks holding errors.
+    int blockCount = logIndexWalk(&index, logLevelMaskBit(CJSON_LOG_LEVEL_ERROR), INT64_MIN, blocks);
+    if (blockCount != 2 || blocks[0] != 10 || blocks[1] != 90) {
+        ret = FAILED;
+    }
+
+    blockCount = logIndexWalk(&index, logLevelMaskBit(CJSON_LOG_LEVEL_ERROR), 50 * LOG_BLOCK_LEN * 10, blocks);
+    if (blockCount != 1 || blocks[0] != 90) {
+        ret = FAILED;
+    }
+
+    // Every log level walks every block from the first one that may reach the time range, the late log of block 20 included.
+    blockCount = logIndexWalk(&index, 0xFF, 25 * LOG_BLOCK_LEN * 10, blocks);
+    if (blockCount != LOG_INDEX_TEST_BLOCKS - 20 || blocks[0] != 20 || blocks[blockCount - 1] != LOG_INDEX_TEST_BLOCKS - 1) {
+        ret = FAILED;
+    }
+
+    blockCount = logIndexWalk(&index, 0xFF, LOG_INDEX_TEST_BLOCKS * LOG_BLOCK_LEN * 10, blocks);
+    if (blockCount != 0) {
+        ret = FAILED;
+    }
+
+    logIndexFree(&index);
+    return ret;
+}
+
+/**
+ * @brief Records observed by the callback of test_cJSONLogger_tail().
+ *
+ * @var records Number of records received.
+ * @var badRecords Number of records received out of order or under another node.
+ * @var nextValue The value expected in the next record.
+ */
+typedef struct TailState {
+    int records;
+    int badRecords;
+    int nextValue;
+} TailState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_tail(), checks the records are consecutive values under the foo/bar node.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The TailState_s of the test.
+ */
+static void tailRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    TailState_s* state = (TailState_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        char expectedMsg[MAX_STRING_LEN];
+        snprintf(expectedMsg, sizeof(expectedMsg), "value %d", state->nextValue++);
+
+        if (records[i].jsonPathDepth != 2
+            || strcmp(records[i].jsonPath[0], "foo") != 0
+            || strcmp(records[i].jsonPath[1], "bar") != 0
+            || strcmp(records[i].logMsg, expectedMsg) != 0) {
+            state->badRecords++;
+        }
+
+        state->records++;
+    }
+}
+
+/**
+ * @brief Test that a capped node keeps its most recent records without rotating the logs and that they can be read back.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_tail(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    const char* jsonPath[] = { "foo", "bar" };
+
+    for (int i = 0; i < 20; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "value %d", "foo", "bar", i);
+    }
+
+    // The oldest records above the capacity are dropped.
+    res = cJSONLoggerSetNodeCapacity(jsonPath, 2, 8);
+    assert(res == 0);
+
+    TailState_s state = { .nextValue = 12 };
+    if (cJSONLoggerTail(jsonPath, 2, 0, tailRecords, &state) != 8 || state.records != 8 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    res = cJSONLoggerSetNodeCapacity(jsonPath, 2, 50);
+    assert(res == 0);
+
+    // More records than MAX_LOG_COUNT, the capped node must not trigger a rotation.
+    for (int i = 20; i < 600; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "value %d", "foo", "bar", i);
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.nextValue = 590;
+    if (cJSONLoggerTail(jsonPath, 2, 10, tailRecords, &state) != 10 || state.records != 10 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.nextValue = 550;
+
+    CJSONLoggerQuery_s query;
+    cJSONLoggerGetDefaultQuery(&query);
+    if (cJSONLoggerQuery(&query, tailRecords, &state) != 50 || state.records != 50 || state.badRecords != 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* loggedJson = cJSON_Parse(logData);
+    free(logData);
+    logData = NULL;
+
+    if (loggedJson == NULL) {
+        return FAILED;
+    }
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(cJSON_GetObjectItem(loggedJson, "foo"), "bar"), "logs");
+    cJSON* firstLog = cJSON_GetObjectItem(cJSON_GetArrayItem(logs, 0), "Log");
+    if (cJSON_GetArraySize(logs) != 50 || !cJSON_IsString(firstLog) || strcmp(firstLog->valuestring, "value 550") != 0) {
+        RELEASE_RESOURCE_AND_RETURN_FAIL(loggedJson, cJSON_Delete);
+    }
+
+    cJSON_Delete(loggedJson);
+
+    return PASSED;
+}
+
+/**
+ * @brief Callback of test_cJSONLogger_flight_recorder(), collects the messages of the records.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData Array of MAX_STRING_LEN long messages, filled in order.
+ */
+static void flightRecorderRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    char(*messages)[MAX_STRING_LEN] = (char(*)[MAX_STRING_LEN])userData;
+
+    for (size_t i = 0; i < count; i++) {
+        snprintf(messages[i], MAX_STRING_LEN, "%s", records[i].logMsg);
+    }
+}
+
+/**
+ * @brief Test that the flight recorder keeps the records away from the JSON tree until a trigger persists the surrounding window.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_flight_recorder(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.logLevel = CJSON_LOG_LEVEL_DEBUG;
+    config.flightRecorderCapacity = 16;
+    config.flightRecorderPostRecords = 4;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.filePath = LOG_FILE;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    const char* jsonPath[] = { "foo" };
+    static char messages[64][MAX_STRING_LEN];
+
+    for (int i = 0; i < 40; i++) {
+        CJSON_LOG_DEBUG("%" JNO "debug %d", "foo", i);
+    }
+
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecords, messages) != 0) {
+        return FAILED;
+    }
+
+    // The error persists the 16 most recent records before it.
+    CJSON_LOG_ERROR("%" JNO "error", "foo");
+
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecords, messages) != 17
+        || strcmp(messages[0], "debug 24") != 0
+        || strcmp(messages[15], "debug 39") != 0
+        || strcmp(messages[16], "error") != 0) {
+        return FAILED;
+    }
+
+    // The records following the error are written straight to the tree, then kept again.
+    for (int i = 40; i < 50; i++) {
+        CJSON_LOG_DEBUG("%" JNO "debug %d", "foo", i);
+    }
+
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecords, messages) != 21 || strcmp(messages[20], "debug 43") != 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerFlightRecorderTrigger();
+
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecords, messages) != 27 || strcmp(messages[26], "debug 49") != 0) {
+        return FAILED;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Callback of test_cJSONLogger_flight_recorder_truncate(), collects the message lengths of the records.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData Array of message lengths, filled in order.
+ */
+static void flightRecorderRecordLengths(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    size_t* lengths = (size_t*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = strlen(records[i].logMsg);
+    }
+}
+
+/**
+ * @brief Callback of test_cJSONLogger_flight_recorder_truncate(), counts the records logged from the fr.c:frFunc call site.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The int counting the records.
+ */
+static void flightRecorderRecordCallSites(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    int* callSiteRecords = (int*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].fileName != NULL && strcmp(records[i].fileName, "fr.c") == 0 && records[i].funcName != NULL && strcmp(records[i].funcName, "frFunc") == 0) {
+            (*callSiteRecords)++;
+        }
+    }
+}
+
+/**
+ * @brief Test that the flight recorder truncates the messages too long for its records instead of writing them to the JSON tree,
+ * and keeps copies of the call site names.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_flight_recorder_truncate(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.flightRecorderCapacity = 16;
+    config.flightRecorderPostRecords = 0;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // A record holds 480 bytes of node names, call site names and message, the longest node name leaves no room at all.
+    static char longName[300 + 1];
+    static char longestName[470 + 1];
+    static char longMsg[200 + 1];
+    memset(longName, 'n', sizeof(longName) - 1);
+    memset(longestName, 'n', sizeof(longestName) - 1);
+    memset(longMsg, 'm', sizeof(longMsg) - 1);
+
+    // The node name and the call site names leave 166 bytes to the message, it is cut in the middle of a 2 byte UTF-8
+    // character and the whole character is dropped.
+    longMsg[165] = (char)0xC3;
+    longMsg[166] = (char)0xA9;
+
+    // The call site names are formatted into buffers overwritten before the trigger replays the records.
+    char fileName[MAX_STRING_LEN];
+    char funcName[MAX_STRING_LEN];
+    snprintf(fileName, sizeof(fileName), "%s", "fr.c");
+    snprintf(funcName, sizeof(funcName), "%s", "frFunc");
+
+    cJSONLoggerLog(CJSON_LOG_LEVEL_INFO, "$$%s$$%s$$%d$$%" JNO "%s", fileName, funcName, 1, longName, longMsg);
+    cJSONLoggerLog(CJSON_LOG_LEVEL_INFO, "$$%s$$%s$$%d$$%" JNO "%s", fileName, funcName, 2, longestName, "dropped");
+
+    memset(fileName, 'x', sizeof(fileName) - 1);
+    memset(funcName, 'x', sizeof(funcName) - 1);
+
+    const char* jsonPath[] = { longName };
+    const char* longestPath[] = { longestName };
+    size_t lengths[4] = { 0 };
+
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecordLengths, lengths) != 0
+        || cJSONLoggerTail(longestPath, 1, 0, flightRecorderRecordLengths, lengths) != 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerFlightRecorderTrigger();
+
+    int callSiteRecords = 0;
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecordLengths, lengths) != 1
+        || lengths[0] != 165
+        || cJSONLoggerTail(longestPath, 1, 0, flightRecorderRecordLengths, lengths) != 0
+        || cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecordCallSites, &callSiteRecords) != 1
+        || callSiteRecords != 1) {
+        return FAILED;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Test that sinks split the records per log level with independent rotation and retention of their files.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_split_sinks(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_DEBUG, LOG_FILE);
+    assert(res == 0);
+
+    char criticalSinkFile[MAX_STRING_LEN];
+    snprintf(criticalSinkFile, sizeof(criticalSinkFile), "critical_%d.ndjson", (int)getpid());
+    char debugSinkFile[MAX_STRING_LEN];
+    snprintf(debugSinkFile, sizeof(debugSinkFile), "debug_%d.ndjson", (int)getpid());
+
+    CJSONLoggerSinkConfig_s sinkConfig;
+    cJSONLoggerGetDefaultSinkConfig(&sinkConfig);
+
+    // An empty severity range is rejected.
+    sinkConfig.path = debugSinkFile;
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_WARN;
+    sinkConfig.mostSevereLogLevel = CJSON_LOG_LEVEL_DEBUG;
+
+    if (cJSONLoggerAddSink(&sinkConfig) == 0) {
+        return FAILED;
+    }
+
+    // The debug records rotate every 4 records and only the 2 newest rotated files are kept.
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_DEBUG;
+    sinkConfig.rotateRecords = 4;
+    sinkConfig.rotateFiles = 2;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    cJSONLoggerGetDefaultSinkConfig(&sinkConfig);
+    sinkConfig.path = criticalSinkFile;
+    sinkConfig.logLevel = CJSON_LOG_LEVEL_CRITICAL;
+
+    res = cJSONLoggerAddSink(&sinkConfig);
+    assert(res == 0);
+
+    for (int i = 0; i < 14; i++) {
+        CJSON_LOG_DEBUG("%" JNO "debug %d", "foo", i);
+    }
+    CJSON_LOG_WARN("%" JNO "warn", "foo");
+    CJSON_LOG_CRITICAL("%" JNO "critical", "foo");
+
+    cJSONLoggerDump();
+
+    // 14 debug records, 3 rotations, the current file holds the last 2 records.
+    char rotatedPattern[MAX_STRING_LEN];
+    snprintf(rotatedPattern, sizeof(rotatedPattern), "*_%s", debugSinkFile);
+
+    int debugLines = countLinesAndRemove(debugSinkFile);
+    int criticalLines = countLinesAndRemove(criticalSinkFile);
+    int rotatedFiles = removeMatchingFiles(rotatedPattern);
+
+    return debugLines == 2 && criticalLines == 1 && rotatedFiles == 2 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Write a string to a file.
+ *
+ * @param filePath The path of the file.
+ * @param data The string to write.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int writeFile(const char* filePath, const char* data)
+{
+    FILE* file = fopen(filePath, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int res = fputs(data, file) >= 0 ? 0 : -1;
+    fclose(file);
+
+    return res;
+}
+
+/**
+ * @brief Test the initialization from a configuration file overridden by the environment, with a periodic flush.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_init_from_file(void)
+{
+    char configFile[MAX_STRING_LEN];
+    snprintf(configFile, sizeof(configFile), "config_%d.json", (int)getpid());
+    char sinkFile[MAX_STRING_LEN];
+    snprintf(sinkFile, sizeof(sinkFile), "config_%d.ndjson", (int)getpid());
+
+    // Unknown values fail the initialization.
+    int res = writeFile(configFile, "{\"logLevel\": \"LOUD\", \"filePath\": \"" LOG_FILE "\"}");
+    assert(res == 0);
+
+    if (cJSONLoggerInitFromFile(configFile) == 0) {
+        remove(configFile);
+        return FAILED;
+    }
+
+    char config[4 * MAX_STRING_LEN];
+    snprintf(config, sizeof(config),
+        "{\"logLevel\": \"WARN\", \"filePath\": \"" LOG_FILE "\", \"flushIntervalMs\": 10,"
+        " \"sinks\": [{\"type\": \"NDJSON\", \"path\": \"%s\", \"logLevel\": \"ERROR\"}],"
+        " \"paths\": [{\"path\": [\"foo\"], \"capacity\": 2}]}",
+        sinkFile);
+    res = writeFile(configFile, config);
+    assert(res == 0);
+
+    // The configuration file is found through the environment and its level is overridden.
+    setenv("CJSON_LOGGER_CONFIG", configFile, 1);
+    setenv("CJSON_LOGGER_LEVEL", "debug", 1);
+    res = cJSONLoggerInitFromFile(NULL);
+    unsetenv("CJSON_LOGGER_CONFIG");
+    unsetenv("CJSON_LOGGER_LEVEL");
+    remove(configFile);
+    if (res != 0) {
+        return FAILED;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        CJSON_LOG_DEBUG("%" JNO "debug %d", "foo", i);
+    }
+    CJSON_LOG_ERROR("%" JNO "error", "bar");
+
+    // No explicit dump, the periodic flush writes the output file and the sink.
+    int ret = FAILED;
+    for (int attempt = 0; attempt < 200 && ret == FAILED; attempt++) {
+        usleep(10000);
+
+        char* logData = readFile(LOG_FILE);
+        cJSON* jsonLogsDoc = logData != NULL ? cJSON_Parse(logData) : NULL;
+        free(logData);
+
+        cJSON* fooLogs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+        cJSON* barLogs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "bar"), "logs");
+        if (cJSON_GetArraySize(fooLogs) == 2 && cJSON_GetArraySize(barLogs) == 1
+            && strcmp(cJSON_GetObjectItem(cJSON_GetArrayItem(fooLogs, 1), "Log")->valuestring, "debug 4") == 0) {
+            ret = PASSED;
+        }
+        cJSON_Delete(jsonLogsDoc);
+
+        char* sinkData = readFile(sinkFile);
+        if (sinkData == NULL || strstr(sinkData, "\"error\"") == NULL || strstr(sinkData, "debug") != NULL) {
+            ret = FAILED;
+        }
+        free(sinkData);
+    }
+
+    remove(sinkFile);
+
+    return ret;
+}
+
+/**
+ * @brief Test that a watched configuration file applies its per path log levels and rate limits, and is reloaded when replaced.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_watch_config_file(void)
+{
+    char configFile[MAX_STRING_LEN];
+    snprintf(configFile, sizeof(configFile), "watch_%d.json", (int)getpid());
+    char newConfigFile[MAX_STRING_LEN];
+    snprintf(newConfigFile, sizeof(newConfigFile), "watch_%d.json.new", (int)getpid());
+
+    int res = writeFile(configFile,
+        "{\"logLevel\": \"WARN\", \"filePath\": \"" LOG_FILE "\","
+        " \"paths\": [{\"path\": [\"foo\"], \"logLevel\": \"DEBUG\"}, {\"path\": [\"bar\"], \"rateLimit\": 1, \"rateBurst\": 2}]}");
+    assert(res == 0);
+
+    res = cJSONLoggerInitFromFile(configFile);
+    assert(res == 0);
+
+    if (cJSONLoggerWatchConfigFile(configFile) != 0) {
+        remove(configFile);
+        return FAILED;
+    }
+
+    const char* fooPath[] = { "foo" };
+    const char* barPath[] = { "bar" };
+    const char* bazPath[] = { "baz" };
+    static char messages[64][MAX_STRING_LEN];
+
+    // foo is more verbose than the logger, bar admits a burst of 2 logs.
+    CJSON_LOG_DEBUG("%" JNO "debug", "foo");
+    CJSON_LOG_DEBUG("%" JNO "debug", "baz");
+    for (int i = 0; i < 5; i++) {
+        CJSON_LOG_WARN("%" JNO "warn %d", "bar", i);
+    }
+
+    if (cJSONLoggerTail(fooPath, 1, 0, flightRecorderRecords, messages) != 1
+        || cJSONLoggerTail(bazPath, 1, 0, flightRecorderRecords, messages) > 0
+        || cJSONLoggerTail(barPath, 1, 0, flightRecorderRecords, messages) != 2) {
+        remove(configFile);
+        return FAILED;
+    }
+
+    // Replaced the way editors save, the new configuration drops the rules.
+    res = writeFile(newConfigFile, "{\"logLevel\": \"DEBUG\", \"filePath\": \"" LOG_FILE "\"}");
+    assert(res == 0);
+    res = rename(newConfigFile, configFile);
+    assert(res == 0);
+
+    int reloaded = 0;
+    for (int attempt = 0; attempt < 200 && reloaded == 0; attempt++) {
+        usleep(10000);
+        CJSON_LOG_DEBUG("%" JNO "debug", "baz");
+        reloaded = cJSONLoggerTail(bazPath, 1, 0, flightRecorderRecords, messages) > 0;
+    }
+    remove(configFile);
+
+    for (int i = 5; i < 10; i++) {
+        CJSON_LOG_WARN("%" JNO "warn %d", "bar", i);
+    }
+
+    return reloaded != 0 && cJSONLoggerTail(barPath, 1, 0, flightRecorderRecords, messages) == 7 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Test the preallocation of the JSON tree and the declared nodes.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_preallocate(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = LOG_FILE;
+    config.rotateLogCount = 1000;
+    config.preallocate = 1;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    const char* rxPath[] = { "net", "rx" };
+    const char* txPath[] = { "net", "tx" };
+    static char messages[64][MAX_STRING_LEN];
+
+    if (cJSONLoggerDeclarePath(NULL, 2, 256) == 0) {
+        return FAILED;
+    }
+
+    res = cJSONLoggerDeclarePath(rxPath, 2, 256);
+    assert(res == 0);
+    res = cJSONLoggerDeclarePath(txPath, 2, 0);
+    assert(res == 0);
+
+    // The declared nodes grow past their reservation as usual.
+    for (int i = 0; i < 300; i++) {
+        CJSON_LOG_INFO("%" JNO "%" JNO "rx %d", "net", "rx", i);
+    }
+
+    if (cJSONLoggerTail(rxPath, 2, 1, flightRecorderRecords, messages) != 1 || strcmp(messages[0], "rx 299") != 0) {
+        return FAILED;
+    }
+
+    // The declared nodes are created again, empty, by the rotation.
+    cJSONLoggerRotate();
+    cJSONLoggerDump();
+
+    char rotatedPattern[MAX_STRING_LEN];
+    snprintf(rotatedPattern, sizeof(rotatedPattern), "*_%s", LOG_FILE);
+    int rotatedFiles = removeMatchingFiles(rotatedPattern);
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL || rotatedFiles == 0) {
+        free(logData);
+        return FAILED;
+    }
+
+    cJSON* loggedJson = cJSON_Parse(logData);
+    free(logData);
+    logData = NULL;
+
+    if (loggedJson == NULL) {
+        return FAILED;
+    }
+
+    cJSON* net = cJSON_GetObjectItem(loggedJson, "net");
+    if (cJSON_GetObjectItem(net, "rx") == NULL || cJSON_GetObjectItem(net, "tx") == NULL) {
+        RELEASE_RESOURCE_AND_RETURN_FAIL(loggedJson, cJSON_Delete);
+    }
+
+    cJSON_Delete(loggedJson);
+
+    CJSON_LOG_INFO("%" JNO "%" JNO "tx", "net", "tx");
+
+    int rxRecords = cJSONLoggerTail(rxPath, 2, 0, flightRecorderRecords, messages);
+    int txRecords = cJSONLoggerTail(txPath, 2, 0, flightRecorderRecords, messages);
+
+    return rxRecords == 0 && txRecords == 1 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Test that a lazy initialization creates nothing until the first admitted log.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_lazy_init(void)
+{
+    const char* lazyFile = "lazy_log.json";
+    remove(lazyFile);
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = lazyFile;
+    config.lazyInit = 1;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // Below the log level, the logger stays uninitialized and the dump has nothing to write.
+    CJSON_LOG_DEBUG("%" JNO "debug", "foo");
+    cJSONLoggerDump();
+
+    if (access(lazyFile, F_OK) == 0) {
+        remove(lazyFile);
+        return FAILED;
+    }
+
+    CJSON_LOG_INFO("%" JNO "info", "foo");
+    cJSONLoggerDump();
+
+    char* logData = readFile(lazyFile);
+    remove(lazyFile);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* loggedJson = cJSON_Parse(logData);
+    free(logData);
+    logData = NULL;
+
+    if (loggedJson == NULL) {
+        return FAILED;
+    }
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(loggedJson, "foo"), "logs")) == 1 ? PASSED : FAILED;
+    cJSON_Delete(loggedJson);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the dumps and the rotations do nothing while the logs do not change.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_dump_unchanged(void)
+{
+    char rotatedPattern[MAX_STRING_LEN];
+    snprintf(rotatedPattern, sizeof(rotatedPattern), "*_%s", LOG_FILE);
+    removeMatchingFiles(rotatedPattern);
+
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "bar", "foo");
+    cJSONLoggerDump();
+
+    // The file is not written again while the logs do not change.
+    remove(LOG_FILE);
+    cJSONLoggerDump();
+
+    if (access(LOG_FILE, F_OK) == 0) {
+        return FAILED;
+    }
+
+    // The second rotation has no logs to rotate.
+    cJSONLoggerRotate();
+    cJSONLoggerRotate();
+
+    if (removeMatchingFiles(rotatedPattern) != 1) {
+        return FAILED;
+    }
+
+    CJSON_LOG_INFO("%" JNO "bar", "foo");
+    cJSONLoggerDump();
+
+    return access(LOG_FILE, F_OK) == 0 ? PASSED : FAILED;
+}
+
+/**
+ * @def ESCAPE_MSG_LEN
+ *
+ * @brief The max length of the logs of test_cJSONLogger_escape(), spanning several 8, 16 and 32 byte blocks of the scans.
+ */
+#define ESCAPE_MSG_LEN 79
+
+/**
+ * @brief Build the message of a log of test_cJSONLogger_escape(), an escaped character on the last position and another one before it.
+ *
+ * @param pos The last position of the message.
+ * @param logMsg Where the message will be stored, ESCAPE_MSG_LEN + 1 bytes.
+ */
+static void escapeMessage(size_t pos, char* logMsg)
+{
+    const char specials[] = { '\"', '\\', '\n', '\x01', '\x1f', '\x7f', ' ', '\xc3' };
+
+    memset(logMsg, 'a', ESCAPE_MSG_LEN);
+    logMsg[pos] = specials[pos % sizeof(specials)];
+    logMsg[(pos * 7) % ESCAPE_MSG_LEN] = specials[(pos + 3) % sizeof(specials)];
+    logMsg[pos + 1] = '\0';
+}
+
+/**
+ * @brief Test that the vectorized escaping finds the escaped characters at every position of a log, byte identical to cJSON_Print().
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_escape(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    // The escaped characters land on every position across the 8, 16 and 32 byte blocks of the scans.
+    char logMsg[ESCAPE_MSG_LEN + 1];
+    for (size_t pos = 0; pos < ESCAPE_MSG_LEN; pos++) {
+        escapeMessage(pos, logMsg);
+        CJSON_LOG_INFO("%s", logMsg);
+    }
+
+    cJSONLoggerDump();
+
+    cJSON* jsonLogsDoc = NULL;
+    if (dumpMatchesCJSONPrint(&jsonLogsDoc) != PASSED) {
+        return FAILED;
+    }
+
+    // Every message reads back as it was logged.
+    const cJSON* logs = cJSON_GetObjectItem(jsonLogsDoc, "logs");
+    int ret = cJSON_GetArraySize(logs) == ESCAPE_MSG_LEN ? PASSED : FAILED;
+    for (size_t pos = 0; ret == PASSED && pos < ESCAPE_MSG_LEN; pos++) {
+        const cJSON* message = cJSON_GetObjectItem(cJSON_GetArrayItem(logs, (int)pos), "Log");
+        escapeMessage(pos, logMsg);
+        ret = cJSON_IsString(message) && strcmp(message->valuestring, logMsg) == 0 ? PASSED : FAILED;
+    }
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Reference of escapeScan(), one character at a time.
+ *
+ * @param str The string to scan.
+ * @param length The number of characters to scan.
+ *
+ * @return size_t, the position of the first character to escape, length if there is none.
+ */
+static size_t referenceEscapeScan(const unsigned char* str, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (str[i] < 0x20 || str[i] == '\"' || str[i] == '\\') {
+            return i;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * @brief Reference of escapeLength(), counting the escape sequences of cJSON_Print() one character at a time.
+ *
+ * @param str The string to escape.
+ * @param length The number of characters of the string.
+ *
+ * @return size_t, the escaped length.
+ */
+static size_t referenceEscapeLength(const unsigned char* str, size_t length)
+{
+    size_t escapedLength = 0;
+    for (size_t i = 0; i < length; i++) {
+        switch (str[i]) {
+        case '\"':
+        case '\\':
+        case '\b':
+        case '\f':
+        case '\n':
+        case '\r':
+        case '\t':
+            escapedLength += 2;
+            break;
+        default:
+            // The other control characters print as \u00XX.
+            escapedLength += str[i] < 0x20 ? 6 : 1;
+            break;
+        }
+    }
+
+    return escapedLength;
+}
+
+/**
+ * @brief Test escapeScan() and escapeLength() against their references for every byte value, at every position of every length up to 64
+ * and from unaligned starts.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_escape_kernels(void)
+{
+    const size_t offsets[] = { 0, 1, 3, 7, 8, 15, 17, 31 };
+    unsigned char buffer[128];
+
+    for (unsigned int byte = 0; byte < 256; byte++) {
+        for (size_t offset = 0; offset < sizeof(offsets) / sizeof(offsets[0]); offset++) {
+            unsigned char* str = buffer + offsets[offset];
+
+            for (size_t length = 0; length <= 64; length++) {
+                // The bytes around the string need an escape, a scan reading past its bounds reports them. The string alternates ASCII and
+                // bytes with the high bit set, neither needs an escape.
+                memset(buffer, '\"', sizeof(buffer));
+                for (size_t i = 0; i < length; i++) {
+                    str[i] = i % 2 == 0 ? 'a' : 0xe9;
+                }
+
+                if (escapeScan((const char*)str, length) != length || escapeLength((const char*)str, length) != length) {
+                    return FAILED;
+                }
+
+                for (size_t pos = 0; pos < length; pos++) {
+                    unsigned char filler = str[pos];
+                    str[pos] = (unsigned char)byte;
+
+                    if (escapeScan((const char*)str, length) != referenceEscapeScan(str, length)
+                        || escapeLength((const char*)str, length) != referenceEscapeLength(str, length)) {
+                        return FAILED;
+                    }
+
+                    str[pos] = filler;
+                }
+            }
+        }
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Test that the messages escaped when stored print the same from uncapped, capped and uncapped again nodes, and stay raw for the queries.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_escape_once(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    const char* jsonPath[] = { "foo" };
+    res = cJSONLoggerSetNodeCapacity(jsonPath, 1, 4);
+    assert(res == 0);
+
+    for (int i = 0; i < 6; i++) {
+        CJSON_LOG_INFO("%" JNO "quote \" tab \t %d", "foo", i);
+        CJSON_LOG_INFO("%" JNO "quote \" tab \t %d", "bar", i);
+        CJSON_LOG_INFO("%" JNO "plain %d", "bar", i);
+    }
+
+    cJSONLoggerDump();
+    if (dumpMatchesCJSONPrint(NULL) != PASSED) {
+        return FAILED;
+    }
+
+    // Lifting the cap moves the messages of the capped node to the arena, escaping them there.
+    res = cJSONLoggerSetNodeCapacity(jsonPath, 1, 0);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "control \x01 %d", "foo", 6);
+    cJSONLoggerDump();
+    if (dumpMatchesCJSONPrint(NULL) != PASSED) {
+        return FAILED;
+    }
+
+    static char messages[64][MAX_STRING_LEN];
+    if (cJSONLoggerTail(jsonPath, 1, 0, flightRecorderRecords, messages) != 5
+        || strcmp(messages[0], "quote \" tab \t 2") != 0
+        || strcmp(messages[4], "control \x01 6") != 0) {
+        return FAILED;
+    }
+
+    return PASSED;
+}
+
+/**
+ * @brief Callback of test_cJSONLogger_time_format(), collects the time stamps and file lines of the records.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData Array of CJSONLoggerRecord_s, filled in order, the strings are not kept.
+ */
+static void timeFormatRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    CJSONLoggerRecord_s* collected = (CJSONLoggerRecord_s*)userData;
+
+    for (size_t i = 0; i < count; i++) {
+        collected[i].timeStamp = records[i].timeStamp;
+        collected[i].fileLine = records[i].fileLine;
+    }
+}
+
+/**
+ * @brief Test that the dumped time stamps and file lines read the same as printing them with snprintf().
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_time_format(void)
+{
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    for (int i = 0; i < 8; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    const char* jsonPath[] = { "foo" };
+    CJSONLoggerRecord_s records[8];
+    if (cJSONLoggerTail(jsonPath, 1, 0, timeFormatRecords, records) != 8) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == 8 ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < 8; i++) {
+        cJSON* log = cJSON_GetArrayItem(logs, i);
+
+        time_t seconds = (time_t)(records[i].timeStamp / 1000000000);
+        struct tm tmInfo;
+        localtime_r(&seconds, &tmInfo);
+
+        char expectedTime[MAX_STRING_LEN];
+        snprintf(expectedTime, sizeof(expectedTime), "%d-%d-%d %d:%d:%d.%ld", tmInfo.tm_year + 1900, tmInfo.tm_mon + 1, tmInfo.tm_mday, tmInfo.tm_hour,
+            tmInfo.tm_min, tmInfo.tm_sec, (long)(records[i].timeStamp % 1000000000));
+
+        cJSON* timeItem = cJSON_GetObjectItem(log, "Time");
+        cJSON* fileLineItem = cJSON_GetObjectItem(log, "FileLine");
+        if (!cJSON_IsString(timeItem)
+            || strcmp(timeItem->valuestring, expectedTime) != 0
+            || !cJSON_IsNumber(fileLineItem)
+            || fileLineItem->valueint != records[i].fileLine) {
+            ret = FAILED;
+        }
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the RFC 3339 time stamps are fixed width and read the same as printing them with strftime().
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_time_format_rfc3339(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.timeFormat = (CJSON_LOGGER_TIME_FORMAT_E)3;
+
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    config.timeFormat = CJSON_LOGGER_TIME_RFC3339_UTC;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 0; i < 8; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    const char* jsonPath[] = { "foo" };
+    CJSONLoggerRecord_s records[8];
+    if (cJSONLoggerTail(jsonPath, 1, 0, timeFormatRecords, records) != 8) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == 8 ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < 8; i++) {
+        time_t seconds = (time_t)(records[i].timeStamp / 1000000000);
+        struct tm tmInfo;
+        gmtime_r(&seconds, &tmInfo);
+
+        char dateTime[MAX_STRING_LEN];
+        strftime(dateTime, sizeof(dateTime), "%Y-%m-%dT%H:%M:%S", &tmInfo);
+
+        char expectedTime[MAX_STRING_LEN];
+        snprintf(expectedTime, sizeof(expectedTime), "%s.%09ldZ", dateTime, (long)(records[i].timeStamp % 1000000000));
+
+        cJSON* timeItem = cJSON_GetObjectItem(cJSON_GetArrayItem(logs, i), "Time");
+        if (!cJSON_IsString(timeItem) || strcmp(timeItem->valuestring, expectedTime) != 0 || strlen(timeItem->valuestring) != 30) {
+            ret = FAILED;
+        }
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Thread handler logging numbered records for test_cJSONLogger_sequence_numbers().
+ *
+ * @param arg Unused.
+ *
+ * @return void*, always NULL.
+ */
+static void* sequenceNumbersHandler(void* arg)
+{
+    (void)arg;
+
+    for (int i = 0; i < 100; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Records observed by the callback of test_cJSONLogger_sequence_numbers().
+ *
+ * @var sequences The sequence numbers of the records, in order.
+ * @var threadIds The thread ids of the records, in order.
+ * @var records Number of records received.
+ */
+typedef struct SequenceNumbersState {
+    uint64_t sequences[400];
+    uint32_t threadIds[400];
+    size_t records;
+} SequenceNumbersState_s;
+
+/**
+ * @brief Callback of test_cJSONLogger_sequence_numbers(), collects the sequence numbers and the thread ids of the records.
+ *
+ * @param records The records of the batch.
+ * @param count The number of records.
+ * @param userData The SequenceNumbersState_s of the test.
+ */
+static void sequenceNumbersRecords(const CJSONLoggerRecord_s* records, size_t count, void* userData)
+{
+    SequenceNumbersState_s* state = (SequenceNumbersState_s*)userData;
+
+    for (size_t i = 0; i < count && state->records < 400; i++) {
+        state->sequences[state->records] = records[i].sequence;
+        state->threadIds[state->records] = records[i].threadId;
+        state->records++;
+    }
+}
+
+/**
+ * @brief Test that the records of several threads are numbered once each and increase in the order every thread logs them.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_sequence_numbers(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.sequenceNumbers = 1;
+    config.threadIds = 1;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        res = pthread_create(&threads[i], NULL, sequenceNumbersHandler, NULL);
+        assert(res == 0);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        res = pthread_join(threads[i], NULL);
+        assert(res == 0);
+    }
+
+    const char* jsonPath[] = { "foo" };
+    static SequenceNumbersState_s state;
+    if (cJSONLoggerTail(jsonPath, 1, 0, sequenceNumbersRecords, &state) != 400) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    // Every sequence number from 1 to 400 is used once, the last one seen of every thread is smaller than its next one.
+    static char seen[401];
+    uint32_t threadIds[4] = { 0 };
+    uint64_t lastSequences[4] = { 0 };
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == 400 ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < 400; i++) {
+        cJSON* log = cJSON_GetArrayItem(logs, i);
+        cJSON* sequenceItem = cJSON_GetObjectItem(log, "Sequence");
+        cJSON* threadIdItem = cJSON_GetObjectItem(log, "ThreadId");
+        if (!cJSON_IsNumber(sequenceItem) || !cJSON_IsNumber(threadIdItem) || sequenceItem->valuedouble < 1 || sequenceItem->valuedouble > 400) {
+            ret = FAILED;
+            break;
+        }
+
+        uint64_t sequence = (uint64_t)sequenceItem->valuedouble;
+        uint32_t threadId = (uint32_t)threadIdItem->valuedouble;
+        if (seen[sequence] != 0 || threadId == 0 || state.sequences[i] != sequence || state.threadIds[i] != threadId) {
+            ret = FAILED;
+            break;
+        }
+        seen[sequence] = 1;
+
+        int thread = 0;
+        while (thread < 4 && threadIds[thread] != 0 && threadIds[thread] != threadId) {
+            thread++;
+        }
+
+        if (thread == 4 || lastSequences[thread] >= sequence) {
+            ret = FAILED;
+            break;
+        }
+
+        threadIds[thread] = threadId;
+        lastSequences[thread] = sequence;
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret == PASSED && threadIds[3] != 0 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Test that a node keeps the logs stored before the sequence numbers and thread ids were enabled without them.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_sequence_numbers_enabled_later(void)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = LOG_FILE;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 0; i < 100; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    // The store is kept, the next logs of the node are numbered and grow its columns past the unnumbered ones.
+    config.sequenceNumbers = 1;
+    config.threadIds = 1;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 100; i < 200; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    const char* jsonPath[] = { "foo" };
+    static SequenceNumbersState_s state;
+    if (cJSONLoggerTail(jsonPath, 1, 0, sequenceNumbersRecords, &state) != 200) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    cJSON* logs = cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs");
+    int ret = cJSON_GetArraySize(logs) == 200 ? PASSED : FAILED;
+    for (int i = 0; ret == PASSED && i < 200; i++) {
+        cJSON* log = cJSON_GetArrayItem(logs, i);
+        cJSON* sequenceItem = cJSON_GetObjectItem(log, "Sequence");
+        cJSON* threadIdItem = cJSON_GetObjectItem(log, "ThreadId");
+        uint64_t sequence = i < 100 ? 0 : (uint64_t)(i - 99);
+
+        if ((i < 100 && (sequenceItem != NULL || threadIdItem != NULL || state.threadIds[i] != 0))
+            || (i >= 100 && (!cJSON_IsNumber(sequenceItem) || (uint64_t)sequenceItem->valuedouble != sequence || !cJSON_IsNumber(threadIdItem) || state.threadIds[i] == 0))
+            || state.sequences[i] != sequence) {
+            ret = FAILED;
+        }
+    }
+
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Count the threads of the process, waiting up to a second for the count to drop to a given value.
+ *
+ * @param expected The thread count to wait for, 0 to count once.
+ *
+ * @return int, the number of threads, negative value if they can not be counted.
+ */
+static int countThreads(int expected)
+{
+    int threads = -1;
+    for (int attempt = 0; attempt < 100; attempt++) {
+        DIR* dir = opendir("/proc/self/task");
+        if (dir == NULL) {
+            return -1;
+        }
+
+        threads = 0;
+        for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                threads++;
+            }
+        }
+        closedir(dir);
+
+        if (expected == 0 || threads <= expected) {
+            break;
+        }
+        usleep(10000);
+    }
+
+    return threads;
+}
+
+/**
+ * @brief Thread handler returning at once, used by test_cJSONLogger_init_failure().
+ *
+ * @param arg Unused.
+ *
+ * @return void*, always NULL.
+ */
+static void* idleThreadHandler(void* arg)
+{
+    (void)arg;
+    return NULL;
+}
+
+/**
+ * @brief Test that a failed initialization leaves its threads to cJSONLoggerDestroy() and that the logger can be initialized again.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_init_failure(void)
+{
+    // A first thread is started and joined so helper threads started with it, e.g. by a sanitizer, are already counted.
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, idleThreadHandler, NULL) != 0 || pthread_join(thread, NULL) != 0) {
+        return FAILED;
+    }
+
+    int threads = countThreads(0);
+    if (threads <= 0) {
+        return FAILED;
+    }
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    // The worker pool and its periodic flush are created before the shared memory ring, which fails on the name.
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.flushIntervalMs = 10;
+    config.shmName = "/cjsonlogger/invalid";
+
+    if (cJSONLoggerInitWithConfig(&config) == 0 || countThreads(0) <= threads) {
+        return FAILED;
+    }
+
+    cJSONLoggerDestroy();
+    if (countThreads(threads) != threads) {
+        return FAILED;
+    }
+
+    config.shmName = NULL;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "value", "foo");
+    cJSONLoggerDump();
+
+    char* logData = readFile(LOG_FILE);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) == 1 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    cJSONLoggerDestroy();
+    if (countThreads(threads) != threads) {
+        return FAILED;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Test that a lazy initialization failing when it is completed drops its configuration without stopping the process.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_lazy_init_failure(void)
+{
+    const char* lazyFile = "lazy_log.json";
+    remove(lazyFile);
+
+    char socketPath[256];
+    memset(socketPath, 's', sizeof(socketPath) - 1);
+    socketPath[sizeof(socketPath) - 1] = '\0';
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = lazyFile;
+    config.lazyInit = 1;
+    config.socketPath = socketPath;
+
+    // The socket path can not fit a socket address, checked before anything is deferred.
+    if (cJSONLoggerInitWithConfig(&config) == 0) {
+        return FAILED;
+    }
+
+    // The shared memory ring name is only rejected by shm_open(), when the first log completes the initialization.
+    config.socketPath = NULL;
+    config.shmName = "/cjsonlogger/invalid";
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "info", "foo");
+    cJSONLoggerDump();
+
+    if (access(lazyFile, F_OK) == 0) {
+        remove(lazyFile);
+        return FAILED;
+    }
+
+    // The APIs completing the initialization report the failure.
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    const char* jsonPath[] = { "foo" };
+    if (cJSONLoggerDeclarePath(jsonPath, 1, 16) == 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerDestroy();
+
+    config.lazyInit = 0;
+    config.shmName = NULL;
+
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "info", "foo");
+    cJSONLoggerDump();
+
+    char* logData = readFile(lazyFile);
+    remove(lazyFile);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* loggedJson = cJSON_Parse(logData);
+    free(logData);
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(loggedJson, "foo"), "logs")) == 1 ? PASSED : FAILED;
+    cJSON_Delete(loggedJson);
+
+    return ret;
+}
+
+/**
+ * @brief Test that a dump or a rotation that can not write its file keeps the logs for the next dump.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_dump_failure(void)
+{
+    const char* dumpDir = "dump_dir";
+    const char* dumpFile = "dump_dir/log.json";
+    remove(dumpFile);
+    rmdir(dumpDir);
+
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, dumpFile);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "value", "foo");
+
+    // Neither the directory of the output file nor the one of the rotated file exist.
+    cJSONLoggerDump();
+    cJSONLoggerRotate();
+
+    if (mkdir(dumpDir, 0777) != 0) {
+        return FAILED;
+    }
+
+    cJSONLoggerDump();
+
+    char* logData = readFile(dumpFile);
+    remove(dumpFile);
+    rmdir(dumpDir);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) == 1 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Test that the periodic flush runs on the worker pool without a thread of its own.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_flush_interval_workers(void)
+{
+    remove(LOG_FILE);
+
+    // A first thread is started and joined so helper threads started with it, e.g. by a sanitizer, are already counted.
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, idleThreadHandler, NULL) != 0 || pthread_join(thread, NULL) != 0) {
+        return FAILED;
+    }
+
+    int threads = countThreads(0);
+    if (threads <= 0) {
+        return FAILED;
+    }
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.flushIntervalMs = 10;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    if (countThreads(0) != threads + 2) {
+        return FAILED;
+    }
+
+    CJSON_LOG_INFO("%" JNO "value", "foo");
+
+    // No explicit dump, an idle worker writes the output file.
+    int ret = FAILED;
+    for (int attempt = 0; attempt < 200 && ret == FAILED; attempt++) {
+        usleep(10000);
+
+        char* logData = readFile(LOG_FILE);
+        cJSON* jsonLogsDoc = logData != NULL ? cJSON_Parse(logData) : NULL;
+        free(logData);
+
+        if (cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) == 1) {
+            ret = PASSED;
+        }
+        cJSON_Delete(jsonLogsDoc);
+    }
+
+    cJSONLoggerDestroy();
+    if (countThreads(threads) != threads) {
+        return FAILED;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Test that the original initialization starts no thread, the logs and the dumps run on the calling thread.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_init_no_workers(void)
+{
+    // A first thread is started and joined so helper threads started with it, e.g. by a sanitizer, are already counted.
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, idleThreadHandler, NULL) != 0 || pthread_join(thread, NULL) != 0) {
+        return FAILED;
+    }
+
+    int threads = countThreads(0);
+    if (threads <= 0) {
+        return FAILED;
+    }
+
+    int res = cJSONLoggerInit(CJSON_LOG_LEVEL_INFO, LOG_FILE);
+    assert(res == 0);
+
+    CJSON_LOG_INFO("%" JNO "value", "foo");
+    cJSONLoggerDump();
+
+    return countThreads(0) == threads ? PASSED : FAILED;
+}
+
+/**
+ * @brief Test that a nice value the process is not allowed to apply leaves the logger threads running with the inherited one.
+ *
+ * @note Run as root the test drops to an unprivileged user first, the test process is a forked child.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_thread_nice_denied(void)
+{
+    const char* niceFile = "/tmp/cjsonlogger_nice_log.json";
+    remove(niceFile);
+
+    if (geteuid() == 0 && setuid(65534) != 0) {
+        return FAILED;
+    }
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = niceFile;
+    config.workerThreads = 2;
+    config.flushIntervalMs = 10;
+    config.workerNice = -20;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    for (int i = 0; i < 600; i++) {
+        CJSON_LOG_INFO("%" JNO "value %d", "foo", i);
+    }
+
+    // Give the periodic flush a few periods on the workers.
+    usleep(50000);
+    cJSONLoggerDump();
+
+    char* logData = readFile(niceFile);
+    remove(niceFile);
+    if (logData == NULL) {
+        return FAILED;
+    }
+
+    cJSON* jsonLogsDoc = cJSON_Parse(logData);
+    free(logData);
+
+    int ret = cJSON_GetArraySize(cJSON_GetObjectItem(cJSON_GetObjectItem(jsonLogsDoc, "foo"), "logs")) == 600 ? PASSED : FAILED;
+    cJSON_Delete(jsonLogsDoc);
+
+    return ret;
+}
+
+/**
+ * @brief Count the threads of the process running with a nice value, waiting up to a second for a given count.
+ *
+ * @param niceValue The nice value of the counted threads.
+ * @param expected The thread count to wait for.
+ *
+ * @return int, the number of threads running with the nice value, negative value if they can not be counted.
+ */
+static int countThreadsWithNice(int niceValue, int expected)
+{
+    int threads = -1;
+    for (int attempt = 0; attempt < 100 && threads != expected; attempt++) {
+        if (attempt != 0) {
+            usleep(10000);
+        }
+
+        DIR* dir = opendir("/proc/self/task");
+        if (dir == NULL) {
+            return -1;
+        }
+
+        threads = 0;
+        for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+            char statPath[64];
+            snprintf(statPath, sizeof(statPath), "/proc/self/task/%s/stat", entry->d_name);
+
+            // Files under /proc report a zero size, read the single stat line directly.
+            char stat[512];
+            FILE* file = entry->d_name[0] != '.' ? fopen(statPath, "r") : NULL;
+            char* fields = NULL;
+            if (file != NULL) {
+                fields = fgets(stat, sizeof(stat), file) != NULL ? strrchr(stat, ')') : NULL;
+                fclose(file);
+            }
+
+            // The nice value is the 19th field, the 17th one after the command name.
+            int threadNice = 0;
+            if (fields != NULL && sscanf(fields, ") %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %d", &threadNice) == 1
+                && threadNice == niceValue) {
+                threads++;
+            }
+        }
+        closedir(dir);
+    }
+
+    return threads;
+}
+
+/**
+ * @brief Test that the logger threads keep the nice value of the process by default and can be set back to nice 0 explicitly.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_thread_nice_zero(void)
+{
+    // The threads created from now on inherit the raised nice value.
+    errno = 0;
+    int inheritedNice = nice(5);
+    if (inheritedNice == -1 && errno != 0) {
+        return FAILED;
+    }
+
+    // A first thread is started and joined so helper threads started with it, e.g. by a sanitizer, are not counted.
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, idleThreadHandler, NULL) != 0 || pthread_join(thread, NULL) != 0) {
+        return FAILED;
+    }
+
+    int inheritedThreads = countThreadsWithNice(inheritedNice, 1);
+    int zeroThreads = countThreadsWithNice(0, 0);
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    if (countThreadsWithNice(inheritedNice, inheritedThreads + 2) != inheritedThreads + 2) {
+        return FAILED;
+    }
+
+    cJSONLoggerDestroy();
+
+    config.workerNice = 0;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    // Lowering the nice value needs CAP_SYS_NICE, without it the workers keep the inherited one.
+    int expectedWorkers = geteuid() == 0 && inheritedNice != 0 ? 2 : 0;
+    if (countThreadsWithNice(0, zeroThreads + expectedWorkers) != zeroThreads + expectedWorkers) {
+        return FAILED;
+    }
+
+    CJSON_LOG_INFO("%" JNO "value", "foo");
+    cJSONLoggerDump();
+
+    return access(LOG_FILE, F_OK) == 0 ? PASSED : FAILED;
+}
+
+/**
+ * @brief Log a tree large enough for its dumps to be split into chunks, logs at the root and under nested nodes.
+ *
+ * @param logCount The number of logs.
+ */
+static void logChunkedTree(int logCount)
+{
+    const char* nodes[] = { "foo", "bar", "baz", "qux", "quux", "corge" };
+    for (int i = 0; i < logCount; i++) {
+        switch (i % 4) {
+        case 0:
+            CJSON_LOG_INFO("root value %d \"quoted\"", i);
+            break;
+        case 1:
+            CJSON_LOG_INFO("%" JNO "value %d", nodes[i % 6], i);
+            break;
+        case 2:
+            CJSON_LOG_WARN("%" JNO "%" JNO "value %d\t%s", nodes[i % 6], nodes[(i / 6) % 6], i, "tabbed");
+            break;
+        default:
+            CJSON_LOG_ERROR("%" JNO "%" JNO "%" JNO "value %d", nodes[(i / 2) % 6], nodes[i % 6], nodes[(i / 36) % 6], i);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Check that the dump of a chunked tree printed on the calling thread is byte identical to the one printed on a worker pool.
+ *
+ * @note The worker pool is created by the second initialization, which keeps the log store.
+ *
+ * @param workerThreads The number of worker threads of the second dump.
+ *
+ * @return int, PASSED if the dumps match, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int chunkedDumpsMatch(unsigned int workerThreads)
+{
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = LOG_FILE;
+    config.workerThreads = 0;
+    config.rotateLogCount = 4096;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    logChunkedTree(900);
+    cJSONLoggerDump();
+
+    if (dumpMatchesCJSONPrint(NULL) != PASSED) {
+        return FAILED;
+    }
+
+    char* serialData = readFile(LOG_FILE);
+    if (serialData == NULL) {
+        return FAILED;
+    }
+
+    config.workerThreads = workerThreads;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    cJSONLoggerDump();
+
+    char* parallelData = readFile(LOG_FILE);
+    int ret = parallelData != NULL && strcmp(serialData, parallelData) == 0 ? PASSED : FAILED;
+
+    free(serialData);
+    free(parallelData);
+
+    return ret;
+}
+
+/**
+ * @brief Test that a tree split into chunks dumps the same bytes on the calling thread, on one worker and on several workers.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_chunked_dump(void)
+{
+    // The worker pool can not be resized, the single worker runs in a child process.
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(chunkedDumpsMatch(1) == PASSED ? 0 : 1);
+    }
+
+    int childExitStatus;
+    if (pid < 0 || waitpid(pid, &childExitStatus, 0) != pid || !WIFEXITED(childExitStatus) || WEXITSTATUS(childExitStatus) != 0) {
+        return FAILED;
+    }
+
+    return chunkedDumpsMatch(4);
+}
+
+/**
+ * @struct SlowReader
+ *
+ * @brief Reader of test_cJSONLogger_dump_partial_writes(), drains a pipe in small steps.
+ *
+ * @var fd The non blocking read end of the pipe, closed by the reader.
+ * @var data The bytes read, the ones past capacity are only counted.
+ * @var capacity The size of data.
+ * @var length The number of bytes read.
+ */
+typedef struct SlowReader {
+    int fd;
+    char* data;
+    size_t capacity;
+    size_t length;
+} SlowReader_s;
+
+/**
+ * @brief Thread handler reading a pipe in small steps, so the writer fills it and blocks.
+ *
+ * @param arg The SlowReader_s of the test.
+ *
+ * @return void*, always NULL.
+ */
+static void* slowReaderHandler(void* arg)
+{
+    SlowReader_s* reader = (SlowReader_s*)arg;
+
+    char step[1024];
+    for (;;) {
+        ssize_t res = read(reader->fd, step, sizeof(step));
+        if (res > 0) {
+            size_t copyLength = reader->length < reader->capacity ? reader->capacity - reader->length : 0;
+            memcpy(reader->data + reader->length, step, copyLength < (size_t)res ? copyLength : (size_t)res);
+            reader->length += (size_t)res;
+        }
+
+        // The pipe reads as ended until the dump opens it, the end counts once the dump wrote to it.
+        else if ((res == 0 && reader->length > 0) || (res < 0 && errno != EAGAIN && errno != EINTR)) {
+            break;
+        }
+
+        // A dump writing more than expected is cut off, its next write fails instead of blocking.
+        if (reader->length > reader->capacity) {
+            break;
+        }
+        usleep(50);
+    }
+
+    close(reader->fd);
+    return NULL;
+}
+
+/**
+ * @brief Signal handler interrupting the blocked writes of test_cJSONLogger_dump_partial_writes().
+ *
+ * @param sig Unused.
+ */
+static void partialWriteSignal(int sig)
+{
+    (void)sig;
+}
+
+/**
+ * @brief Test that a dump written in pieces, its writes interrupted while the pipe is full, resumes each at the right byte.
+ *
+ * @return int, PASSED if the test passes, FAILED otherwise, values defined in enum TestStatus.
+ */
+static int test_cJSONLogger_dump_partial_writes(void)
+{
+    const char* fifoPath = "dump_fifo";
+    remove(fifoPath);
+
+    // Only this thread takes the signal, the logger and the reader threads inherit the blocked mask.
+    sigset_t sigSet;
+    sigemptyset(&sigSet);
+    sigaddset(&sigSet, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &sigSet, NULL);
+
+    CJSONLoggerConfig_s config;
+    cJSONLoggerGetDefaultConfig(&config);
+    config.filePath = LOG_FILE;
+    config.workerThreads = 2;
+    config.rotateLogCount = 4096;
+
+    int res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    logChunkedTree(3000);
+    cJSONLoggerDump();
+
+    char* expectedData = readFile(LOG_FILE);
+    if (expectedData == NULL || mkfifo(fifoPath, 0666) != 0) {
+        free(expectedData);
+        return FAILED;
+    }
+
+    // Opened without waiting for a writer, the dump then opens the pipe without waiting for the reader.
+    size_t expectedLength = strlen(expectedData);
+    SlowReader_s reader = {
+        .fd = open(fifoPath, O_RDONLY | O_NONBLOCK),
+        .data = (char*)calloc(expectedLength, 1),
+        .capacity = expectedLength,
+    };
+    assert(reader.fd != -1 && reader.data != NULL);
+
+    pthread_t readerThread;
+    res = pthread_create(&readerThread, NULL, slowReaderHandler, &reader);
+    assert(res == 0);
+
+    // The logs are dumped again to the pipe, the store is kept by the initialization.
+    config.filePath = fifoPath;
+    res = cJSONLoggerInitWithConfig(&config);
+    assert(res == 0);
+
+    struct sigaction action = { 0 };
+    action.sa_handler = partialWriteSignal;
+    sigaction(SIGALRM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    struct itimerval timer = { { 0, 500 }, { 0, 500 } };
+    setitimer(ITIMER_REAL, &timer, NULL);
+    pthread_sigmask(SIG_UNBLOCK, &sigSet, NULL);
+
+    cJSONLoggerDump();
+
+    pthread_sigmask(SIG_BLOCK, &sigSet, NULL);
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    res = pthread_join(readerThread, NULL);
+    assert(res == 0);
+
+    int ret = reader.length == expectedLength && memcmp(reader.data, expectedData, expectedLength) == 0 ? PASSED : FAILED;
+
+    remove(fifoPath);
+    free(reader.data);
+    free(expectedData);
+
+    return ret;
+}
+
 /*
  * @brief Entry point for cJSONLogger tests.
  *
@@ -591,6 +4235,49 @@ int main(void)
     RUN_TEST(PASSED, test_cJSONLogger_destroy);
     RUN_TEST(PASSED, test_cJSONLogger_dump);
     RUN_TEST(PASSED, test_cJSONLogger_rotate);
+    RUN_TEST(PASSED, test_cJSONLogger_dump_cjson_equivalence);
+    RUN_TEST(PASSED, test_cJSONLogger_init_with_config);
+    RUN_TEST(PASSED, test_cJSONLogger_reinit);
+    RUN_TEST(PASSED, test_cJSONLogger_thread_attributes);
+    RUN_TEST(PASSED, test_cJSONLogger_fork_fresh);
+    RUN_TEST(PASSED, test_cJSONLogger_shm_sink);
+    RUN_TEST(PASSED, test_cJSONLogger_shm_sink_abandoned_slot);
+    RUN_TEST(PASSED, test_cJSONLogger_socket_sink);
+    RUN_TEST(PASSED, test_cJSONLogger_sinks);
+    RUN_TEST(PASSED, test_cJSONLogger_callback_sink);
+    RUN_TEST(PASSED, test_cJSONLogger_query);
+    RUN_TEST(PASSED, test_cJSONLogger_tail);
+    RUN_TEST(PASSED, test_cJSONLogger_flight_recorder);
+    RUN_TEST(PASSED, test_cJSONLogger_split_sinks);
+    RUN_TEST(PASSED, test_cJSONLogger_init_from_file);
+    RUN_TEST(PASSED, test_cJSONLogger_watch_config_file);
+    RUN_TEST(PASSED, test_cJSONLogger_preallocate);
+    RUN_TEST(PASSED, test_cJSONLogger_lazy_init);
+    RUN_TEST(PASSED, test_cJSONLogger_dump_unchanged);
+    RUN_TEST(PASSED, test_cJSONLogger_escape);
+    RUN_TEST(PASSED, test_cJSONLogger_escape_once);
+    RUN_TEST(PASSED, test_cJSONLogger_time_format);
+    RUN_TEST(PASSED, test_cJSONLogger_time_format_rfc3339);
+    RUN_TEST(PASSED, test_cJSONLogger_sequence_numbers);
+    RUN_TEST(PASSED, test_cJSONLogger_sequence_numbers_enabled_later);
+    RUN_TEST(PASSED, test_cJSONLogger_init_failure);
+    RUN_TEST(PASSED, test_cJSONLogger_lazy_init_failure);
+    RUN_TEST(PASSED, test_cJSONLogger_dump_failure);
+    RUN_TEST(PASSED, test_cJSONLogger_thread_nice_denied);
+    RUN_TEST(PASSED, test_cJSONLogger_chunked_dump);
+    RUN_TEST(PASSED, test_cJSONLogger_dump_partial_writes);
+    RUN_TEST(PASSED, test_cJSONLogger_dump_matches_cjson_tree);
+    RUN_TEST(PASSED, test_cJSONLogger_call_site_interning);
+    RUN_TEST(PASSED, test_cJSONLogger_call_site_reused_buffer);
+    RUN_TEST(PASSED, test_cJSONLogger_arena_growth);
+    RUN_TEST(PASSED, test_cJSONLogger_escape_kernels);
+    RUN_TEST(PASSED, test_cJSONLogger_query_reentrant);
+    RUN_TEST(PASSED, test_cJSONLogger_log_index);
+    RUN_TEST(PASSED, test_cJSONLogger_thread_nice_zero);
+    RUN_TEST(PASSED, test_cJSONLogger_flight_recorder_truncate);
+    RUN_TEST(PASSED, test_cJSONLogger_socket_sink_late_receiver);
+    RUN_TEST(PASSED, test_cJSONLogger_flush_interval_workers);
+    RUN_TEST(PASSED, test_cJSONLogger_init_no_workers);
 
     return 0;
 }
\ No newline at end of file
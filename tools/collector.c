@@ -0,0 +1,454 @@
+/**
+ * @file collector.c
+ *
+ * @brief This file contains the collector consuming the shared memory ring of the cJSON logger library.
+ *
+ * @note The collector writes the records either as the usual JSON tree (written when the collector exits)
+ * or as NDJSON, one JSON object per record appended as soon as it is consumed.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include <cJSON.h>
+#include <cJSONLogger.h>
+#include <cJSONLoggerFormat.h>
+#include <cJSONLoggerShmRing.h>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @def COLLECTOR_POLL_INTERVAL_US
+ *
+ * @brief Time the collector sleeps when the ring is empty.
+ */
+#define COLLECTOR_POLL_INTERVAL_US 1000
+
+/**
+ * @def COLLECTOR_ATTACH_INTERVAL_US
+ *
+ * @brief Time the collector sleeps while waiting for the ring to be created.
+ */
+#define COLLECTOR_ATTACH_INTERVAL_US 100000
+
+/**
+ * @struct CollectorOptions
+ *
+ * @brief Command line options of the collector.
+ *
+ * @var shmName The shared memory object name of the ring.
+ * @var outputPath The output file path.
+ * @var ndjson Whether the records are written as NDJSON instead of a JSON tree.
+ * @var drain Whether the collector exits once the ring is empty.
+ * @var unlink Whether the shared memory object is removed when the collector exits.
+ */
+typedef struct CollectorOptions {
+    const char* shmName;
+    const char* outputPath;
+    int ndjson;
+    int drain;
+    int unlink;
+} CollectorOptions_s;
+
+/**
+ * @brief Set by SIGINT and SIGTERM to stop the collector.
+ */
+static volatile sig_atomic_t s_g_stop = 0;
+
+/**
+ * @brief Signal handler stopping the collector.
+ *
+ * @param sig The received signal.
+ */
+static void collectorStop(int sig)
+{
+    (void)sig;
+    s_g_stop = 1;
+}
+
+/**
+ * @brief Get a monotonic time stamp in milliseconds.
+ *
+ * @return int64_t, the time stamp.
+ */
+static int64_t collectorNowMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Skip the oldest slot of the ring once it stayed reserved without being committed for SHM_RING_COMMIT_TIMEOUT_MS.
+ *
+ * @param header The header of the ring.
+ * @param blockedPos The position of the uncommitted slot seen by the previous calls, updated.
+ * @param blockedSinceMs When the slot was first seen uncommitted, updated, 0 if no slot was.
+ *
+ * @return int, 1 if a slot was skipped, 0 otherwise.
+ */
+static int collectorSkipAbandoned(ShmRingHeader_s* header, uint64_t* blockedPos, int64_t* blockedSinceMs)
+{
+    uint64_t pos = 0;
+    if (shmRingUncommitted(header, &pos) == 0) {
+        *blockedSinceMs = 0;
+        return 0;
+    }
+
+    int64_t nowMs = collectorNowMs();
+    if (*blockedSinceMs == 0 || pos != *blockedPos) {
+        *blockedPos = pos;
+        *blockedSinceMs = nowMs;
+        return 0;
+    }
+
+    if (nowMs - *blockedSinceMs < SHM_RING_COMMIT_TIMEOUT_MS) {
+        return 0;
+    }
+
+    *blockedSinceMs = 0;
+    return shmRingSkip(header, pos);
+}
+
+/**
+ * @brief Get the string representation of a log level, same as the library.
+ *
+ * @param logLevel The log level to convert.
+ *
+ * @return The string representation of the log level.
+ */
+static const char* collectorLogLevelStr(int32_t logLevel)
+{
+    switch (logLevel) {
+    case CJSON_LOG_LEVEL_CRITICAL:
+        return "CRITICAL";
+    case CJSON_LOG_LEVEL_ERROR:
+        return "ERROR";
+    case CJSON_LOG_LEVEL_WARN:
+        return "WARN";
+    case CJSON_LOG_LEVEL_INFO:
+        return "INFO";
+    case CJSON_LOG_LEVEL_DEBUG:
+        return "DEBUG";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Convert a record of the ring into a JSON log object, same fields as the library.
+ *
+ * @note The time stamp is printed by the library formatter, in the format set from the ring header.
+ *
+ * @param slot The slot holding the record.
+ *
+ * @return cJSON* ptr of the log object, NULL in case of failure.
+ */
+static cJSON* collectorRecordToJson(const ShmRingSlot_s* slot)
+{
+    cJSON* logObj = cJSON_CreateObject();
+    if (logObj == NULL) {
+        return NULL;
+    }
+
+    char timeStr[MAX_TIME_STR_LEN] = { 0 };
+    formatTimeStamp(slot->timeStamp, timeStr, sizeof(timeStr));
+
+    cJSON_AddItemToObject(logObj, "Time", cJSON_CreateString(timeStr));
+    cJSON_AddItemToObject(logObj, "LogLevel", cJSON_CreateString(collectorLogLevelStr(slot->logLevel)));
+
+    if (slot->recordSequence != 0) {
+        cJSON_AddItemToObject(logObj, "Sequence", cJSON_CreateNumber((double)slot->recordSequence));
+    }
+
+    if (slot->threadId != 0) {
+        cJSON_AddItemToObject(logObj, "ThreadId", cJSON_CreateNumber(slot->threadId));
+    }
+
+    if (shmRingSlotFileName(slot) != NULL) {
+        cJSON_AddItemToObject(logObj, "FileName", cJSON_CreateString(shmRingSlotFileName(slot)));
+    }
+
+    if (shmRingSlotFuncName(slot) != NULL) {
+        cJSON_AddItemToObject(logObj, "FuncName", cJSON_CreateString(shmRingSlotFuncName(slot)));
+    }
+
+    if (slot->fileLine != 0) {
+        cJSON_AddItemToObject(logObj, "FileLine", cJSON_CreateNumber(slot->fileLine));
+    }
+
+    cJSON_AddItemToObject(logObj, "Log", cJSON_CreateString(shmRingSlotLogMsg(slot)));
+
+    return logObj;
+}
+
+/**
+ * @brief Add a record of the ring to the JSON log tree.
+ *
+ * @param root The root of the log tree.
+ * @param slot The slot holding the record.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int collectorAddToTree(cJSON* root, const ShmRingSlot_s* slot)
+{
+    cJSON* node = root;
+    const char* nodeName = slot->data;
+    for (uint16_t i = 0; i < slot->pathDepth; i++) {
+        cJSON* child = cJSON_GetObjectItem(node, nodeName);
+        if (child == NULL) {
+            child = cJSON_CreateObject();
+            if (child == NULL) {
+                return -1;
+            }
+            cJSON_AddItemToObject(node, nodeName, child);
+        }
+
+        node = child;
+        nodeName += strlen(nodeName) + 1;
+    }
+
+    cJSON* logs = cJSON_GetObjectItem(node, "logs");
+    if (logs == NULL) {
+        logs = cJSON_CreateArray();
+        if (logs == NULL) {
+            return -1;
+        }
+        cJSON_AddItemToObject(node, "logs", logs);
+    }
+
+    cJSON* logObj = collectorRecordToJson(slot);
+    if (logObj == NULL) {
+        return -1;
+    }
+
+    cJSON_AddItemToArray(logs, logObj);
+
+    return 0;
+}
+
+/**
+ * @brief Append a record of the ring to the NDJSON output.
+ *
+ * @param output The output file.
+ * @param slot The slot holding the record.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int collectorAppendNdjson(FILE* output, const ShmRingSlot_s* slot)
+{
+    cJSON* logObj = collectorRecordToJson(slot);
+    if (logObj == NULL) {
+        return -1;
+    }
+
+    cJSON* path = cJSON_CreateArray();
+    const char* nodeName = slot->data;
+    for (uint16_t i = 0; i < slot->pathDepth; i++) {
+        cJSON_AddItemToArray(path, cJSON_CreateString(nodeName));
+        nodeName += strlen(nodeName) + 1;
+    }
+    cJSON_AddItemToObject(logObj, "Path", path);
+
+    char* line = cJSON_PrintUnformatted(logObj);
+    cJSON_Delete(logObj);
+    if (line == NULL) {
+        return -1;
+    }
+
+    fprintf(output, "%s\n", line);
+    cJSON_free(line);
+
+    return 0;
+}
+
+/**
+ * @brief Map the ring, waiting for the logger to create it.
+ *
+ * @param shmName The shared memory object name of the ring.
+ * @param size Where the size of the mapping will be stored.
+ *
+ * @return ShmRingHeader_s* ptr of the mapped ring, NULL if the collector was stopped first.
+ */
+static ShmRingHeader_s* collectorAttach(const char* shmName, size_t* size)
+{
+    while (s_g_stop == 0) {
+        int fd = shm_open(shmName, O_RDWR, 0);
+        struct stat st;
+        if (fd != -1 && fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ShmRingHeader_s)) {
+            ShmRingHeader_s* header = (ShmRingHeader_s*)mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+
+            if (header != MAP_FAILED && shmRingIsValid(header, (size_t)st.st_size)) {
+                *size = (size_t)st.st_size;
+                return header;
+            }
+
+            if (header != MAP_FAILED) {
+                munmap(header, (size_t)st.st_size);
+            }
+        }
+
+        else if (fd != -1) {
+            close(fd);
+        }
+
+        usleep(COLLECTOR_ATTACH_INTERVAL_US);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Parse the command line options.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param options Where the options will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int collectorParseOptions(int argc, char** argv, CollectorOptions_s* options)
+{
+    memset(options, 0, sizeof(CollectorOptions_s));
+
+    int opt;
+    while ((opt = getopt(argc, argv, "ndu")) != -1) {
+        switch (opt) {
+        case 'n':
+            options->ndjson = 1;
+            break;
+        case 'd':
+            options->drain = 1;
+            break;
+        case 'u':
+            options->unlink = 1;
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (argc - optind != 2) {
+        return -1;
+    }
+
+    options->shmName = argv[optind];
+    options->outputPath = argv[optind + 1];
+
+    return 0;
+}
+
+/**
+ * @brief Main entry point for the collector.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int main(int argc, char** argv)
+{
+    CollectorOptions_s options;
+    if (collectorParseOptions(argc, argv, &options) != 0) {
+        fprintf(stderr, "Usage: %s [-n] [-d] [-u] <shm name> <output file>\n", argv[0]);
+        fprintf(stderr, "  -n  write NDJSON (one record per line) instead of the JSON tree\n");
+        fprintf(stderr, "  -d  exit once the ring is empty\n");
+        fprintf(stderr, "  -u  remove the shared memory object on exit\n");
+        return -1;
+    }
+
+    signal(SIGINT, collectorStop);
+    signal(SIGTERM, collectorStop);
+
+    size_t size = 0;
+    ShmRingHeader_s* header = collectorAttach(options.shmName, &size);
+    if (header == NULL) {
+        return -1;
+    }
+
+    FILE* output = fopen(options.outputPath, options.ndjson ? "a" : "w");
+    if (output == NULL) {
+        munmap(header, size);
+        return -1;
+    }
+
+    cJSON* root = options.ndjson ? NULL : cJSON_CreateObject();
+
+    // A producer that died between reserving a slot and committing its record would block the ring for good.
+    uint64_t skipped = 0;
+    uint64_t blockedPos = 0;
+    int64_t blockedSinceMs = 0;
+
+    for (;;) {
+        uint64_t pos = 0;
+        ShmRingSlot_s* slot = shmRingTake(header, &pos);
+        if (slot == NULL) {
+            if (collectorSkipAbandoned(header, &blockedPos, &blockedSinceMs) != 0) {
+                skipped++;
+                continue;
+            }
+
+            // A drain waits for the uncommitted slot to be committed or skipped, the records behind it are still to be read.
+            if (s_g_stop != 0 || (options.drain != 0 && blockedSinceMs == 0)) {
+                break;
+            }
+
+            fflush(output);
+
+            usleep(COLLECTOR_POLL_INTERVAL_US);
+            continue;
+        }
+
+        // The logger publishes its time format in the header, a restarted logger may change it.
+        formatSetTimeFormat((CJSON_LOGGER_TIME_FORMAT_E)atomic_load_explicit(&header->timeFormat, memory_order_relaxed));
+
+        if (options.ndjson) {
+            collectorAppendNdjson(output, slot);
+        }
+
+        else {
+            collectorAddToTree(root, slot);
+        }
+
+        shmRingRelease(header, slot, pos);
+    }
+
+    if (root != NULL) {
+        char* logsStr = cJSON_Print(root);
+        if (logsStr != NULL) {
+            fprintf(output, "%s", logsStr);
+            cJSON_free(logsStr);
+        }
+        cJSON_Delete(root);
+    }
+
+    fclose(output);
+
+    uint64_t dropped = atomic_load_explicit(&header->dropped, memory_order_relaxed);
+    if (dropped != 0) {
+        fprintf(stderr, "%llu records were dropped by the producers\n", (unsigned long long)dropped);
+    }
+
+    if (skipped != 0) {
+        fprintf(stderr, "%llu slots left uncommitted by the producers were skipped\n", (unsigned long long)skipped);
+    }
+
+    munmap(header, size);
+
+    if (options.unlink) {
+        shm_unlink(options.shmName);
+    }
+
+    return 0;
+}
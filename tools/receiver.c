@@ -0,0 +1,238 @@
+/**
+ * @file receiver.c
+ *
+ * @brief This file contains the receiver of the socket sink of the cJSON logger library.
+ *
+ * @note The receiver listens on a Unix domain SOCK_SEQPACKET socket and appends the NDJSON records of every packet
+ * to the output, it stands in for a log shipping agent in tests.
+ *
+ * @author Stefanos Tononidis
+ *
+ * @date 2026-10-17
+ */
+
+#include <cJSONLoggerSocketSink.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @def MAX_RECEIVER_CLIENTS
+ *
+ * @brief Max number of logger processes connected to the receiver at the same time.
+ */
+#define MAX_RECEIVER_CLIENTS 64
+
+/**
+ * @def RECEIVER_POLL_TIMEOUT_MS
+ *
+ * @brief Time the receiver waits for packets before checking whether it was stopped.
+ */
+#define RECEIVER_POLL_TIMEOUT_MS 100
+
+/**
+ * @struct ReceiverOptions
+ *
+ * @brief Command line options of the receiver.
+ *
+ * @var socketPath The path of the Unix domain socket to listen on.
+ * @var outputPath The output file path, NULL for the standard output.
+ * @var count The number of records after which the receiver exits, 0 to run until stopped.
+ */
+typedef struct ReceiverOptions {
+    const char* socketPath;
+    const char* outputPath;
+    unsigned long count;
+} ReceiverOptions_s;
+
+/**
+ * @brief Set by SIGINT and SIGTERM to stop the receiver.
+ */
+static volatile sig_atomic_t s_g_stop = 0;
+
+/**
+ * @brief Signal handler stopping the receiver.
+ *
+ * @param sig The received signal.
+ */
+static void receiverStop(int sig)
+{
+    (void)sig;
+    s_g_stop = 1;
+}
+
+/**
+ * @brief Parse the command line options.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @param options Where the options will be stored.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+static int receiverParseOptions(int argc, char** argv, ReceiverOptions_s* options)
+{
+    memset(options, 0, sizeof(ReceiverOptions_s));
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:")) != -1) {
+        switch (opt) {
+        case 'c':
+            options->count = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (argc - optind != 1 && argc - optind != 2) {
+        return -1;
+    }
+
+    options->socketPath = argv[optind];
+    options->outputPath = argc - optind == 2 ? argv[optind + 1] : NULL;
+
+    return 0;
+}
+
+/**
+ * @brief Create the listening socket of the receiver, a stale socket file is replaced.
+ *
+ * @param socketPath The path of the Unix domain socket.
+ *
+ * @return int, the listening socket, negative value in case of failure.
+ */
+static int receiverListen(const char* socketPath)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return -1;
+    }
+
+    unlink(socketPath);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, MAX_RECEIVER_CLIENTS) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Main entry point for the receiver.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ *
+ * @return int, 0 in case of success, negative value in case of failure.
+ */
+int main(int argc, char** argv)
+{
+    ReceiverOptions_s options;
+    if (receiverParseOptions(argc, argv, &options) != 0) {
+        fprintf(stderr, "Usage: %s [-c count] <socket path> [output file]\n", argv[0]);
+        fprintf(stderr, "  -c  exit after receiving count records\n");
+        return -1;
+    }
+
+    signal(SIGINT, receiverStop);
+    signal(SIGTERM, receiverStop);
+
+    FILE* output = options.outputPath != NULL ? fopen(options.outputPath, "a") : stdout;
+    if (output == NULL) {
+        return -1;
+    }
+
+    int listenFd = receiverListen(options.socketPath);
+    if (listenFd < 0) {
+        if (output != stdout) {
+            fclose(output);
+        }
+        return -1;
+    }
+
+    // Entry 0 is the listening socket, the rest are the connected loggers.
+    struct pollfd pfds[MAX_RECEIVER_CLIENTS + 1];
+    nfds_t pfdCount = 1;
+    pfds[0].fd = listenFd;
+    pfds[0].events = POLLIN;
+
+    char* packet = (char*)malloc(SOCKET_SINK_MAX_PACKET_LEN);
+    unsigned long records = 0;
+
+    while (s_g_stop == 0 && packet != NULL && (options.count == 0 || records < options.count)) {
+        int res = poll(pfds, pfdCount, RECEIVER_POLL_TIMEOUT_MS);
+        if (res <= 0) {
+            continue;
+        }
+
+        if ((pfds[0].revents & POLLIN) != 0) {
+            int clientFd = accept(listenFd, NULL, NULL);
+            if (clientFd != -1 && pfdCount <= MAX_RECEIVER_CLIENTS) {
+                pfds[pfdCount].fd = clientFd;
+                pfds[pfdCount].events = POLLIN;
+                pfds[pfdCount].revents = 0;
+                pfdCount++;
+            }
+
+            else if (clientFd != -1) {
+                close(clientFd);
+            }
+        }
+
+        for (nfds_t i = 1; i < pfdCount; i++) {
+            if (pfds[i].revents == 0) {
+                continue;
+            }
+
+            ssize_t len = recv(pfds[i].fd, packet, SOCKET_SINK_MAX_PACKET_LEN, 0);
+            if (len > 0) {
+                fwrite(packet, 1, (size_t)len, output);
+                for (ssize_t j = 0; j < len; j++) {
+                    records += packet[j] == '\n';
+                }
+                continue;
+            }
+
+            if (len < 0 && errno == EINTR) {
+                continue;
+            }
+
+            // The logger closed the connection, its slot is reused by the last one.
+            close(pfds[i].fd);
+            pfds[i] = pfds[pfdCount - 1];
+            pfdCount--;
+            i--;
+        }
+
+        fflush(output);
+    }
+
+    free(packet);
+
+    for (nfds_t i = 0; i < pfdCount; i++) {
+        close(pfds[i].fd);
+    }
+    unlink(options.socketPath);
+
+    if (output != stdout) {
+        fclose(output);
+    }
+
+    return 0;
+}